@@ -0,0 +1,317 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_BENCH_HPP
+#define MMATH_MMATH_BENCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mmath_bench {
+
+    // First command line argument as a size (megabytes or a count), falling back
+    // to the default when absent.
+    inline size_t size_argument(int argc, char** argv, size_t fallback) {
+        if (argc > 1) {
+            char* end = nullptr;
+            unsigned long long value = std::strtoull(argv[1], &end, 10);
+            if (end != argv[1] && value > 0)
+                return static_cast<size_t>(value);
+        }
+        return fallback;
+    }
+
+    /*
+     * HARDWARE COUNTERS
+     *
+     * On Linux each measured run is bracketed by perf_event_open counters of
+     * this process in user space, its thread pool included: the counters are
+     * opened before main and inherited by every thread started afterwards, so
+     * threads a benchmark starts itself are counted as well. Threads started
+     * before main are not. Counters the kernel, the CPU or a container
+     * refuses are reported as "-" and the rest still work; the header lists
+     * what is missing and why. Environment variables:
+     *
+     *   MMATH_BENCH_COUNTERS=0        disable the counters
+     *   MMATH_BENCH_VECTOR_EVENT=0x.. raw event code counting vector
+     *                                 instructions, which is CPU specific, e.g.
+     *                                 0x10c7 for 256 bit packed double FP_ARITH
+     *                                 on recent Intel cores
+     *   MMATH_BENCH_PEAK_GBS          peak memory bandwidth, otherwise measured
+     *                                 once with a large memcpy
+     *   MMATH_BENCH_PEAK_GFLOPS       peak arithmetic rate, needed for % of peak
+     */
+
+    enum counter : size_t {
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        vector_instructions,
+        page_faults,
+        counter_count,
+    };
+
+    constexpr std::array<const char*, counter_count> counter_names = {
+        "cycles", "instructions", "L1d misses", "LLC misses", "branch misses", "vector instructions", "page faults",
+    };
+
+    struct counter_values {
+        std::array<double, counter_count> value{};
+        std::array<bool, counter_count> valid{};
+    };
+
+    class perf_counters {
+      private:
+        std::array<int, counter_count> fds;
+        std::array<std::string, counter_count> failures;
+
+#if defined(__linux__)
+        static int open(uint32_t type, uint64_t config) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+
+        perf_counters() {
+            fds.fill(-1);
+            const char* enabled = std::getenv("MMATH_BENCH_COUNTERS");
+            if (enabled && std::string{enabled} == "0") {
+                failures.fill("disabled");
+                return;
+            }
+#if defined(__linux__)
+            const std::array<std::pair<uint32_t, uint64_t>, counter_count> events = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {PERF_TYPE_RAW, 0},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            }};
+            for (size_t c = 0; c < counter_count; ++c) {
+                auto [type, config] = events[c];
+                if (c == vector_instructions) {
+                    const char* code = std::getenv("MMATH_BENCH_VECTOR_EVENT");
+                    if (!code) {
+                        failures[c] = "MMATH_BENCH_VECTOR_EVENT not set";
+                        continue;
+                    }
+                    config = std::strtoull(code, nullptr, 0);
+                }
+                fds[c] = open(type, config);
+                if (fds[c] < 0)
+                    failures[c] = std::strerror(errno);
+            }
+#else
+            failures.fill("needs Linux perf_event_open");
+#endif
+        }
+
+      public:
+        perf_counters(const perf_counters&) = delete;
+        perf_counters& operator=(const perf_counters&) = delete;
+
+        ~perf_counters() {
+#if defined(__linux__)
+            for (int fd : fds) {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+#endif
+        }
+
+        static perf_counters& instance() {
+            static perf_counters counters;
+            return counters;
+        }
+
+        [[nodiscard]] bool available(counter c) const { return fds[c] >= 0; }
+
+        [[nodiscard]] const std::string& failure(counter c) const { return failures[c]; }
+
+        void start() {
+#if defined(__linux__)
+            for (int fd : fds) {
+                if (fd >= 0) {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // Counts since start(), scaled up when the kernel multiplexed a counter
+        // and only had it running for part of the time.
+        counter_values stop() {
+            counter_values result;
+#if defined(__linux__)
+            for (int fd : fds) {
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+            for (size_t c = 0; c < counter_count; ++c) {
+                uint64_t data[3] = {};
+                if (fds[c] < 0 || ::read(fds[c], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+                    continue;
+                result.value[c] = static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                  static_cast<double>(data[2]);
+                result.valid[c] = true;
+            }
+#endif
+            return result;
+        }
+    };
+
+    // Counters are inherited only by threads created after they are opened, so
+    // open them during static initialization, before anything starts the pool.
+    inline perf_counters& opened_at_startup = perf_counters::instance();
+
+    // Wall time of a run and the counters read over it.
+    struct measurement {
+        double seconds = 0;
+        counter_values counters;
+    };
+
+    namespace detail {
+        inline double environment(const char* name) {
+            const char* value = std::getenv(name);
+            return value ? std::strtod(value, nullptr) : 0.0;
+        }
+
+        // Bytes read and written per second by a memcpy much larger than the
+        // caches.
+        inline double measure_peak_bandwidth() {
+            const size_t size = size_t{1} << 27;
+            std::vector<char> from(size, 1), to(size, 0);
+            double best = std::numeric_limits<double>::max();
+            for (int i = 0; i < 3; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                std::memcpy(to.data(), from.data(), size);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                best = std::min(best, elapsed.count());
+                from[static_cast<size_t>(i)] = to[size - 1];
+            }
+            return 2.0 * static_cast<double>(size) / best / 1e9;
+        }
+
+        inline double& peak_bandwidth() {
+            static double peak = 0;
+            return peak;
+        }
+    }  // namespace detail
+
+    // The run with the best wall time over the given number of repetitions.
+    template <typename F>
+    measurement best_of(int repetitions, F&& run) {
+        perf_counters& counters = perf_counters::instance();
+        measurement best{std::numeric_limits<double>::max(), {}};
+        for (int i = 0; i < repetitions; ++i) {
+            counters.start();
+            auto start = std::chrono::steady_clock::now();
+            run();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            counter_values values = counters.stop();
+            if (elapsed.count() < best.seconds)
+                best = {elapsed.count(), values};
+        }
+        return best;
+    }
+
+    inline void header() {
+        perf_counters& counters = perf_counters::instance();
+        double& peak = detail::peak_bandwidth();
+        peak = detail::environment("MMATH_BENCH_PEAK_GBS");
+        if (peak <= 0)
+            peak = detail::measure_peak_bandwidth();
+        std::printf("peak bandwidth %.1f GB/s", peak);
+        if (double flops = detail::environment("MMATH_BENCH_PEAK_GFLOPS"); flops > 0)
+            std::printf(", peak %.1f GFLOP/s", flops);
+        std::printf("\n");
+
+        std::string missing;
+        for (size_t c = 0; c < counter_count; ++c) {
+            if (!counters.available(static_cast<counter>(c)))
+                missing += std::string{missing.empty() ? "" : ", "} + counter_names[c] + " (" +
+                           counters.failure(static_cast<counter>(c)) + ")";
+        }
+        if (!missing.empty())
+            std::printf("counters unavailable: %s\n", missing.c_str());
+
+        std::printf("%-40s %14s %12s %6s %9s %6s %6s %7s %7s %7s %7s %9s\n", "benchmark", "time (ms)", "GB/s", "%BW",
+                    "GFLOP/s", "%FLOP", "IPC", "L1d/ki", "LLC/ki", "br/ki", "vec/ki", "faults");
+    }
+
+    // One line per benchmark. flops is the arithmetic performed, zero when it
+    // is not meaningful. Misses, branch misses and vector instructions are per
+    // thousand instructions.
+    inline void report(const std::string& name, const measurement& run, size_t bytes, double flops = 0) {
+        const double seconds = run.seconds;
+        double rate = seconds > 0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0;
+        std::printf("%-40s %14.3f %12.3f", name.c_str(), seconds * 1e3, rate);
+
+        auto column = [](int width, int precision, bool valid, double value) {
+            if (valid)
+                std::printf(" %*.*f", width, precision, value);
+            else
+                std::printf(" %*s", width, "-");
+        };
+
+        const double peak = detail::peak_bandwidth();
+        const double peak_flops = detail::environment("MMATH_BENCH_PEAK_GFLOPS");
+        const double gflops = seconds > 0 ? flops / seconds / 1e9 : 0.0;
+        column(6, 1, peak > 0 && bytes > 0, 100.0 * rate / peak);
+        column(9, 2, flops > 0, gflops);
+        column(6, 1, flops > 0 && peak_flops > 0, 100.0 * gflops / peak_flops);
+
+        const auto& v = run.counters.value;
+        const auto& ok = run.counters.valid;
+        const bool per_instruction = ok[instructions] && v[instructions] > 0;
+        const double kilo = per_instruction ? v[instructions] / 1e3 : 1.0;
+        column(6, 2, per_instruction && ok[cycles] && v[cycles] > 0, v[instructions] / v[cycles]);
+        column(7, 2, per_instruction && ok[l1d_misses], v[l1d_misses] / kilo);
+        column(7, 2, per_instruction && ok[llc_misses], v[llc_misses] / kilo);
+        column(7, 2, per_instruction && ok[branch_misses], v[branch_misses] / kilo);
+        column(7, 1, per_instruction && ok[vector_instructions], v[vector_instructions] / kilo);
+        column(9, 0, ok[page_faults], v[page_faults]);
+        std::printf("\n");
+    }
+
+    // Keeps the optimizer from discarding a result that is otherwise unused.
+    template <typename T>
+    inline void keep(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+}  // namespace mmath_bench
+
+#endif  // MMATH_MMATH_BENCH_HPP
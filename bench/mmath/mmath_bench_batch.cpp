@@ -0,0 +1,67 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// matrix_batch kernels against a loop over individual matrix_base objects.
+// Usage: mmath_bench_batch [thousands of matrices], default 1000.
+
+#include <random>
+
+#include "../../src/mmath/mmath_batch.hpp"
+#include "mmath_bench.hpp"
+
+template <size_t N>
+void run(size_t count) {
+    std::mt19937_64 engine{5};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+
+    mmath::matrix_batch<double, N, N> a{count}, b{count};
+    std::vector<mmath::matrix_base<double>> as, bs;
+    as.reserve(count);
+    bs.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        mmath::matrix_base<double> x{N, N}, y{N, N};
+        for (size_t e = 0; e < N * N; ++e) {
+            x.raw_data()[e] = dist(engine) + (e % (N + 1) == 0 ? 4.0 : 0.0);
+            y.raw_data()[e] = dist(engine);
+        }
+        a.set(k, x);
+        b.set(k, y);
+        as.push_back(std::move(x));
+        bs.push_back(std::move(y));
+    }
+
+    size_t bytes = 3 * count * N * N * sizeof(double);
+    std::string shape = std::to_string(N) + "x" + std::to_string(N);
+
+    mmath_bench::report(shape + " multiply (matrix_base)", mmath_bench::best_of(3, [&] {
+                            for (size_t k = 0; k < count; ++k) {
+                                auto c = as[k] * bs[k];
+                                mmath_bench::keep(c.raw_data()[0]);
+                            }
+                        }),
+                        bytes);
+    mmath_bench::report(shape + " multiply (matrix_batch)", mmath_bench::best_of(3, [&] {
+                            auto c = a * b;
+                            mmath_bench::keep(c.plane(1, 1)[0]);
+                        }),
+                        bytes);
+    mmath_bench::report(shape + " inverse (matrix_batch)", mmath_bench::best_of(3, [&] {
+                            auto c = mmath::inverse(a);
+                            mmath_bench::keep(c.plane(1, 1)[0]);
+                        }),
+                        2 * count * N * N * sizeof(double));
+    mmath_bench::report(shape + " trace (matrix_batch)", mmath_bench::best_of(3, [&] {
+                            auto t = mmath::trace(a);
+                            mmath_bench::keep(t[0]);
+                        }),
+                        count * N * sizeof(double));
+}
+
+int main(int argc, char** argv) {
+    size_t count = mmath_bench::size_argument(argc, argv, 1000) * 1000;
+    std::printf("%zu matrices per batch\n", count);
+    mmath_bench::header();
+    run<3>(count);
+    run<4>(count);
+    return 0;
+}
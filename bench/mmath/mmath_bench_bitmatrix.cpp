@@ -0,0 +1,59 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Boolean products, transitive closure and GF(2) rank on bit_matrix against
+// the same operations on a matrix_base<uint8_t> adjacency matrix. Usage:
+// mmath_bench_bitmatrix [n], default 2048.
+
+#include <random>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_bitmatrix.hpp"
+#include "../../src/mmath/mmath_semiring.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 2048);
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<size_t> vertex{1, n};
+    std::bernoulli_distribution coin{0.5};
+
+    // A sparse graph of two out edges per vertex and a dense random matrix
+    mmath::matrix_base<uint8_t> graph{n, n}, dense{n, n};
+    for (size_t i = 1; i <= n; ++i) {
+        graph(i, vertex(engine)) = 1;
+        graph(i, vertex(engine)) = 1;
+        for (size_t j = 1; j <= n; ++j)
+            dense(i, j) = coin(engine);
+    }
+    mmath::bit_matrix graph_bits{graph}, dense_bits{dense};
+
+    std::printf("%zu x %zu\n", n, n);
+    mmath_bench::header();
+    const size_t bytes = n * n;
+
+    mmath::bit_matrix product;
+    mmath_bench::report("bit_matrix * (dense)", mmath_bench::best_of(3, [&] { product = dense_bits * dense_bits; }),
+                        bytes / 8);
+    mmath::matrix_base<uint8_t> product_bytes;
+    mmath_bench::report("or-and semiring uint8 (dense)", mmath_bench::best_of(1, [&] {
+                            product_bytes = mmath::semiring_multiply<mmath::or_and>(dense, dense);
+                        }),
+                        bytes);
+    std::printf("  results %s\n", product.to_matrix<uint8_t>() == product_bytes ? "match" : "DIFFER");
+
+    mmath::bit_matrix reach;
+    mmath_bench::report("bit_matrix transitive_closure",
+                        mmath_bench::best_of(3, [&] { reach = mmath::transitive_closure(graph_bits); }), bytes / 8);
+    mmath::matrix_base<uint8_t> reach_bytes;
+    mmath_bench::report("uint8 transitive_closure",
+                        mmath_bench::best_of(1, [&] { reach_bytes = mmath::transitive_closure(graph); }), bytes);
+    std::printf("  results %s, %zu reachable pairs\n", reach.to_matrix<uint8_t>() == reach_bytes ? "match" : "DIFFER",
+                reach.count());
+
+    mmath_bench::report("bit_matrix transpose",
+                        mmath_bench::best_of(3, [&] { mmath_bench::keep(dense_bits.transpose().count()); }), bytes / 8);
+    mmath_bench::report("gf2_rank", mmath_bench::best_of(3, [&] { mmath_bench::keep(mmath::gf2_rank(dense_bits)); }),
+                        bytes / 8);
+    return 0;
+}
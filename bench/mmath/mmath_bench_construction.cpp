@@ -0,0 +1,97 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Ways of building a large matrix whose elements are all written by the
+// caller. Every run allocates fresh memory, so the zero fill also pays for
+// first touching the pages. Usage: mmath_bench_construction [n], default 4096.
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_span.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    using namespace mmath;
+
+    size_t n = mmath_bench::size_argument(argc, argv, 4096);
+    const size_t bytes = n * n * sizeof(double);
+    auto value = [n](size_t i, size_t j) { return static_cast<double>(i * n + j); };
+
+    std::printf("%zu x %zu doubles\n", n, n);
+    mmath_bench::header();
+
+    mmath_bench::report("zero filled, then written", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix{n, n};
+                            double* out = matrix.raw_data();
+                            for (size_t i = 0; i < n; ++i)
+                                for (size_t j = 0; j < n; ++j)
+                                    out[i * n + j] = value(i + 1, j + 1);
+                            mmath_bench::keep(out[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("for_overwrite, then written", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix{n, n, for_overwrite};
+                            double* out = matrix.raw_data();
+                            for (size_t i = 0; i < n; ++i)
+                                for (size_t j = 0; j < n; ++j)
+                                    out[i * n + j] = value(i + 1, j + 1);
+                            mmath_bench::keep(out[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("generator", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix{n, n, value};
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    std::vector<double> source(n * n);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = static_cast<double>(i);
+
+    mmath_bench::report("vector copied element wise", mmath_bench::best_of(3, [&] {
+                            std::vector<double> values = source;
+                            matrix_base<double> matrix{n, n};
+                            for (size_t i = 1; i <= n; ++i)
+                                for (size_t j = 1; j <= n; ++j)
+                                    matrix(i, j) = values[(i - 1) * n + (j - 1)];
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("vector adopted", mmath_bench::best_of(3, [&] {
+                            std::vector<double> values = source;
+                            matrix_base<double> matrix{n, n, std::move(values)};
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("external buffer copied", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix = to_matrix(matrix_span<double>{source.data(), n, n});
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("external buffer borrowed", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix = borrow_matrix(matrix_span<double>{source.data(), n, n});
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("column major buffer copied", mmath_bench::best_of(3, [&] {
+                            auto matrix = to_matrix(matrix_span<double, layout_left>{source.data(), n, n});
+                            mmath_bench::keep(matrix.raw_data()[n * n - 1]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("transpose", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> matrix{n, n, std::vector<double>(source)};
+                            mmath_bench::keep(transpose(matrix).raw_data()[n * n - 1]);
+                        }),
+                        2 * bytes);
+    return 0;
+}
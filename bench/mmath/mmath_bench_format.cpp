@@ -0,0 +1,55 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Printing throughput of operator<< and write_csv against the old element by
+// element loop with std::endl. Usage: mmath_bench_format [megabytes], default 16.
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "../../src/mmath/mmath_textio.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t megabytes = mmath_bench::size_argument(argc, argv, 16);
+    auto n = static_cast<size_t>(std::sqrt(static_cast<double>(megabytes) * 1024 * 1024 / sizeof(double)));
+    size_t bytes = n * n * sizeof(double);
+
+    mmath::matrix_base<double> matrix{n, n};
+    std::mt19937_64 engine{3};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    for (size_t i = 0; i < n * n; ++i)
+        matrix.raw_data()[i] = dist(engine);
+
+    std::string path = (std::filesystem::temp_directory_path() / "mmath_bench_format.txt").string();
+    std::printf("%zu x %zu doubles\n", n, n);
+    mmath_bench::header();
+
+    mmath_bench::report("element loop with std::endl", mmath_bench::best_of(1, [&] {
+                            std::ofstream out{path};
+                            for (size_t i = 1; i <= n; i++) {
+                                for (size_t j = 1; j <= n; j++) {
+                                    out << matrix(i, j);
+                                    if (j != n)
+                                        out << " ";
+                                }
+                                if (i != n)
+                                    out << std::endl;
+                            }
+                        }),
+                        bytes);
+
+    mmath_bench::report("operator<<", mmath_bench::best_of(3, [&] {
+                            std::ofstream out{path};
+                            out << matrix;
+                        }),
+                        bytes);
+
+    mmath_bench::report("write_csv (parallel, round trip)",
+                        mmath_bench::best_of(3, [&] { mmath::write_csv(path, matrix); }), bytes);
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,91 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Compares loading a matrix from the binary format against parsing the text
+// produced by operator<<. Usage: mmath_bench_io [megabytes], default 64; pass
+// 1024 for the 1 GB case.
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_binary.hpp"
+#include "mmath_bench.hpp"
+
+namespace {
+    mmath::matrix_base<double> read_text(const std::string& path, size_t rows, size_t cols) {
+        std::ifstream in{path};
+        mmath::matrix_base<double> result{rows, cols};
+        double* data = result.raw_data();
+        for (size_t i = 0; i < rows * cols; ++i)
+            in >> data[i];
+        return result;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t megabytes = mmath_bench::size_argument(argc, argv, 64);
+    auto n = static_cast<size_t>(std::sqrt(static_cast<double>(megabytes) * 1024 * 1024 / sizeof(double)));
+    size_t bytes = n * n * sizeof(double);
+
+    mmath::matrix_base<double> matrix{n, n};
+    std::mt19937_64 engine{42};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    double* data = matrix.raw_data();
+    for (size_t i = 0; i < n * n; ++i)
+        data[i] = dist(engine);
+
+    auto dir = std::filesystem::temp_directory_path();
+    std::string text_path = (dir / "mmath_bench_io.txt").string();
+    std::string binary_path = (dir / "mmath_bench_io.bin").string();
+
+    {
+        std::ofstream text{text_path};
+        text.precision(17);
+        for (size_t i = 0; i < n * n; ++i)
+            text << data[i] << ((i + 1) % n == 0 ? '\n' : ' ');
+    }
+
+    std::printf("%zu x %zu doubles (%.1f MB)\n", n, n, static_cast<double>(bytes) / (1024 * 1024));
+    mmath_bench::header();
+
+    mmath_bench::report("write binary (stream)", mmath_bench::best_of(3, [&] {
+                            std::ofstream out{binary_path, std::ios::binary};
+                            mmath::write_binary(out, matrix);
+                        }),
+                        bytes);
+
+    mmath_bench::report("write binary (mmap)",
+                        mmath_bench::best_of(3, [&] { mmath::write_binary_mapped(binary_path, matrix); }), bytes);
+
+    mmath_bench::report("load text (operator>>)", mmath_bench::best_of(1, [&] {
+                            auto loaded = read_text(text_path, n, n);
+                            mmath_bench::keep(loaded.raw_data()[0]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("load binary (stream, checksum)", mmath_bench::best_of(3, [&] {
+                            std::ifstream in{binary_path, std::ios::binary};
+                            auto loaded = mmath::read_binary<double>(in);
+                            mmath_bench::keep(loaded.raw_data()[0]);
+                        }),
+                        bytes);
+
+    mmath_bench::report("load binary (mmap, zero copy)", mmath_bench::best_of(3, [&] {
+                            mmath::mapped_matrix<double> view{binary_path};
+                            mmath_bench::keep(view(1, 1));
+                        }),
+                        bytes);
+
+    mmath_bench::report("load binary (mmap, checksum)", mmath_bench::best_of(3, [&] {
+                            mmath::mapped_matrix<double> view{binary_path, true};
+                            mmath_bench::keep(view(1, 1));
+                        }),
+                        bytes);
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(binary_path);
+    return 0;
+}
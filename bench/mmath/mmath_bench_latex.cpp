@@ -0,0 +1,81 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// to_latex/from_latex over a batch of small matrices against building each
+// one with std::ostringstream. Usage: mmath_bench_latex [matrices], default 10000.
+
+#include <random>
+#include <sstream>
+
+#include "../../src/mmath/mmath_latex.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t count = mmath_bench::size_argument(argc, argv, 10000);
+    const size_t n = 8;
+
+    std::mt19937_64 engine{11};
+    std::uniform_real_distribution<double> dist{-100.0, 100.0};
+    std::vector<mmath::matrix_base<double>> batch;
+    batch.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        mmath::matrix_base<double> m{n, n};
+        for (size_t i = 0; i < n * n; ++i)
+            m.raw_data()[i] = dist(engine);
+        batch.push_back(std::move(m));
+    }
+
+    size_t bytes = 0;
+    std::string report;
+    mmath_bench::header();
+
+    mmath_bench::measurement naive = mmath_bench::best_of(3, [&] {
+        report.clear();
+        for (const auto& m : batch) {
+            std::ostringstream os;
+            os.precision(17);
+            os << "\\begin{pmatrix}\n";
+            for (size_t i = 1; i <= n; ++i) {
+                for (size_t j = 1; j <= n; ++j) {
+                    os << m(i, j);
+                    if (j != n)
+                        os << " & ";
+                }
+                os << (i == n ? "\n" : " \\\\\n");
+            }
+            os << "\\end{pmatrix}";
+            report += os.str();
+        }
+        bytes = report.size();
+    });
+    mmath_bench::report("to_latex (ostringstream)", naive, bytes);
+
+    mmath::format_buffer buffer;
+    mmath_bench::measurement buffered = mmath_bench::best_of(3, [&] {
+        buffer.clear();
+        for (const auto& m : batch)
+            mmath::to_latex(buffer, m);
+        bytes = buffer.size();
+    });
+    mmath_bench::report("to_latex (format_buffer)", buffered, bytes);
+
+    std::vector<size_t> offsets;
+    {
+        mmath::format_buffer separate;
+        for (const auto& m : batch) {
+            offsets.push_back(separate.size());
+            mmath::to_latex(separate, m);
+        }
+        offsets.push_back(separate.size());
+        report = std::string{separate.view()};
+    }
+
+    mmath_bench::measurement parse = mmath_bench::best_of(3, [&] {
+        for (size_t k = 0; k < count; ++k) {
+            auto m = mmath::from_latex<double>(std::string_view{report}.substr(offsets[k], offsets[k + 1] - offsets[k]));
+            mmath_bench::keep(m.raw_data()[0]);
+        }
+    });
+    mmath_bench::report("from_latex", parse, report.size());
+    return 0;
+}
@@ -0,0 +1,148 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Compares the widening multiply and the mixed precision solve against their
+// single and double precision counterparts, reporting the forward error of
+// each on a well conditioned and an ill conditioned system. Usage:
+// mmath_bench_mixed [n], default 512.
+
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_lu.hpp"
+#include "../../src/mmath/mmath_mixed.hpp"
+#include "mmath_bench.hpp"
+
+namespace {
+    // A = (I - 2 u u^T) D (I - 2 v v^T) for random unit u and v, so the singular
+    // values are exactly the geometrically spaced diagonal of D and the
+    // condition number is the one requested.
+    mmath::matrix_base<double> make_system(size_t n, double condition, std::mt19937_64& engine) {
+        std::normal_distribution<double> dist;
+        auto unit = [&] {
+            std::vector<double> v(n);
+            double norm = 0;
+            for (double& value : v) {
+                value = dist(engine);
+                norm += value * value;
+            }
+            for (double& value : v)
+                value /= std::sqrt(norm);
+            return v;
+        };
+        std::vector<double> u = unit(), v = unit(), d(n);
+        for (size_t i = 0; i < n; ++i)
+            d[i] = std::pow(condition, -static_cast<double>(i) / static_cast<double>(n - 1));
+
+        // (I - 2 u u^T) D (I - 2 v v^T) = D - 2 u (D^T u)^T - 2 (D v) v^T + 4 (u^T D v) u v^T
+        double udv = 0;
+        for (size_t i = 0; i < n; ++i)
+            udv += u[i] * d[i] * v[i];
+        mmath::matrix_base<double> a{n, n};
+        double* data = a.raw_data();
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                data[i * n + j] = (i == j ? d[i] : 0.0) - 2 * u[i] * d[j] * u[j] - 2 * d[i] * v[i] * v[j] +
+                                  4 * udv * u[i] * v[j];
+            }
+        }
+        return a;
+    }
+
+    double forward_error(const std::vector<double>& x, const std::vector<double>& expected) {
+        double error = 0, norm = 0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            error = std::max(error, std::abs(x[i] - expected[i]));
+            norm = std::max(norm, std::abs(expected[i]));
+        }
+        return error / norm;
+    }
+
+    void solve_case(const char* label, const mmath::matrix_base<double>& a) {
+        const size_t n = a.size_row();
+        std::vector<double> expected(n), b(n), x(n);
+        for (size_t i = 0; i < n; ++i)
+            expected[i] = std::sin(static_cast<double>(i) + 1.0);
+        mmath::m_kernel::gemv(n, n, a.raw_data(), n, expected.data(), b.data());
+
+        mmath::matrix_base<float> a_float{n, n};
+        for (size_t i = 0; i < n * n; ++i)
+            a_float.raw_data()[i] = static_cast<float>(a.raw_data()[i]);
+        std::vector<float> b_float(b.begin(), b.end());
+
+        std::vector<double> x_double, x_float(n);
+        mmath_bench::measurement t_double = mmath_bench::best_of(3, [&] { x_double = mmath::lu_solve(a, b); });
+        mmath_bench::measurement t_float = mmath_bench::best_of(3, [&] {
+            auto solution = mmath::lu_solve(a_float, b_float);
+            std::copy(solution.begin(), solution.end(), x_float.begin());
+        });
+        mmath::refinement_result<double> result{};
+        mmath_bench::measurement t_mixed = mmath_bench::best_of(3, [&] {
+            result = mmath::mixed_precision_solve(a, std::span<const double>{b}, std::span<double>{x});
+        });
+
+        size_t bytes = n * n * sizeof(double);
+        double flops = 2.0 / 3.0 * static_cast<double>(n * n * n);
+        std::printf("%s\n", label);
+        mmath_bench::report("  lu_solve<double>", t_double, bytes, flops);
+        mmath_bench::report("  lu_solve<float>", t_float, bytes / 2, flops);
+        mmath_bench::report("  mixed_precision_solve", t_mixed, bytes, flops);
+        std::printf("  forward error: double %.3e, float %.3e, mixed %.3e (%zu steps%s)\n",
+                    forward_error(x_double, expected), forward_error(x_float, expected), forward_error(x, expected),
+                    result.iterations, result.fell_back ? ", fell back to double" : "");
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 512);
+    std::mt19937_64 engine{42};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+
+    std::printf("%zu x %zu\n", n, n);
+    mmath_bench::header();
+
+    mmath::matrix_base<float> a{n, n}, b{n, n};
+    mmath::matrix_base<double> a_double{n, n}, b_double{n, n};
+    for (size_t i = 0; i < n * n; ++i) {
+        a.raw_data()[i] = static_cast<float>(dist(engine));
+        b.raw_data()[i] = static_cast<float>(dist(engine));
+        a_double.raw_data()[i] = a.raw_data()[i];
+        b_double.raw_data()[i] = b.raw_data()[i];
+    }
+    size_t bytes = 2 * n * n * sizeof(float);
+    double flops = 2.0 * static_cast<double>(n * n * n);
+
+    mmath::matrix_base<float> c_float;
+    mmath::matrix_base<double> c_double, c_mixed;
+    mmath_bench::report("float * float -> float", mmath_bench::best_of(3, [&] { c_float = a * b; }), bytes, flops);
+    mmath_bench::report("float * float -> double", mmath_bench::best_of(3, [&] { c_mixed = mmath::mixed_multiply(a, b); }),
+                        bytes, flops);
+    mmath_bench::report("double * double -> double", mmath_bench::best_of(3, [&] { c_double = a_double * b_double; }),
+                        bytes * 2, flops);
+
+    double float_error = 0, mixed_error = 0;
+    for (size_t i = 0; i < n * n; ++i) {
+        float_error = std::max(float_error, std::abs(c_float.raw_data()[i] - c_double.raw_data()[i]));
+        mixed_error = std::max(mixed_error, std::abs(c_mixed.raw_data()[i] - c_double.raw_data()[i]));
+    }
+    std::printf("  max error vs double: float %.3e, mixed %.3e\n", float_error, mixed_error);
+
+    mmath::matrix_base<int8_t> a8{n, n}, b8{n, n};
+    std::uniform_int_distribution<int> bytes_dist{-128, 127};
+    for (size_t i = 0; i < n * n; ++i) {
+        a8.raw_data()[i] = static_cast<int8_t>(bytes_dist(engine));
+        b8.raw_data()[i] = static_cast<int8_t>(bytes_dist(engine));
+    }
+    mmath::matrix_base<int32_t> c32;
+    mmath_bench::report("int8 * int8 -> int32",
+                        mmath_bench::best_of(3, [&] { c32 = mmath::mixed_multiply(a8, b8); }), 2 * n * n, flops);
+    mmath_bench::keep(c32.raw_data()[0]);
+
+    solve_case("well conditioned (cond ~ 1e1)", make_system(n, 1e1, engine));
+    solve_case("ill conditioned (cond ~ 1e6)", make_system(n, 1e6, engine));
+    solve_case("very ill conditioned (cond ~ 1e10)", make_system(n, 1e10, engine));
+    return 0;
+}
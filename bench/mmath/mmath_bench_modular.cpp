@@ -0,0 +1,93 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Compares the mod_matrix multiply against operator* on double and against a
+// matrix_base of an element type that reduces after every operation, the way
+// recurrences modulo a prime were evaluated before. Usage:
+// mmath_bench_modular [n], default 512.
+
+#include <cstdint>
+#include <random>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_modular.hpp"
+#include "mmath_bench.hpp"
+
+namespace {
+    constexpr uint64_t prime = 1000000007;
+
+    // Reduces after every operation, as a custom expression type would.
+    struct mod_int {
+        uint64_t value = 0;
+
+        mod_int() = default;
+        template <typename T>
+        mod_int(T v) : value(static_cast<uint64_t>(v) % prime) {}
+
+        friend mod_int operator+(mod_int a, mod_int b) { return mod_int{a.value + b.value}; }
+        friend mod_int operator-(mod_int a, mod_int b) { return mod_int{a.value + prime - b.value}; }
+        friend mod_int operator*(mod_int a, mod_int b) { return mod_int{a.value * b.value}; }
+        friend mod_int operator/(mod_int a, mod_int) { return a; }
+        friend bool operator==(mod_int a, mod_int b) { return a.value == b.value; }
+        template <typename T>
+        friend mod_int operator+(mod_int a, T b) { return a + mod_int{b}; }
+        template <typename T>
+        friend mod_int operator+(T a, mod_int b) { return mod_int{a} + b; }
+        template <typename T>
+        friend mod_int operator*(mod_int a, T b) { return a * mod_int{b}; }
+        template <typename T>
+        friend mod_int operator*(T a, mod_int b) { return mod_int{a} * b; }
+        template <typename T>
+        friend mod_int operator/(mod_int a, T) { return a; }
+        template <typename T>
+        friend bool operator==(mod_int a, T b) { return a == mod_int{b}; }
+    };
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 512);
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<uint32_t> dist{0, prime - 1};
+
+    mmath::mod_matrix a{n, n, prime}, b{n, n, prime};
+    mmath::matrix_base<double> a_double{n, n}, b_double{n, n};
+    mmath::matrix_base<mod_int> a_generic{n, n}, b_generic{n, n};
+    for (size_t i = 1; i <= n; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            uint32_t x = dist(engine), y = dist(engine);
+            a.set(i, j, x);
+            b.set(i, j, y);
+            a_double(i, j) = x;
+            b_double(i, j) = y;
+            a_generic(i, j) = x;
+            b_generic(i, j) = y;
+        }
+    }
+
+    std::printf("%zu x %zu, p = %llu\n", n, n, static_cast<unsigned long long>(prime));
+    mmath_bench::header();
+    size_t bytes = 2 * n * n * sizeof(uint32_t);
+    double flops = 2.0 * static_cast<double>(n * n * n);
+
+    mmath::matrix_base<double> c_double;
+    mmath_bench::report("double operator*", mmath_bench::best_of(3, [&] { c_double = a_double * b_double; }), bytes * 2,
+                        flops);
+    mmath::mod_matrix c = a;
+    mmath_bench::report("mod_matrix operator*", mmath_bench::best_of(3, [&] { c = a * b; }), bytes, flops);
+    mmath::matrix_base<mod_int> c_generic;
+    mmath_bench::report("reduce every operation", mmath_bench::best_of(1, [&] { c_generic = a_generic * b_generic; }),
+                        bytes * 2, flops);
+
+    bool match = true;
+    for (size_t i = 1; i <= n; i += 61)
+        for (size_t j = 1; j <= n; j += 59)
+            match = match && c(i, j) == c_generic(i, j).value;
+    std::printf("  results %s\n", match ? "match" : "DIFFER");
+
+    mmath::mod_matrix step{mmath::matrix_base<int>{{1, 1}, {1, 0}}, prime};
+    mmath_bench::report("fibonacci(1e18) by squaring",
+                        mmath_bench::best_of(5, [&] { mmath_bench::keep((step ^ 1000000000000000000LL)(1, 2)); }), 0);
+    mmath_bench::report("inverse", mmath_bench::best_of(1, [&] { mmath_bench::keep(mmath::inverse(a)(1, 1)); }),
+                        bytes / 2);
+    return 0;
+}
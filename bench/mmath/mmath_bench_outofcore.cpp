@@ -0,0 +1,59 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Tiled multiply of two disk backed matrices under a memory budget, reporting
+// how much of the tile I/O was hidden behind compute. Usage:
+// mmath_bench_outofcore [megabytes per operand] [directory], 64 megabytes in
+// the system temporary directory by default.
+
+#include <cmath>
+#include <filesystem>
+
+#include "../../src/mmath/mmath_outofcore.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t megabytes = mmath_bench::size_argument(argc, argv, 64);
+    auto n = static_cast<size_t>(std::sqrt(static_cast<double>(megabytes) * 1024 * 1024 / sizeof(double)));
+
+    // A quarter of one operand resident at a time, shared by both operands
+    // and the product
+    auto dir = argc > 2 ? std::filesystem::path{argv[2]} : std::filesystem::temp_directory_path();
+    mmath::tiled_options options{512, megabytes * 1024 * 1024 / 4, 2, dir.string()};
+
+    std::string path_a = (dir / "mmath_bench_a.tile").string();
+    std::string path_b = (dir / "mmath_bench_b.tile").string();
+
+    {
+        auto a = mmath::tiled_matrix<double>::create(path_a, n, n, options);
+        auto b = mmath::tiled_matrix<double>::create(path_b, n, n, options);
+        for (size_t i = 1; i <= n; i += 97) {
+            a.set(i, i, 1.0);
+            b.set(i, n + 1 - i, 2.0);
+        }
+        a.flush();
+        b.flush();
+        a.reset_statistics();
+        b.reset_statistics();
+
+        std::printf("%zu x %zu doubles per operand, tile %zu, budget %zu MB\n", n, n, options.tile_size,
+                    options.memory_budget >> 20);
+        mmath_bench::header();
+
+        mmath_bench::measurement run = mmath_bench::best_of(1, [&] {
+            auto c = a * b;
+            c.flush();
+            auto stats = a.statistics() + b.statistics() + c.statistics();
+            std::printf("tiles read %zu, written %zu, prefetch hits %zu\n", stats.tiles_read, stats.tiles_written,
+                        stats.prefetch_hits);
+            std::printf("read %.3f s, stalled %.3f s, compute %.3f s, overlap %.1f%%\n", stats.read_seconds,
+                        stats.stall_seconds, stats.compute_seconds, stats.overlap() * 100);
+        });
+        mmath_bench::report("tiled multiply", run, 3 * n * n * sizeof(double),
+                            2.0 * static_cast<double>(n * n * n));
+    }
+
+    std::filesystem::remove(path_a);
+    std::filesystem::remove(path_b);
+    return 0;
+}
@@ -0,0 +1,49 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Compares the quantized int8 multiply against operator* on int32 and float
+// copies of the same operands. Usage: mmath_bench_quantized [n], default 512.
+
+#include <random>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_quantized.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 512);
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<int> dist{-128, 127};
+
+    mmath::matrix_base<int8_t> a{n, n}, b{n, n};
+    mmath::matrix_base<uint8_t> a_unsigned{n, n};
+    mmath::matrix_base<int32_t> a_wide{n, n}, b_wide{n, n};
+    mmath::matrix_base<float> a_float{n, n}, b_float{n, n};
+    for (size_t i = 0; i < n * n; ++i) {
+        a.raw_data()[i] = static_cast<int8_t>(dist(engine));
+        b.raw_data()[i] = static_cast<int8_t>(dist(engine));
+        a_unsigned.raw_data()[i] = static_cast<uint8_t>(a.raw_data()[i] + 128);
+        a_wide.raw_data()[i] = a_float.raw_data()[i] = a.raw_data()[i];
+        b_wide.raw_data()[i] = b_float.raw_data()[i] = b.raw_data()[i];
+    }
+
+    std::printf("%zu x %zu\n", n, n);
+    mmath_bench::header();
+    size_t bytes = 2 * n * n;
+    double flops = 2.0 * static_cast<double>(n * n * n);
+
+    mmath::matrix_base<int32_t> c;
+    mmath_bench::report("int32 operator*", mmath_bench::best_of(3, [&] { c = a_wide * b_wide; }), bytes * 4, flops);
+    mmath::matrix_base<float> f;
+    mmath_bench::report("float operator*", mmath_bench::best_of(3, [&] { f = a_float * b_float; }), bytes * 4, flops);
+    mmath_bench::report("int8 quantized_multiply",
+                        mmath_bench::best_of(3, [&] { c = mmath::quantized_multiply(a, b); }), bytes,
+                        flops);
+    mmath_bench::report("uint8 zero point 128 -> float", mmath_bench::best_of(3, [&] {
+                            f = mmath::quantized_multiply<float>(a_unsigned, b, {{0.02f}, {128}}, {{0.02f}, {}});
+                        }),
+                        bytes, flops);
+    mmath_bench::keep(c.raw_data()[0]);
+    mmath_bench::keep(f.raw_data()[0]);
+    return 0;
+}
@@ -0,0 +1,71 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// All pairs shortest paths and reachability through the semiring multiply,
+// against Floyd-Warshall and Warshall loops over the same matrices, plus the
+// raw min-plus product against the double gemm. Usage:
+// mmath_bench_semiring [n], default 512.
+
+#include <cmath>
+#include <random>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_semiring.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 512);
+    std::mt19937_64 engine{42};
+    std::uniform_real_distribution<double> weight{1.0, 100.0};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    const double none = mmath::min_plus<double>::zero();
+    mmath::matrix_base<double> weights{n, n, none};
+    mmath::matrix_base<uint8_t> adjacency{n, n};
+    for (size_t i = 1; i <= n; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            if (chance(engine) < 4.0 / static_cast<double>(n)) {
+                weights(i, j) = std::floor(weight(engine));
+                adjacency(i, j) = 1;
+            }
+        }
+    }
+
+    std::printf("%zu vertices, ~4 edges each\n", n);
+    mmath_bench::header();
+    size_t bytes = n * n * sizeof(double);
+
+    mmath::matrix_base<double> dense{n, n};
+    for (size_t i = 0; i < n * n; ++i)
+        dense.raw_data()[i] = weight(engine);
+    mmath::matrix_base<double> product;
+    mmath_bench::report("plus-times (operator*)", mmath_bench::best_of(3, [&] { product = dense * dense; }), bytes);
+    mmath_bench::report("min-plus product, dense", mmath_bench::best_of(3, [&] {
+                            product = mmath::semiring_multiply<mmath::min_plus>(dense, dense);
+                        }),
+                        bytes);
+
+    mmath::matrix_base<double> distances;
+    mmath_bench::report("shortest_paths (squaring)",
+                        mmath_bench::best_of(3, [&] { distances = mmath::shortest_paths(weights); }), bytes);
+
+    mmath::matrix_base<double> floyd;
+    mmath_bench::report("Floyd-Warshall", mmath_bench::best_of(1, [&] {
+                            floyd = weights;
+                            double* d = floyd.raw_data();
+                            for (size_t i = 0; i < n; ++i)
+                                d[i * n + i] = std::min(d[i * n + i], 0.0);
+                            for (size_t k = 0; k < n; ++k)
+                                for (size_t i = 0; i < n; ++i)
+                                    for (size_t j = 0; j < n; ++j)
+                                        d[i * n + j] = std::min(d[i * n + j], d[i * n + k] + d[k * n + j]);
+                        }),
+                        bytes);
+    std::printf("  results %s\n", distances == floyd ? "match" : "DIFFER");
+
+    mmath::matrix_base<uint8_t> reach;
+    mmath_bench::report("transitive_closure (squaring)",
+                        mmath_bench::best_of(3, [&] { reach = mmath::transitive_closure(adjacency); }), n * n);
+    mmath_bench::keep(reach.raw_data()[0]);
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Tiny matrix arithmetic in a loop, built once with plain heap storage
+// (mmath_bench_small), once with MMATH_INLINE_CAPACITY=16
+// (mmath_bench_small_sbo) and once with MMATH_INSTRUMENTATION
+// (mmath_bench_small_instrumented), which also prints the operation
+// statistics, and once with MMATH_TRACING (mmath_bench_small_traced), which
+// writes mmath_bench_small.trace.json, to measure the cost of the hooks.
+// Usage: mmath_bench_small [n], default 4, the side of the matrices.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "../../src/mmath/mmath.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    using namespace mmath;
+
+    size_t n = mmath_bench::size_argument(argc, argv, 4);
+    matrix_base<double> a{n, n}, b{n, n};
+    for (size_t i = 1; i <= n; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            a(i, j) = static_cast<double>(i + j) / static_cast<double>(n);
+            b(i, j) = i == j ? 0.5 : 0.01 * static_cast<double>(j);
+        }
+    }
+    const size_t bytes = n * n * sizeof(double);
+    const size_t rounds = 100000;
+    const double product_flops = 2.0 * static_cast<double>(n * n * n);
+
+#ifdef MMATH_INSTRUMENTATION
+    std::printf("instrumented, ");
+#endif
+#ifdef MMATH_TRACING
+    std::printf("traced, ");
+#endif
+    if (MMATH_INLINE_CAPACITY > 0)
+        std::printf("%zu x %zu doubles, %d elements inline\n", n, n, MMATH_INLINE_CAPACITY);
+    else
+        std::printf("%zu x %zu doubles, heap storage\n", n, n);
+    mmath_bench::header();
+
+    auto run = [&] {
+        mmath_bench::report("100000 copies", mmath_bench::best_of(3, [&] {
+                                double sum = 0;
+                                for (size_t r = 0; r < rounds; ++r) {
+                                    matrix_base<double> copy = a;
+                                    sum += copy.raw_data()[r % (n * n)];
+                                }
+                                mmath_bench::keep(sum);
+                            }),
+                            bytes * rounds);
+
+        mmath_bench::report("100000 x (a + b) - a", mmath_bench::best_of(3, [&] {
+                                double sum = 0;
+                                for (size_t r = 0; r < rounds; ++r)
+                                    sum += ((a + b) - a).tr();
+                                mmath_bench::keep(sum);
+                            }),
+                            3 * bytes * rounds);
+
+        mmath_bench::report("100000 x a * b", mmath_bench::best_of(3, [&] {
+                                double sum = 0;
+                                for (size_t r = 0; r < rounds; ++r)
+                                    sum += (a * b).tr();
+                                mmath_bench::keep(sum);
+                            }),
+                            3 * bytes * rounds, product_flops * rounds);
+
+        mmath_bench::report("100000 x transpose(a) * 2", mmath_bench::best_of(3, [&] {
+                                double sum = 0;
+                                for (size_t r = 0; r < rounds; ++r)
+                                    sum += (transpose(a) * 2.0).tr();
+                                mmath_bench::keep(sum);
+                            }),
+                            2 * bytes * rounds);
+
+        mmath_bench::report("10000 x b ^ 8", mmath_bench::best_of(3, [&] {
+                                double sum = 0;
+                                for (size_t r = 0; r < rounds / 10; ++r)
+                                    sum += (b ^ 8).tr();
+                                mmath_bench::keep(sum);
+                            }),
+                            6 * bytes * rounds / 10, 3 * product_flops * rounds / 10);
+    };
+    run();
+
+#ifdef MMATH_TRACING
+    // Again with recording switched on; the run above measured it compiled in
+    // but off
+    set_tracing(true);
+    std::printf("tracing on\n");
+    run();
+    std::ofstream trace{"mmath_bench_small.trace.json"};
+    write_chrome_trace(trace);
+#endif
+
+#ifdef MMATH_INSTRUMENTATION
+    write_operation_stats_prometheus(std::cout);
+#endif
+    return 0;
+}
@@ -0,0 +1,79 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Copy heavy workloads, built once with plain heap storage
+// (mmath_bench_storage) and once with MMATH_COPY_ON_WRITE
+// (mmath_bench_storage_cow) for comparison. Usage: mmath_bench_storage [n],
+// default 512.
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../src/mmath/mmath.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    using namespace mmath;
+
+    size_t n = mmath_bench::size_argument(argc, argv, 512);
+    matrix_base<double> matrix{n, n};
+    for (size_t i = 1; i <= n; ++i)
+        for (size_t j = 1; j <= n; ++j)
+            matrix(i, j) = static_cast<double>(i * n + j);
+    const matrix_base<double>& source = matrix;
+    const size_t bytes = n * n * sizeof(double);
+
+#ifdef MMATH_COPY_ON_WRITE
+    std::printf("%zu x %zu doubles, copy on write storage\n", n, n);
+#else
+    std::printf("%zu x %zu doubles, heap storage\n", n, n);
+#endif
+    mmath_bench::header();
+
+    const size_t copies = 1000;
+    mmath_bench::report("cache 1000 read only copies", mmath_bench::best_of(3, [&] {
+                            std::vector<matrix_base<double>> cache(copies, source);
+                            double sum = 0;
+                            for (const auto& entry : cache)
+                                sum += entry(1, 1);
+                            mmath_bench::keep(sum);
+                        }),
+                        bytes * copies);
+
+    mmath_bench::report("1000 handlers, 1 in 10 writes", mmath_bench::best_of(3, [&] {
+                            double sum = 0;
+                            for (size_t r = 0; r < copies; ++r) {
+                                matrix_base<double> request = source;
+                                if (r % 10 == 0)
+                                    request(1, 1) = static_cast<double>(r);
+                                sum += std::as_const(request)(1, 1);
+                            }
+                            mmath_bench::keep(sum);
+                        }),
+                        bytes * copies);
+
+    mmath_bench::report("4 threads x 250 read only copies", mmath_bench::best_of(3, [&] {
+                            std::vector<std::thread> threads;
+                            for (int t = 0; t < 4; ++t) {
+                                threads.emplace_back([&] {
+                                    for (size_t r = 0; r < copies / 4; ++r) {
+                                        matrix_base<double> local = source;
+                                        mmath_bench::keep(std::as_const(local)(n, n));
+                                    }
+                                });
+                            }
+                            for (auto& thread : threads)
+                                thread.join();
+                        }),
+                        bytes * copies);
+
+    mmath_bench::report("100 row swaps (always written)", mmath_bench::best_of(3, [&] {
+                            matrix_base<double> current = source;
+                            for (int r = 0; r < 100; ++r)
+                                current = current | 1_R <=> 2_R;
+                            mmath_bench::keep(current(1, 1));
+                        }),
+                        bytes * 100);
+    return 0;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Parse throughput of the CSV and MatrixMarket readers against an iostream
+// loader. Usage: mmath_bench_textio [megabytes], default 64. Set
+// MMATH_NUM_THREADS to compare thread counts.
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "../../src/mmath/mmath_parallel.hpp"
+#include "../../src/mmath/mmath_textio.hpp"
+#include "mmath_bench.hpp"
+
+int main(int argc, char** argv) {
+    size_t megabytes = mmath_bench::size_argument(argc, argv, 64);
+    const size_t cols = 64;
+
+    auto dir = std::filesystem::temp_directory_path();
+    std::string csv_path = (dir / "mmath_bench_textio.csv").string();
+    std::string mtx_path = (dir / "mmath_bench_textio.mtx").string();
+
+    std::mt19937_64 engine{7};
+    std::uniform_real_distribution<double> dist{-1000.0, 1000.0};
+
+    size_t rows = 0, csv_bytes = 0;
+    {
+        std::ofstream csv{csv_path};
+        csv.precision(10);
+        while (static_cast<size_t>(csv.tellp()) < megabytes << 20) {
+            for (size_t j = 0; j < cols; ++j)
+                csv << dist(engine) << (j + 1 == cols ? '\n' : ',');
+            ++rows;
+        }
+        csv_bytes = static_cast<size_t>(csv.tellp());
+    }
+
+    size_t mtx_bytes = 0, mtx_n = rows;
+    {
+        std::uniform_int_distribution<size_t> index{1, mtx_n};
+        size_t entries = (megabytes << 20) / 24;
+        std::ofstream mtx{mtx_path};
+        mtx.precision(10);
+        mtx << "%%MatrixMarket matrix coordinate real general\n" << mtx_n << ' ' << mtx_n << ' ' << entries << '\n';
+        for (size_t k = 0; k < entries; ++k)
+            mtx << index(engine) << ' ' << index(engine) << ' ' << dist(engine) << '\n';
+        mtx_bytes = static_cast<size_t>(mtx.tellp());
+    }
+
+    std::printf("CSV %zu x %zu, %zu threads\n", rows, cols, mmath::m_parallel::thread_pool::instance().concurrency());
+    mmath_bench::header();
+
+    mmath_bench::report("csv (iostream)", mmath_bench::best_of(1, [&] {
+                            std::ifstream in{csv_path};
+                            mmath::matrix_base<double> m{rows, cols};
+                            double* data = m.raw_data();
+                            char comma;
+                            for (size_t i = 0; i < rows * cols; ++i) {
+                                in >> data[i];
+                                if ((i + 1) % cols != 0)
+                                    in >> comma;
+                            }
+                            mmath_bench::keep(data[0]);
+                        }),
+                        csv_bytes);
+
+    mmath_bench::report("csv (read_csv)", mmath_bench::best_of(3, [&] {
+                            auto m = mmath::read_csv<double>(csv_path);
+                            mmath_bench::keep(m.raw_data()[0]);
+                        }),
+                        csv_bytes);
+
+    mmath_bench::report("mtx (read_matrix_market_sparse)", mmath_bench::best_of(3, [&] {
+                            auto m = mmath::read_matrix_market_sparse<double>(mtx_path);
+                            mmath_bench::keep(m.nonzeros());
+                        }),
+                        mtx_bytes);
+
+    std::filesystem::remove(csv_path);
+    std::filesystem::remove(mtx_path);
+    return 0;
+}
@@ -0,0 +1,152 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Picks the blocking of the gemm, trsm and transpose kernels for float, double
+// and int32 on this machine and writes it as a tuning file, which mmath reads
+// on start up. Usage: mmath_tune [n] [file], n the size of the timed products
+// (default 384) and file defaulting to mmath::tuning_file_path().
+//
+// Each setting is chosen in turn, keeping the best value found for the ones
+// before it. The parallel threshold is only tuned when the thread pool has
+// more than one thread.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_lu.hpp"
+#include "mmath_bench.hpp"
+
+namespace {
+    using namespace mmath;
+
+    // Sets the setting to each candidate in turn and leaves it at the fastest.
+    template <typename F>
+    size_t choose(const char* label, size_t& setting, std::initializer_list<size_t> candidates, double work, F&& run) {
+        size_t best = setting;
+        double best_seconds = 0;
+        for (size_t candidate : candidates) {
+            setting = candidate;
+            double seconds = mmath_bench::best_of(3, run).seconds;
+            if (best_seconds == 0 || seconds < best_seconds) {
+                best = candidate;
+                best_seconds = seconds;
+            }
+        }
+        setting = best;
+        std::printf("  %-28s %8zu %10.2f G/s\n", label, best, work / best_seconds / 1e9);
+        return best;
+    }
+
+    template <typename T>
+    void fill(std::vector<T>& values, std::mt19937_64& engine) {
+        std::uniform_int_distribution<int> dist{-4, 4};
+        for (T& value : values)
+            value = static_cast<T>(dist(engine));
+    }
+
+    template <typename T>
+    void tune(tuning_settings& settings, size_t n, std::mt19937_64& engine) {
+        const std::string type = m_tuning::type_key<T>();
+        std::printf("%s\n", type.c_str());
+        auto key = [&](const char* kernel, const char* name) { return std::string{kernel} + "." + type + "." + name; };
+
+        std::vector<T> a(n * n), b(n * n), c(n * n);
+        fill(a, engine);
+        fill(b, engine);
+        const double flops = 2.0 * static_cast<double>(n * n * n);
+        auto product = [&](size_t size, bool parallel) {
+            std::fill(c.begin(), c.begin() + static_cast<std::ptrdiff_t>(size * size), T{});
+            m_kernel::gemm<T>(size, size, size, a.data(), size, 1, b.data(), size, c.data(), size, parallel);
+            mmath_bench::keep(c[0]);
+        };
+        auto serial = [&] { product(n, false); };
+
+        m_kernel::gemm_config& gemm = m_kernel::gemm_tuning<T>();
+        gemm = {};
+        settings[key("gemm", "block_k")] = choose("gemm block_k", gemm.block_k, {32, 64, 128, 256, 512}, flops, serial);
+        settings[key("gemm", "block_n")] =
+            choose("gemm block_n", gemm.block_n, {64, 128, 256, 512, 1024}, flops, serial);
+        settings[key("gemm", "block_m")] = choose("gemm block_m", gemm.block_m, {8, 16, 32, 64, 128}, flops, serial);
+
+        if (m_parallel::thread_pool::instance().concurrency() > 1) {
+            // Smallest cube on which spreading the panels over the pool pays off
+            size_t threshold = n * n * n + 1;
+            for (size_t size : {16, 24, 32, 48, 64, 96, 128, 192, 256}) {
+                if (size > n)
+                    break;
+                double on_one = mmath_bench::best_of(5, [&] { product(size, false); }).seconds;
+                gemm.parallel_threshold = 0;
+                double on_all = mmath_bench::best_of(5, [&] { product(size, true); }).seconds;
+                if (on_all < on_one) {
+                    threshold = size * size * size;
+                    break;
+                }
+            }
+            gemm.parallel_threshold = threshold;
+            settings[key("gemm", "parallel_threshold")] = threshold;
+            std::printf("  %-28s %8zu\n", "gemm parallel_threshold", threshold);
+        }
+
+        const size_t side = 4 * n;
+        std::vector<T> from(side * side), to(side * side);
+        fill(from, engine);
+        settings[key("transpose", "tile")] =
+            choose("transpose tile", m_kernel::transpose_tuning<T>().tile, {8, 16, 32, 64, 128},
+                   static_cast<double>(2 * side * side * sizeof(T)), [&] {
+                       m_kernel::transpose(side, side, from.data(), to.data());
+                       mmath_bench::keep(to[side]);
+                   });
+
+        if constexpr (std::is_floating_point_v<T>) {
+            // Diagonally dominant, so the factorization never pivots far
+            std::vector<T> system = a, factored(n * n);
+            for (size_t i = 0; i < n; ++i)
+                system[i * n + i] = static_cast<T>(8 * n);
+            std::vector<size_t> pivots(n);
+            settings[key("trsm", "block_size")] =
+                choose("lu block_size", m_kernel::trsm_tuning<T>().block_size, {16, 32, 64, 128, 256}, flops / 3, [&] {
+                    std::copy(system.begin(), system.end(), factored.begin());
+                    m_kernel::lu_factor(n, factored.data(), n, pivots.data());
+                    mmath_bench::keep(factored[0]);
+                });
+        }
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t n = mmath_bench::size_argument(argc, argv, 384);
+    std::filesystem::path path = argc > 2 ? std::filesystem::path{argv[2]} : tuning_file_path();
+    if (path.empty()) {
+        std::fprintf(stderr, "No tuning file given and no default location, set HOME or MMATH_TUNING_FILE\n");
+        return 1;
+    }
+
+    std::printf("tuning on %zu x %zu, %zu threads\n", n, n, m_parallel::thread_pool::instance().concurrency());
+    std::mt19937_64 engine{42};
+    tuning_settings settings;
+    tune<float>(settings, n, engine);
+    tune<double>(settings, n, engine);
+    tune<int32_t>(settings, n, engine);
+
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path());
+    std::ofstream file{path};
+    file << "# Written by mmath_tune for " << n << " x " << n << " products on "
+         << m_parallel::thread_pool::instance().concurrency() << " threads\n";
+    write_tuning(file, settings);
+    if (!file) {
+        std::fprintf(stderr, "Could not write %s\n", path.c_str());
+        return 1;
+    }
+    std::printf("wrote %s\n", path.c_str());
+    return 0;
+}
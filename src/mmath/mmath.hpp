@@ -5,6 +5,7 @@
 #ifndef UNTITLED_MMATH_H
 #define UNTITLED_MMATH_H
 
+#include <algorithm>
 #include <cmath>
 #include <concepts>
 #include <limits>
@@ -14,7 +15,14 @@
 #include <vector>
 
 #include "mmath_concepts.hpp"
+#include "mmath_format.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_instrumentation.hpp"
 #include "mmath_matrixelementary.hpp"
+#include "mmath_matrixproperties.hpp"
+#include "mmath_matrixstorage.hpp"
+#include "mmath_parallel.hpp"
+#include "mmath_tracing.hpp"
 
 namespace mmath {
 
@@ -22,10 +30,11 @@ namespace mmath {
     class matrix_base {
       private:
         size_t num_row, num_col;
-        std::vector<T> data;
+        matrix_storage<T> data;
+        [[no_unique_address]] mutable matrix_property_cache<T> cache;
 
       protected:
-        matrix_base(std::vector<T> data, size_t num_row, size_t num_col)
+        matrix_base(matrix_storage<T> data, size_t num_row, size_t num_col)
             : data(std::move(data)), num_row(num_row), num_col(num_col) {
             if (this->num_col * this->num_row != this->data.size()) {
                 throw std::invalid_argument("The data provided must match the rows and cols provided.");
@@ -40,18 +49,51 @@ namespace mmath {
         [[maybe_unused]] matrix_base(size_t rows, size_t cols, T default_value)
             : num_row(rows), num_col(cols), data(rows * cols, default_value){};
 
+        // Leaves the elements default initialized, indeterminate for trivial T,
+        // for callers that write every element before reading any.
+        matrix_base(size_t rows, size_t cols, for_overwrite_t)
+            : num_row(rows), num_col(cols), data(rows * cols, for_overwrite){};
+
+        // Element (i, j) is generator(i, j), 1-indexed like operator(). Large
+        // matrices are filled by the thread pool a block of rows at a time, so
+        // the generator must be safe to call concurrently.
+        template <typename F>
+            requires std::is_invocable_r_v<T, F&, size_t, size_t>
+        matrix_base(size_t rows, size_t cols, F generator) : matrix_base(rows, cols, for_overwrite) {
+            T* out = data.data();
+            const size_t grain = m_kernel::gemm_tuning<T>().parallel_threshold / std::max<size_t>(cols, 1) + 1;
+            m_parallel::parallel_for(0, rows, grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i)
+                    for (size_t j = 0; j < cols; ++j)
+                        out[i * cols + j] = generator(i + 1, j + 1);
+            });
+        }
+
+        // Adopts rows * cols row major elements without copying them.
+        matrix_base(size_t rows, size_t cols, std::vector<T>&& values)
+            : matrix_base(matrix_storage<T>(std::move(values)), rows, cols) {}
+
+        // Takes ownership of rows * cols row major elements at values, which are
+        // released with deleter(values) once no matrix uses them.
+        template <typename Deleter>
+            requires std::invocable<Deleter&, T*>
+        matrix_base(size_t rows, size_t cols, T* values, Deleter deleter)
+            : matrix_base(matrix_storage<T>(m_storage::heap_buffer<T>(values, rows * cols, std::move(deleter))),
+                          rows,
+                          cols) {}
+
         [[maybe_unused]] matrix_base(std::initializer_list<std::initializer_list<T>> il)
             : num_row(il.size()), num_col(0) {
             for (auto& i : il)
                 num_col = i.size() > num_col ? i.size() : num_col;
 
-            data.reserve(num_col * num_row);
-
+            // Each row is copied in bulk, only the missing trailing columns of a
+            // shorter row are filled with T{}
+            data = matrix_storage<T>(num_col * num_row, for_overwrite);
+            T* out = data.data();
             for (auto& x : il) {
-                data.insert(data.end(), x.begin(), x.end());
-                size_t number_missing_col = num_col - x.size();
-                for (int i = 0; i < number_missing_col; ++i)
-                    data.insert(data.end(), T{});
+                std::fill(std::copy(x.begin(), x.end(), out), out + num_col, T{});
+                out += num_col;
             }
         };
 
@@ -65,9 +107,20 @@ namespace mmath {
         T& operator()(size_t row, size_t column) {
             if (row == 0 || column == 0 || row > num_row || column > num_col)
                 throw std::out_of_range("Requested element lies outside of the Matrix.");
+            // The caller may write through the reference, so anything derived is stale.
+            cache.invalidate();
             return data[(num_col * (row - 1)) + (column - 1)];
         }
 
+        // Row major element storage for kernels that work on raw buffers. Writing
+        // through the non-const pointer is treated like any other mutation.
+        [[nodiscard]] const T* raw_data() const { return data.data(); }
+
+        [[nodiscard]] T* raw_data() {
+            cache.invalidate();
+            return data.data();
+        }
+
       protected:
         T operator()(size_t row, size_t column, bool invert) const {
             return invert ? (*this)(column, row) : (*this)(row, column);
@@ -81,18 +134,24 @@ namespace mmath {
         matrix_base<T> operator+(const matrix_base<T>& b) const {
             if (this->is_empty() || b.is_empty())
                 throw std::invalid_argument("Matrices used in addition cannot be empty");
+            m_stats::scope stats{operation::add, num_row * num_col, num_row * num_col};
+            m_trace::scope<T> trace{operation::add, num_row, num_col};
             return add_sub_matrix(b, true);
         }
 
         matrix_base<T> operator-(const matrix_base<T>& b) const {
             if (this->is_empty() || b.is_empty())
                 throw std::invalid_argument("Matrices used in subtraction cannot be empty");
+            m_stats::scope stats{operation::subtract, num_row * num_col, num_row * num_col};
+            m_trace::scope<T> trace{operation::subtract, num_row, num_col};
             return add_sub_matrix(b, false);
         }
 
         matrix_base<T> operator*(numeric auto b) const {
             if (this->is_empty())
                 throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+            m_stats::scope stats{operation::scale, num_row * num_col, num_row * num_col};
+            m_trace::scope<T> trace{operation::scale, num_row, num_col};
             matrix_base<T> result{this->data, this->num_row, this->num_col};
             for (T& i : result.data)
                 i = i * b;
@@ -106,17 +165,12 @@ namespace mmath {
                 throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
                                         "matrix b");
 
-            int number_entries_to_multiply = this->num_col;
-
+            m_stats::scope stats{operation::multiply, 2 * num_row * b.num_col * num_col, num_row * b.num_col};
+            m_trace::scope<T> trace{operation::multiply, num_row, b.num_col, num_col};
             matrix_base<T> result{this->num_row, b.num_col};
 
-            for (int i = 1; i <= this->num_row; i++) {
-                for (int j = 1; j <= b.num_col; j++) {
-                    // Multiply each value in the row (a) with each value in the column (b)
-                    for (int k = 1; k <= number_entries_to_multiply; k++)
-                        result(i, j) += (*this)(i, k) * b(k, j);
-                }
-            }
+            m_kernel::gemm(this->num_row, b.num_col, this->num_col, this->data.data(), this->num_col, 1,
+                           b.data.data(), b.num_col, result.data.data(), b.num_col);
 
             return result;
         }
@@ -132,12 +186,16 @@ namespace mmath {
                 throw std::invalid_argument("Matrix must be square to calculate trace");
             }
 
+            if (auto cached = cache.lookup_trace())
+                return *cached;
+
             T sum = T{};
 
             for (int i = 1; i <= num_row; ++i) {
                 sum = sum + (*this)(i, i);
             }
 
+            cache.store_trace(sum);
             return sum;
         }
 
@@ -250,6 +308,8 @@ namespace mmath {
                 throw std::invalid_argument("Elementary operations cannot be performed on an empty matrix.");
             }
 
+            m_stats::scope stats{operation::row_operation, 0, num_row * num_col};
+            m_trace::scope<T> trace{operation::row_operation, num_row, num_col};
             matrix_base<T> new_data{this->data, this->num_row, this->num_col};
 
             this->axis_operation<
@@ -265,6 +325,8 @@ namespace mmath {
                 throw std::invalid_argument("Elementary operations cannot be performed on an empty matrix.");
             }
 
+            m_stats::scope stats{operation::row_operation, 0, num_row * num_col};
+            m_trace::scope<T> trace{operation::row_operation, num_row, num_col};
             matrix_base<T> new_data{this->data, this->num_row, this->num_col};
 
             this->axis_operation<
@@ -289,14 +351,10 @@ namespace mmath {
 
       public:
         [[nodiscard]] matrix_base<T> transpose() const {
-            matrix_base<T> new_data{num_col, num_row};
-
-            for (int i = 1; i <= num_row; ++i) {
-                for (int j = 1; j <= num_col; ++j) {
-                    new_data(j, i) = std::move((*this)(i, j));
-                }
-            }
-
+            m_stats::scope stats{operation::transpose, 0, num_row * num_col};
+            m_trace::scope<T> trace{operation::transpose, num_col, num_row};
+            matrix_base<T> new_data{num_col, num_row, for_overwrite};
+            m_kernel::transpose(num_row, num_col, data.data(), new_data.data.data());
             return new_data;
         }
 
@@ -304,29 +362,51 @@ namespace mmath {
         [[nodiscard]] bool is_square() const { return num_row == num_col; }
 
         [[maybe_unused]] [[nodiscard]] bool is_identity() const {
-            if (!is_square())
-                return false;
-
-            for (int i = 1; i <= num_row; ++i) {
-                for (int j = 1; j <= num_col; ++j) {
-                    if (i != j && (*this)(i, j) != 0)
-                        return false;
-                    if (i == j && (*this)(i, j) != 1)
-                        return false;
-                }
-            }
-
-            return true;
+            return properties(matrix_property::IDENTITY).is_identity();
         }
 
         [[nodiscard]] bool is_empty() const { return num_row == 0 || num_col == 0; }
 
         [[nodiscard]] bool is_zero() const {
-            for (auto& i : this->data) {
-                if (i != 0)
-                    return false;
-            }
-            return true;
+            if (auto cached = cache.lookup(matrix_property::ZERO))
+                return cached->is_zero();
+
+            bool zero = m_prop::all_zero(data.data(), data.size());
+            cache.store(matrix_property::ZERO, matrix_properties{zero ? matrix_property::ZERO : matrix_property::NONE});
+            return zero;
+        }
+
+        [[nodiscard]] bool is_diagonal() const { return properties(matrix_property::DIAGONAL).is_diagonal(); }
+
+        [[nodiscard]] bool is_scalar() const { return properties(matrix_property::SCALAR).is_scalar(); }
+
+        [[nodiscard]] bool is_upper_triangular() const {
+            return properties(matrix_property::UPPER_TRIANGULAR).is_upper_triangular();
+        }
+
+        [[nodiscard]] bool is_lower_triangular() const {
+            return properties(matrix_property::LOWER_TRIANGULAR).is_lower_triangular();
+        }
+
+        [[nodiscard]] bool is_triangular() const {
+            return properties(matrix_property::UPPER_TRIANGULAR | matrix_property::LOWER_TRIANGULAR).is_triangular();
+        }
+
+        [[nodiscard]] bool is_symmetric() const { return properties(matrix_property::SYMMETRIC).is_symmetric(); }
+
+        [[nodiscard]] bool is_skew_symmetric() const {
+            return properties(matrix_property::SKEW_SYMMETRIC).is_skew_symmetric();
+        }
+
+        // Computes every requested structural property in one pass over the data.
+        // Useful for picking a specialised algorithm without rescanning per check.
+        [[nodiscard]] matrix_properties properties(matrix_property wanted = matrix_property::ALL) const {
+            if (auto cached = cache.lookup(wanted))
+                return *cached;
+
+            matrix_properties result = m_prop::analyze(data.data(), num_row, num_col, wanted);
+            cache.store(wanted, result);
+            return result;
         }
 
         [[nodiscard]] size_t size_col() const { return this->num_col; }
@@ -339,7 +419,7 @@ namespace mmath {
             }
 
             for (int i = 0; i < num_col * num_row; ++i) {
-                if (std::is_floating_point<T>()) {
+                if constexpr (std::is_floating_point_v<T>) {
                     // TODO: Separate floating point comparison into separate header
                     if (std::abs(this->data[i] - m.data[i]) > std::numeric_limits<T>::epsilon()) {
                         return false;
@@ -360,11 +440,15 @@ namespace mmath {
             if (this->num_col != b.num_col || this->num_row != b.num_row)
                 throw std::domain_error("Matrices must be the same size");
 
-            std::vector<T> new_data(num_col * num_row);
-            for (int i = 0; i < data.size(); i++)
-                new_data[i] = add_sub ? this->data[i] + b.data[i] : this->data[i] - b.data[i];
+            // Written in place so the result is never moved
+            matrix_base<T> result{num_row, num_col, for_overwrite};
+            const T* lhs = data.data();
+            const T* rhs = b.data.data();
+            T* out = result.data.data();
+            for (size_t i = 0; i < num_col * num_row; i++)
+                out[i] = add_sub ? lhs[i] + rhs[i] : lhs[i] - rhs[i];
 
-            return matrix_base<T>{std::move(new_data), num_row, num_col};
+            return result;
         }
     };
 
@@ -391,13 +475,23 @@ namespace mmath {
         if (b < 0)
             throw std::invalid_argument("Power cannot be less than 1");
 
+        m_stats::scope stats{operation::power, 0, num_row * num_col};
+        m_trace::scope<T> trace{operation::power, num_row, num_col};
         if (b == 0)
             return make_identity_matrix<T>(this->num_row);
 
+        // Repeated squaring on the remaining b - 1 factors
         matrix_base<T> result{this->data, this->num_row, this->num_col};
-
-        for (int i = 1; i < b; ++i)
-            result = result * (*this);
+        matrix_base<T> base = result;
+        auto remaining = static_cast<std::make_unsigned_t<decltype(b)>>(b) - 1;
+
+        while (remaining > 0) {
+            if (remaining & 1)
+                result = result * base;
+            remaining >>= 1;
+            if (remaining > 0)
+                base = base * base;
+        }
 
         return result;
     }
@@ -414,14 +508,22 @@ namespace mmath {
 
     template <expression_printable T>
     std::ostream& operator<<(std::ostream& os, const matrix_base<T>& matrix) {
-        for (int i = 1; i <= matrix.size_row(); i++) {
-            for (int j = 1; j <= matrix.size_col(); j++) {
+        if constexpr (m_format::formattable<T>) {
+            if (auto options = m_format::stream_options(os)) {
+                m_format::write(os, matrix.raw_data(), matrix.size_row(), matrix.size_col(), *options);
+                return os;
+            }
+        }
+
+        // Stream state or element types to_chars cannot reproduce
+        for (size_t i = 1; i <= matrix.size_row(); i++) {
+            for (size_t j = 1; j <= matrix.size_col(); j++) {
                 os << matrix(i, j);
                 if (j != matrix.size_col())
                     os << " ";
             }
             if (i != matrix.size_row())
-                os << std::endl;
+                os << '\n';
         }
 
         return os;
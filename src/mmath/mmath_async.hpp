@@ -0,0 +1,358 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_ASYNC_HPP
+#define MMATH_MMATH_ASYNC_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_lu.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    /*
+     * ASYNCHRONOUS OPERATIONS
+     *
+     * async_multiply, async_power, async_transpose and async_lu_solve start
+     * the operation on the library's thread pool and return at once with a
+     * matrix_future, which can be waited on, polled, given a callback or
+     * co_awaited from a coroutine. Any number may run at the same time; each
+     * takes one worker and still spreads its kernels over the pool.
+     *
+     * The arguments are copied (or moved) into the operation, so they may be
+     * changed or destroyed right after the call. Arguments an operation cannot
+     * accept throw from the call itself, like the synchronous operation would;
+     * errors found while running, such as a singular matrix, are rethrown by
+     * get().
+     *
+     * Long operations check for cancellation and report their progress between
+     * steps: row panels of a product, multiplies of a power and column panels
+     * of a factorization. A cancelled operation stops at the next check and
+     * its get() throws operation_cancelled.
+     */
+
+    class operation_cancelled : public std::runtime_error {
+      public:
+        operation_cancelled() : std::runtime_error("Operation was cancelled") {}
+    };
+
+    struct async_options {
+        // Cancels the operation when stop is requested, in addition to
+        // matrix_future::cancel.
+        std::stop_token stop_token;
+        // Called on a worker thread with the fraction done, rising to 1.0 just
+        // before the result is made ready.
+        std::function<void(double)> progress;
+    };
+
+    namespace m_async {
+
+        template <typename R>
+        struct shared_state {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::optional<R> value;
+            std::exception_ptr error;
+            bool done = false;
+            std::vector<std::function<void()>> continuations;
+            std::stop_source stop;
+
+            void finish() {
+                std::vector<std::function<void()>> waiting;
+                {
+                    std::lock_guard lock{mutex};
+                    done = true;
+                    waiting.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto& continuation : waiting)
+                    continuation();
+            }
+
+            // Queues the continuation to run once the result is ready. False,
+            // leaving the continuation alone, when the result already is.
+            bool try_then(std::function<void()>& continuation) {
+                std::lock_guard lock{mutex};
+                if (done)
+                    return false;
+                continuations.push_back(std::move(continuation));
+                return true;
+            }
+        };
+
+        // What a running operation sees of its future and options.
+        class context {
+          private:
+            const std::stop_source& own;
+            const async_options& options;
+
+          public:
+            context(const std::stop_source& own, const async_options& options) : own(own), options(options) {}
+
+            void check() const {
+                if (own.stop_requested() || options.stop_token.stop_requested())
+                    throw operation_cancelled{};
+            }
+
+            void report(double fraction) const {
+                if (options.progress)
+                    options.progress(fraction);
+            }
+        };
+    }  // namespace m_async
+
+    // The result of an asynchronous operation. Like std::future, get() hands
+    // the result over once, after which the future is no longer valid.
+    template <typename R>
+    class matrix_future {
+      private:
+        std::shared_ptr<m_async::shared_state<R>> state;
+
+        class awaiter {
+          private:
+            matrix_future& future;
+
+          public:
+            explicit awaiter(matrix_future& future) : future(future) {}
+
+            [[nodiscard]] bool await_ready() const { return future.ready(); }
+
+            // Resumes the coroutine on the worker thread that completes the
+            // operation, or right away when it completed in the meantime.
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::function<void()> resume = [handle] { handle.resume(); };
+                return future.state->try_then(resume);
+            }
+
+            R await_resume() { return future.get(); }
+        };
+
+      public:
+        matrix_future() = default;
+
+        explicit matrix_future(std::shared_ptr<m_async::shared_state<R>> state) : state(std::move(state)) {}
+
+        [[nodiscard]] bool valid() const { return state != nullptr; }
+
+        [[nodiscard]] bool ready() const {
+            if (!state)
+                throw std::logic_error("The future has no result");
+            std::lock_guard lock{state->mutex};
+            return state->done;
+        }
+
+        void wait() const {
+            if (!state)
+                throw std::logic_error("The future has no result");
+            std::unique_lock lock{state->mutex};
+            state->cv.wait(lock, [this] { return state->done; });
+        }
+
+        // True when the result became ready within the timeout.
+        template <typename Rep, typename Period>
+        bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+            if (!state)
+                throw std::logic_error("The future has no result");
+            std::unique_lock lock{state->mutex};
+            return state->cv.wait_for(lock, timeout, [this] { return state->done; });
+        }
+
+        // Waits for the result and returns it, or rethrows what the operation
+        // threw.
+        R get() {
+            wait();
+            auto finished = std::move(state);
+            if (finished->error)
+                std::rethrow_exception(finished->error);
+            return std::move(*finished->value);
+        }
+
+        // Asks the operation to stop. Returns false when it had already
+        // finished, in which case its result stays available.
+        bool cancel() {
+            if (!state)
+                throw std::logic_error("The future has no result");
+            std::lock_guard lock{state->mutex};
+            if (state->done)
+                return false;
+            state->stop.request_stop();
+            return true;
+        }
+
+        // Calls callback once the result is ready, on the worker thread that
+        // finished it or on the calling thread when it already is. Meant for
+        // waking up an event loop, which then calls get().
+        void on_ready(std::function<void()> callback) {
+            if (!state)
+                throw std::logic_error("The future has no result");
+            if (!state->try_then(callback))
+                callback();
+        }
+
+        awaiter operator co_await() { return awaiter{*this}; }
+    };
+
+    namespace m_async {
+
+        // Starts work(context) on the pool and returns the future of its
+        // result.
+        template <typename F>
+        auto launch(async_options options, F work) {
+            using result_type = std::invoke_result_t<F&, const context&>;
+            auto state = std::make_shared<shared_state<result_type>>();
+
+            m_parallel::thread_pool::instance().submit(
+                [state, options = std::move(options), work = std::move(work)]() mutable {
+                    try {
+                        context ctx{state->stop, options};
+                        ctx.check();
+                        state->value.emplace(work(ctx));
+                    } catch (...) {
+                        state->error = std::current_exception();
+                    }
+                    state->finish();
+                });
+            return matrix_future<result_type>{std::move(state)};
+        }
+
+        // a * b one row panel at a time, reporting progress between lo and hi.
+        template <expression T>
+        matrix_base<T> multiply(const matrix_base<T>& a,
+                                const matrix_base<T>& b,
+                                const context& ctx,
+                                double lo = 0.0,
+                                double hi = 1.0) {
+            const size_t m = a.size_row(), k = a.size_col(), n = b.size_col();
+            m_stats::scope stats{operation::multiply, 2 * m * n * k, m * n};
+            m_trace::scope<T> trace{operation::multiply, m, n, k};
+            matrix_base<T> result{m, n};
+
+            // Enough rows per panel to keep the pool busy, and no more than 64
+            // panels so checking and reporting stay cheap
+            const size_t concurrency = m_parallel::thread_pool::instance().concurrency();
+            const size_t panel = std::max((m + 63) / 64, m_kernel::gemm_tuning<T>().block_m * concurrency);
+            const T* a_data = a.raw_data();
+            const T* b_data = b.raw_data();
+            T* c_data = result.raw_data();
+            for (size_t row = 0; row < m; row += panel) {
+                ctx.check();
+                const size_t rows = std::min(panel, m - row);
+                m_kernel::gemm(rows, n, k, a_data + row * k, k, 1, b_data, n, c_data + row * n, n);
+                ctx.report(lo + (hi - lo) * static_cast<double>(row + rows) / static_cast<double>(m));
+            }
+            return result;
+        }
+    }  // namespace m_async
+
+    // a * b. Throws like operator* when the shapes do not match.
+    template <expression T>
+    matrix_future<matrix_base<T>> async_multiply(matrix_base<T> a, matrix_base<T> b, async_options options = {}) {
+        if (a.is_empty() || b.is_empty())
+            throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+        if (a.size_col() != b.size_row())
+            throw std::domain_error("Matrix a must have the same number of columns as there are rows in matrix b");
+
+        return m_async::launch(std::move(options),
+                               [a = std::move(a), b = std::move(b)](const m_async::context& ctx) {
+                                   return m_async::multiply(std::as_const(a), std::as_const(b), ctx);
+                               });
+    }
+
+    // a ^ power by repeated squaring, each multiply being one step of the
+    // progress.
+    template <expression T, std::integral I>
+    matrix_future<matrix_base<T>> async_power(matrix_base<T> a, I power, async_options options = {}) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to raise it to a power.");
+        if (power < 0)
+            throw std::invalid_argument("Power cannot be less than 1");
+
+        return m_async::launch(std::move(options), [a = std::move(a), power](const m_async::context& ctx) {
+            if (power == 0) {
+                ctx.report(1.0);
+                return make_identity_matrix<T>(a.size_row());
+            }
+            m_stats::scope stats{operation::power, 0, a.size_row() * a.size_col()};
+            m_trace::scope<T> trace{operation::power, a.size_row(), a.size_col()};
+
+            using unsigned_type = std::make_unsigned_t<I>;
+            size_t steps = 0;
+            for (unsigned_type left = static_cast<unsigned_type>(power) - 1; left > 0; left >>= 1)
+                steps += (left & 1) + (left > 1);
+
+            matrix_base<T> result = a, base = a;
+            size_t step = 0;
+            auto multiply = [&](const matrix_base<T>& x, const matrix_base<T>& y) {
+                const double lo = static_cast<double>(step) / static_cast<double>(steps);
+                ++step;
+                return m_async::multiply(x, y, ctx, lo, static_cast<double>(step) / static_cast<double>(steps));
+            };
+            for (unsigned_type left = static_cast<unsigned_type>(power) - 1; left > 0;) {
+                if (left & 1)
+                    result = multiply(std::as_const(result), std::as_const(base));
+                left >>= 1;
+                if (left > 0)
+                    base = multiply(std::as_const(base), std::as_const(base));
+            }
+            if (steps == 0)
+                ctx.report(1.0);
+            return result;
+        });
+    }
+
+    template <expression T>
+    matrix_future<matrix_base<T>> async_transpose(matrix_base<T> a, async_options options = {}) {
+        return m_async::launch(std::move(options), [a = std::move(a)](const m_async::context& ctx) {
+            matrix_base<T> result = a.transpose();
+            ctx.report(1.0);
+            return result;
+        });
+    }
+
+    // x solving A x = b by LU factorization with partial pivoting. Progress
+    // follows the flops of the factorization, checked after every panel.
+    template <std::floating_point T>
+    matrix_future<std::vector<T>> async_lu_solve(matrix_base<T> a, std::vector<T> b, async_options options = {}) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to solve a linear system");
+        if (a.size_row() != b.size())
+            throw std::domain_error("The right hand side must have as many entries as the matrix has rows");
+
+        return m_async::launch(std::move(options),
+                               [a = std::move(a), b = std::move(b)](const m_async::context& ctx) mutable {
+                                   const size_t n = a.size_row();
+                                   const T* values = std::as_const(a).raw_data();
+                                   std::vector<T> lu(values, values + n * n);
+                                   std::vector<size_t> pivots(n);
+                                   m_kernel::lu_factor(n, lu.data(), n, pivots.data(), [&](size_t done) {
+                                       const double left = static_cast<double>(n - done) / static_cast<double>(n);
+                                       ctx.report(1.0 - left * left * left);
+                                       if (done < n)
+                                           ctx.check();
+                                   });
+                                   m_kernel::lu_solve(n, lu.data(), n, pivots.data(), b.data());
+                                   return std::move(b);
+                               });
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_ASYNC_HPP
@@ -0,0 +1,378 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_BANDED_HPP
+#define MMATH_MMATH_BANDED_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mmath_concepts.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    /*
+     * TRIDIAGONAL
+     */
+
+    // Square tridiagonal matrix stored as its three diagonals. lower[i] is the
+    // entry below diag[i], upper[i] the entry to the right of diag[i].
+    template <expression T>
+    class tridiagonal_matrix {
+      private:
+        std::vector<T> lower_diag, main_diag, upper_diag;
+
+      public:
+        tridiagonal_matrix() = default;
+
+        explicit tridiagonal_matrix(size_t size)
+            : lower_diag(size > 0 ? size - 1 : 0, T{}), main_diag(size, T{}), upper_diag(size > 0 ? size - 1 : 0, T{}) {}
+
+        tridiagonal_matrix(std::vector<T> lower, std::vector<T> diag, std::vector<T> upper)
+            : lower_diag(std::move(lower)), main_diag(std::move(diag)), upper_diag(std::move(upper)) {
+            size_t off_size = main_diag.empty() ? 0 : main_diag.size() - 1;
+            if (lower_diag.size() != off_size || upper_diag.size() != off_size)
+                throw std::invalid_argument("The off diagonals must have one less entry than the diagonal");
+        }
+
+        [[nodiscard]] size_t size() const { return main_diag.size(); }
+
+        std::vector<T>& lower() { return lower_diag; }
+        std::vector<T>& diagonal() { return main_diag; }
+        std::vector<T>& upper() { return upper_diag; }
+
+        [[nodiscard]] const std::vector<T>& lower() const { return lower_diag; }
+        [[nodiscard]] const std::vector<T>& diagonal() const { return main_diag; }
+        [[nodiscard]] const std::vector<T>& upper() const { return upper_diag; }
+
+        // 1-indexed like matrix_base, entries outside the band read as zero.
+        T operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > size() || column > size())
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            if (row == column)
+                return main_diag[row - 1];
+            if (row == column + 1)
+                return lower_diag[column - 1];
+            if (column == row + 1)
+                return upper_diag[row - 1];
+            return T{};
+        }
+
+        [[nodiscard]] std::vector<T> multiply(const std::vector<T>& x) const {
+            if (x.size() != size())
+                throw std::domain_error("Vector must have as many entries as the matrix has columns");
+
+            size_t n = size();
+            std::vector<T> y(n);
+            for (size_t i = 0; i < n; ++i) {
+                T sum = main_diag[i] * x[i];
+                if (i > 0)
+                    sum = sum + lower_diag[i - 1] * x[i - 1];
+                if (i + 1 < n)
+                    sum = sum + upper_diag[i] * x[i + 1];
+                y[i] = sum;
+            }
+            return y;
+        }
+    };
+
+    // Solves A x = d with the Thomas algorithm in O(n). No pivoting is done, so
+    // A should be diagonally dominant or otherwise known to be stable.
+    template <expression T>
+    std::vector<T> thomas_solve(const tridiagonal_matrix<T>& a, std::vector<T> d) {
+        size_t n = a.size();
+        if (d.size() != n)
+            throw std::domain_error("The right hand side must have as many entries as the matrix has rows");
+        if (n == 0)
+            return d;
+
+        const auto& lower = a.lower();
+        const auto& diag = a.diagonal();
+        const auto& upper = a.upper();
+
+        std::vector<T> c_prime(n);
+
+        // Forward sweep
+        T denominator = diag[0];
+        if (denominator == 0)
+            throw std::domain_error("Zero pivot encountered in the Thomas algorithm");
+        if (n > 1)
+            c_prime[0] = upper[0] / denominator;
+        d[0] = d[0] / denominator;
+
+        for (size_t i = 1; i < n; ++i) {
+            denominator = diag[i] - lower[i - 1] * c_prime[i - 1];
+            if (denominator == 0)
+                throw std::domain_error("Zero pivot encountered in the Thomas algorithm");
+            if (i + 1 < n)
+                c_prime[i] = upper[i] / denominator;
+            d[i] = (d[i] - lower[i - 1] * d[i - 1]) / denominator;
+        }
+
+        // Back substitution
+        for (size_t i = n - 1; i > 0; --i)
+            d[i - 1] = d[i - 1] - c_prime[i - 1] * d[i];
+
+        return d;
+    }
+
+    /*
+     * BATCHED TRIDIAGONAL
+     */
+
+    // Many independent tridiagonal systems of the same size. Entries are
+    // interleaved by system, (system, row) lives at [row * batch_size + system],
+    // so the solve sweeps every system in lock step with unit stride loops that
+    // vectorize across systems. Accessors are 0-indexed.
+    template <std::floating_point T>
+    class tridiagonal_batch {
+      private:
+        size_t system_size, batch_size;
+        std::vector<T> lower_diag, main_diag, upper_diag, rhs, scratch;
+
+        [[nodiscard]] size_t index(size_t system, size_t row) const {
+            if (system >= batch_size || row >= system_size)
+                throw std::out_of_range("Requested element lies outside of the batch.");
+            return row * batch_size + system;
+        }
+
+      public:
+        tridiagonal_batch(size_t system_size, size_t batch_size)
+            : system_size(system_size)
+            , batch_size(batch_size)
+            , lower_diag(system_size * batch_size, T{})
+            , main_diag(system_size * batch_size, T{})
+            , upper_diag(system_size * batch_size, T{})
+            , rhs(system_size * batch_size, T{})
+            , scratch(system_size * batch_size, T{}) {}
+
+        [[nodiscard]] size_t size() const { return system_size; }
+
+        [[nodiscard]] size_t count() const { return batch_size; }
+
+        // lower(system, 0) and upper(system, size() - 1) are ignored.
+        T& lower(size_t system, size_t row) { return lower_diag[index(system, row)]; }
+        T& diagonal(size_t system, size_t row) { return main_diag[index(system, row)]; }
+        T& upper(size_t system, size_t row) { return upper_diag[index(system, row)]; }
+        T& right_hand_side(size_t system, size_t row) { return rhs[index(system, row)]; }
+
+        // Valid after solve(), the solution overwrites the right hand side.
+        [[nodiscard]] T solution(size_t system, size_t row) const { return rhs[index(system, row)]; }
+
+        // Solves every system in place. The coefficient arrays are left untouched
+        // so the batch can be re-solved with new right hand sides.
+        void solve() {
+            if (system_size == 0 || batch_size == 0)
+                return;
+
+            const size_t n = system_size, stride = batch_size;
+            const T* a = lower_diag.data();
+            const T* b = main_diag.data();
+            const T* c = upper_diag.data();
+            T* d = rhs.data();
+            T* cp = scratch.data();
+
+            auto solve_range = [&](size_t lo, size_t hi) {
+                bool singular = false;
+
+                for (size_t s = lo; s < hi; ++s) {
+                    singular |= static_cast<bool>(b[s] == 0);
+                    cp[s] = c[s] / b[s];
+                    d[s] = d[s] / b[s];
+                }
+
+                for (size_t i = 1; i < n; ++i) {
+                    const size_t row = i * stride, prev = row - stride;
+                    for (size_t s = lo; s < hi; ++s) {
+                        T denominator = b[row + s] - a[row + s] * cp[prev + s];
+                        singular |= static_cast<bool>(denominator == 0);
+                        cp[row + s] = c[row + s] / denominator;
+                        d[row + s] = (d[row + s] - a[row + s] * d[prev + s]) / denominator;
+                    }
+                }
+
+                for (size_t i = n - 1; i > 0; --i) {
+                    const size_t row = i * stride, prev = row - stride;
+                    for (size_t s = lo; s < hi; ++s)
+                        d[prev + s] = d[prev + s] - cp[prev + s] * d[row + s];
+                }
+
+                if (singular)
+                    throw std::domain_error("Zero pivot encountered in the Thomas algorithm");
+            };
+
+            // Chunks are kept wide enough to fill several vector registers.
+            constexpr size_t grain = 256;
+            m_parallel::parallel_for(0, batch_size, grain, solve_range);
+        }
+    };
+
+    /*
+     * BANDED
+     */
+
+    // Square matrix with kl sub-diagonals and ku super-diagonals, stored by row
+    // with kl + ku + 1 entries per row: (i, j) lives at [i * width + j - i + kl].
+    template <expression T>
+    class banded_matrix {
+      private:
+        size_t num_row, num_lower, num_upper;
+        std::vector<T> band;
+
+        [[nodiscard]] size_t width() const { return num_lower + num_upper + 1; }
+
+        [[nodiscard]] bool in_band(size_t row, size_t column) const {
+            return column + num_lower >= row && column <= row + num_upper;
+        }
+
+      public:
+        banded_matrix(size_t size, size_t lower_bandwidth, size_t upper_bandwidth)
+            : num_row(size)
+            , num_lower(lower_bandwidth)
+            , num_upper(upper_bandwidth)
+            , band(size * (lower_bandwidth + upper_bandwidth + 1), T{}) {}
+
+        [[nodiscard]] size_t size() const { return num_row; }
+
+        [[nodiscard]] size_t lower_bandwidth() const { return num_lower; }
+
+        [[nodiscard]] size_t upper_bandwidth() const { return num_upper; }
+
+        [[nodiscard]] const T* raw_data() const { return band.data(); }
+
+        // 1-indexed like matrix_base, entries outside the band read as zero.
+        T operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_row)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            if (!in_band(row - 1, column - 1))
+                return T{};
+            return band[(row - 1) * width() + column - row + num_lower];
+        }
+
+        T& operator()(size_t row, size_t column) {
+            if (row == 0 || column == 0 || row > num_row || column > num_row)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            if (!in_band(row - 1, column - 1))
+                throw std::out_of_range("Requested element lies outside of the band.");
+            return band[(row - 1) * width() + column - row + num_lower];
+        }
+
+        [[nodiscard]] std::vector<T> multiply(const std::vector<T>& x) const {
+            if (x.size() != num_row)
+                throw std::domain_error("Vector must have as many entries as the matrix has columns");
+
+            std::vector<T> y(num_row);
+            for (size_t i = 0; i < num_row; ++i) {
+                size_t j_begin = i > num_lower ? i - num_lower : 0;
+                size_t j_end = std::min(num_row, i + num_upper + 1);
+                const T* row = band.data() + i * width() + num_lower - i;
+                T sum = T{};
+                for (size_t j = j_begin; j < j_end; ++j)
+                    sum = sum + row[j] * x[j];
+                y[i] = sum;
+            }
+            return y;
+        }
+    };
+
+    // LU factorization of a banded matrix with partial pivoting. Row exchanges
+    // widen U to kl + ku super-diagonals, which the factor stores explicitly.
+    template <std::floating_point T>
+    class banded_lu {
+      private:
+        size_t n, kl, ku;  // ku here is the widened upper bandwidth
+        std::vector<T> factors;
+        std::vector<size_t> pivots;
+
+        [[nodiscard]] size_t width() const { return kl + ku + 1; }
+
+        T& at(size_t i, size_t j) { return factors[i * width() + j + kl - i]; }
+
+        [[nodiscard]] const T& at(size_t i, size_t j) const { return factors[i * width() + j + kl - i]; }
+
+      public:
+        explicit banded_lu(const banded_matrix<T>& a)
+            : n(a.size())
+            , kl(a.lower_bandwidth())
+            , ku(a.lower_bandwidth() + a.upper_bandwidth())
+            , factors(a.size() * (2 * a.lower_bandwidth() + a.upper_bandwidth() + 1), T{})
+            , pivots(a.size()) {
+            const size_t in_width = a.lower_bandwidth() + a.upper_bandwidth() + 1;
+            for (size_t i = 0; i < n; ++i)
+                std::copy_n(a.raw_data() + i * in_width, in_width, factors.data() + i * width());
+
+            // O(n * kl * (kl + ku)) elimination confined to the band
+            for (size_t k = 0; k < n; ++k) {
+                size_t last_row = std::min(n - 1, k + kl);
+                size_t last_col = std::min(n - 1, k + ku);
+
+                size_t pivot = k;
+                for (size_t r = k + 1; r <= last_row; ++r) {
+                    if (std::abs(at(r, k)) > std::abs(at(pivot, k)))
+                        pivot = r;
+                }
+                pivots[k] = pivot;
+
+                if (at(pivot, k) == 0)
+                    throw std::domain_error("Banded matrix is singular");
+
+                if (pivot != k) {
+                    for (size_t j = k; j <= last_col; ++j)
+                        std::swap(at(k, j), at(pivot, j));
+                }
+
+                const T pivot_value = at(k, k);
+                for (size_t r = k + 1; r <= last_row; ++r) {
+                    T multiplier = at(r, k) / pivot_value;
+                    at(r, k) = multiplier;
+                    if (multiplier == 0)
+                        continue;
+                    for (size_t j = k + 1; j <= last_col; ++j)
+                        at(r, j) -= multiplier * at(k, j);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return n; }
+
+        // Solves A x = b using the stored factors in O(n * (kl + ku)).
+        [[nodiscard]] std::vector<T> solve(std::vector<T> b) const {
+            if (b.size() != n)
+                throw std::domain_error("The right hand side must have as many entries as the matrix has rows");
+
+            // Apply the row exchanges and L in the order they happened
+            for (size_t k = 0; k < n; ++k) {
+                if (pivots[k] != k)
+                    std::swap(b[k], b[pivots[k]]);
+                size_t last_row = std::min(n - 1, k + kl);
+                for (size_t r = k + 1; r <= last_row; ++r)
+                    b[r] -= at(r, k) * b[k];
+            }
+
+            for (size_t i = n; i > 0; --i) {
+                size_t row = i - 1;
+                size_t last_col = std::min(n - 1, row + ku);
+                T sum = b[row];
+                for (size_t j = row + 1; j <= last_col; ++j)
+                    sum -= at(row, j) * b[j];
+                b[row] = sum / at(row, row);
+            }
+
+            return b;
+        }
+    };
+
+    template <std::floating_point T>
+    std::vector<T> banded_solve(const banded_matrix<T>& a, std::vector<T> b) {
+        return banded_lu<T>{a}.solve(std::move(b));
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_BANDED_HPP
@@ -0,0 +1,346 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_BATCH_HPP
+#define MMATH_MMATH_BATCH_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    namespace m_batch {
+
+        // Lanes handled per task, and per inner block so every plane touched by
+        // a kernel stays in L1/L2 while the block is processed.
+        constexpr size_t parallel_grain = 4096;
+        constexpr size_t block = 256;
+
+        // Planes are padded to a multiple of this many lanes.
+        constexpr size_t lane_padding = 16;
+
+        inline size_t padded(size_t count) { return (count + lane_padding - 1) / lane_padding * lane_padding; }
+
+        // Runs body(lo, hi) over [0, count) in blocks, spread over the pool once
+        // there are enough lanes.
+        template <typename F>
+        void for_lanes(size_t count, F&& body) {
+            auto blocks = [&](size_t lo, size_t hi) {
+                for (size_t b = lo; b < hi; b += block)
+                    body(b, std::min(hi, b + block));
+            };
+            if (count <= parallel_grain)
+                blocks(0, count);
+            else
+                m_parallel::parallel_for(0, count, parallel_grain, blocks);
+        }
+
+        // Closed form determinants on a single matrix held in registers. The
+        // batched kernels call these once per lane inside a loop over lanes, which
+        // the compiler vectorizes across matrices.
+        template <typename T, size_t N>
+        T determinant(const T (&a)[N][N]) {
+            if constexpr (N == 1) {
+                return a[0][0];
+            } else if constexpr (N == 2) {
+                return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+            } else if constexpr (N == 3) {
+                return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+                       a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+                       a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+            } else {
+                T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+                T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+                T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+                T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+                T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+                T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+                T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+                T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+                T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+                T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+                T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+                T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+                return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+        }
+
+        // Adjugate divided by the determinant, which is returned.
+        template <typename T, size_t N>
+        T inverse(const T (&a)[N][N], T (&b)[N][N]) {
+            T det;
+            if constexpr (N == 1) {
+                det = a[0][0];
+                b[0][0] = T{1};
+            } else if constexpr (N == 2) {
+                det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+                b[0][0] = a[1][1];
+                b[0][1] = -a[0][1];
+                b[1][0] = -a[1][0];
+                b[1][1] = a[0][0];
+            } else if constexpr (N == 3) {
+                b[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+                b[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+                b[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+                b[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+                b[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+                b[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+                b[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+                b[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+                b[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+                det = a[0][0] * b[0][0] + a[0][1] * b[1][0] + a[0][2] * b[2][0];
+            } else {
+                T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+                T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+                T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+                T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+                T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+                T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+                T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+                T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+                T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+                T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+                T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+                T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+                det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+                b[0][0] = a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+                b[0][1] = -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3;
+                b[0][2] = a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+                b[0][3] = -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3;
+                b[1][0] = -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1;
+                b[1][1] = a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+                b[1][2] = -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1;
+                b[1][3] = a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+                b[2][0] = a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+                b[2][1] = -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0;
+                b[2][2] = a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+                b[2][3] = -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0;
+                b[3][0] = -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0;
+                b[3][1] = a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+                b[3][2] = -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0;
+                b[3][3] = a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+            }
+
+            T scale = T{1} / det;
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                    b[r][c] = b[r][c] * scale;
+            return det;
+        }
+    }  // namespace m_batch
+
+    // N independent R x C matrices stored structure of arrays: element (r, c)
+    // of every matrix is contiguous, so a kernel processes one matrix per SIMD
+    // lane. Matrices are indexed from 0 like a container, elements from 1 like
+    // matrix_base.
+    template <numeric T, size_t R, size_t C>
+        requires(R > 0 && C > 0)
+    class matrix_batch {
+      private:
+        size_t count;
+        size_t stride;
+        std::vector<T> data;
+
+      public:
+        explicit matrix_batch(size_t count = 0)
+            : count(count), stride(m_batch::padded(count)), data(R * C * m_batch::padded(count)) {}
+
+        [[nodiscard]] size_t size() const { return count; }
+
+        [[nodiscard]] static constexpr size_t size_row() { return R; }
+
+        [[nodiscard]] static constexpr size_t size_col() { return C; }
+
+        // The contiguous values of element (row, column) across the batch.
+        [[nodiscard]] T* plane(size_t row, size_t column) { return data.data() + ((row - 1) * C + (column - 1)) * stride; }
+
+        [[nodiscard]] const T* plane(size_t row, size_t column) const {
+            return data.data() + ((row - 1) * C + (column - 1)) * stride;
+        }
+
+        T& operator()(size_t index, size_t row, size_t column) {
+            if (index >= count || row == 0 || column == 0 || row > R || column > C)
+                throw std::out_of_range("Requested element lies outside of the batch.");
+            return plane(row, column)[index];
+        }
+
+        const T& operator()(size_t index, size_t row, size_t column) const {
+            if (index >= count || row == 0 || column == 0 || row > R || column > C)
+                throw std::out_of_range("Requested element lies outside of the batch.");
+            return plane(row, column)[index];
+        }
+
+        [[nodiscard]] matrix_base<T> get(size_t index) const {
+            if (index >= count)
+                throw std::out_of_range("Requested matrix lies outside of the batch.");
+            matrix_base<T> result{R, C, for_overwrite};
+            T* out = result.raw_data();
+            for (size_t e = 0; e < R * C; ++e)
+                out[e] = data[e * stride + index];
+            return result;
+        }
+
+        void set(size_t index, const matrix_base<T>& matrix) {
+            if (index >= count)
+                throw std::out_of_range("Requested matrix lies outside of the batch.");
+            if (matrix.size_row() != R || matrix.size_col() != C)
+                throw std::domain_error("Matrix shape does not match the batch");
+            const T* in = matrix.raw_data();
+            for (size_t e = 0; e < R * C; ++e)
+                data[e * stride + index] = in[e];
+        }
+
+        matrix_batch operator+(const matrix_batch& b) const {
+            if (count != b.count)
+                throw std::domain_error("Batches must hold the same number of matrices");
+            matrix_batch result{count};
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] = data[i] + b.data[i];
+            return result;
+        }
+
+        matrix_batch operator-(const matrix_batch& b) const {
+            if (count != b.count)
+                throw std::domain_error("Batches must hold the same number of matrices");
+            matrix_batch result{count};
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] = data[i] - b.data[i];
+            return result;
+        }
+
+        bool operator==(const matrix_batch& b) const {
+            if (count != b.count)
+                return false;
+            for (size_t e = 0; e < R * C; ++e) {
+                if (!std::equal(data.begin() + e * stride, data.begin() + e * stride + count,
+                                b.data.begin() + e * b.stride))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    // Every product A_k * B_k. The inner loop runs over matrices, so each
+    // multiply-add is a full vector of independent lanes.
+    template <numeric T, size_t R, size_t K, size_t C>
+    matrix_batch<T, R, C> operator*(const matrix_batch<T, R, K>& a, const matrix_batch<T, K, C>& b) {
+        if (a.size() != b.size())
+            throw std::domain_error("Batches must hold the same number of matrices");
+
+        matrix_batch<T, R, C> result{a.size()};
+        m_batch::for_lanes(a.size(), [&](size_t lo, size_t hi) {
+            for (size_t r = 1; r <= R; ++r) {
+                for (size_t c = 1; c <= C; ++c) {
+                    const T* x[K];
+                    const T* y[K];
+                    for (size_t p = 0; p < K; ++p) {
+                        x[p] = a.plane(r, p + 1);
+                        y[p] = b.plane(p + 1, c);
+                    }
+
+                    T* out = result.plane(r, c);
+                    for (size_t k = lo; k < hi; ++k) {
+                        T sum = x[0][k] * y[0][k];
+                        for (size_t p = 1; p < K; ++p)
+                            sum = sum + x[p][k] * y[p][k];
+                        out[k] = sum;
+                    }
+                }
+            }
+        });
+        return result;
+    }
+
+    template <numeric T, size_t R, size_t C>
+    matrix_batch<T, C, R> transpose(const matrix_batch<T, R, C>& batch) {
+        matrix_batch<T, C, R> result{batch.size()};
+        for (size_t r = 1; r <= R; ++r) {
+            for (size_t c = 1; c <= C; ++c)
+                std::copy_n(batch.plane(r, c), batch.size(), result.plane(c, r));
+        }
+        return result;
+    }
+
+    template <numeric T, size_t N>
+    std::vector<T> trace(const matrix_batch<T, N, N>& batch) {
+        std::vector<T> result(batch.size(), T{});
+        m_batch::for_lanes(batch.size(), [&](size_t lo, size_t hi) {
+            for (size_t d = 1; d <= N; ++d) {
+                const T* x = batch.plane(d, d);
+                for (size_t k = lo; k < hi; ++k)
+                    result[k] = result[k] + x[k];
+            }
+        });
+        return result;
+    }
+
+    // Closed form, so limited to 4 x 4.
+    template <numeric T, size_t N>
+        requires(N <= 4)
+    std::vector<T> determinant(const matrix_batch<T, N, N>& batch) {
+        std::vector<T> result(batch.size());
+        m_batch::for_lanes(batch.size(), [&](size_t lo, size_t hi) {
+            const T* planes[N][N];
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                    planes[r][c] = batch.plane(r + 1, c + 1);
+
+            for (size_t k = lo; k < hi; ++k) {
+                T a[N][N];
+                for (size_t r = 0; r < N; ++r)
+                    for (size_t c = 0; c < N; ++c)
+                        a[r][c] = planes[r][c][k];
+                result[k] = m_batch::determinant(a);
+            }
+        });
+        return result;
+    }
+
+    // Closed form adjugate inverse, limited to 4 x 4. Throws when any matrix in
+    // the batch is singular.
+    template <std::floating_point T, size_t N>
+        requires(N <= 4)
+    matrix_batch<T, N, N> inverse(const matrix_batch<T, N, N>& batch) {
+        matrix_batch<T, N, N> result{batch.size()};
+        std::vector<T> determinants(batch.size());
+
+        m_batch::for_lanes(batch.size(), [&](size_t lo, size_t hi) {
+            const T* in[N][N];
+            T* out[N][N];
+            for (size_t r = 0; r < N; ++r) {
+                for (size_t c = 0; c < N; ++c) {
+                    in[r][c] = batch.plane(r + 1, c + 1);
+                    out[r][c] = result.plane(r + 1, c + 1);
+                }
+            }
+
+            for (size_t k = lo; k < hi; ++k) {
+                T a[N][N], b[N][N];
+                for (size_t r = 0; r < N; ++r)
+                    for (size_t c = 0; c < N; ++c)
+                        a[r][c] = in[r][c][k];
+                determinants[k] = m_batch::inverse(a, b);
+                for (size_t r = 0; r < N; ++r)
+                    for (size_t c = 0; c < N; ++c)
+                        out[r][c][k] = b[r][c];
+            }
+        });
+
+        auto singular = std::find(determinants.begin(), determinants.end(), T{});
+        if (singular != determinants.end())
+            throw std::domain_error("Matrix " + std::to_string(singular - determinants.begin()) +
+                                    " of the batch is singular");
+        return result;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_BATCH_HPP
@@ -0,0 +1,342 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_BINARY_HPP
+#define MMATH_MMATH_BINARY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mmath.hpp"
+
+namespace mmath {
+
+    /*
+     * FORMAT
+     *
+     * A fixed 64 byte header followed by the raw row major elements starting at
+     * data_offset, which is a multiple of the alignment recorded in the header.
+     * All fields are in native byte order.
+     */
+
+    template <typename T>
+    concept binary_element = numeric<T> || std::same_as<T, char8_t> || std::same_as<T, char16_t> ||
+                             std::same_as<T, char32_t> || std::same_as<T, wchar_t>;
+
+    enum class binary_layout : uint32_t { ROW_MAJOR = 0, COLUMN_MAJOR = 1 };
+
+    struct binary_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t element_type;
+        uint32_t layout;
+        uint32_t alignment;
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t data_offset;
+        uint64_t data_bytes;
+        uint64_t checksum;
+    };
+
+    static_assert(sizeof(binary_header) == 64, "The binary header must stay 64 bytes");
+
+    namespace m_binary {
+
+        constexpr char magic[8] = {'M', 'M', 'A', 'T', 'H', 'B', 'I', 'N'};
+        constexpr uint32_t version = 1;
+        constexpr uint32_t default_alignment = 64;
+
+        // (kind << 8) | sizeof(T), where kind is 1 signed, 2 unsigned, 3 floating.
+        template <binary_element T>
+        constexpr uint32_t element_type_code() {
+            uint32_t kind = std::is_floating_point_v<T> ? 3 : (std::is_signed_v<T> ? 1 : 2);
+            return (kind << 8) | static_cast<uint32_t>(sizeof(T));
+        }
+
+        // Four independent multiply-rotate lanes so the checksum runs at memory
+        // speed instead of byte at a time.
+        inline uint64_t checksum(const void* data, size_t size) {
+            constexpr uint64_t prime_1 = 0x9E3779B185EBCA87ull;
+            constexpr uint64_t prime_2 = 0xC2B2AE3D27D4EB4Full;
+            auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            uint64_t lanes[4] = {prime_1, prime_2, prime_1 ^ prime_2, ~prime_1};
+
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    uint64_t word;
+                    std::memcpy(&word, bytes + i + lane * 8, 8);
+                    lanes[lane] = rotl(lanes[lane] ^ (word * prime_2), 31) * prime_1;
+                }
+            }
+
+            uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+            for (; i < size; ++i)
+                hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+
+            hash ^= static_cast<uint64_t>(size);
+            hash ^= hash >> 33;
+            hash *= prime_2;
+            hash ^= hash >> 29;
+            return hash;
+        }
+
+        inline uint64_t align_up(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        template <binary_element T>
+        binary_header make_header(size_t rows, size_t cols, const T* data, uint32_t alignment) {
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment % alignof(T) != 0)
+                throw std::invalid_argument("Alignment must be a power of two multiple of the element alignment");
+
+            binary_header header{};
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = version;
+            header.element_type = element_type_code<T>();
+            header.layout = static_cast<uint32_t>(binary_layout::ROW_MAJOR);
+            header.alignment = alignment;
+            header.rows = rows;
+            header.cols = cols;
+            header.data_offset = align_up(sizeof(binary_header), alignment);
+            header.data_bytes = rows * cols * sizeof(T);
+            header.checksum = checksum(data, header.data_bytes);
+            return header;
+        }
+
+        // Checks a header read from a file of file_size bytes. The header is
+        // untrusted, so sizes are computed with overflow checks and the data
+        // must be aligned for T.
+        template <binary_element T>
+        void validate_header(const binary_header& header, uint64_t file_size) {
+            if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+                throw std::runtime_error("Not an mmath binary matrix file");
+            if (header.version != version)
+                throw std::runtime_error("Unsupported mmath binary matrix version");
+            if (header.element_type != element_type_code<T>())
+                throw std::runtime_error("Binary matrix element type does not match the requested type");
+            if (header.layout != static_cast<uint32_t>(binary_layout::ROW_MAJOR))
+                throw std::runtime_error("Only row major binary matrices are supported");
+            uint64_t elements = 0, bytes = 0, end = 0;
+            if (__builtin_mul_overflow(header.rows, header.cols, &elements) ||
+                __builtin_mul_overflow(elements, uint64_t{sizeof(T)}, &bytes) || header.data_bytes != bytes ||
+                header.data_offset < sizeof(header) ||
+                __builtin_add_overflow(header.data_offset, header.data_bytes, &end) || end > file_size)
+                throw std::runtime_error("Binary matrix file is truncated or inconsistent");
+            if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0 ||
+                header.data_offset % header.alignment != 0 || header.data_offset % alignof(T) != 0)
+                throw std::runtime_error("Binary matrix data is misaligned");
+        }
+
+        inline void throw_errno(const std::string& what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        // Owns a file descriptor for the lifetime of a read or write.
+        class file_handle {
+            int fd;
+
+          public:
+            file_handle(const std::string& path, int flags, mode_t mode = 0644) : fd(::open(path.c_str(), flags, mode)) {
+                if (fd < 0)
+                    throw_errno("Unable to open " + path);
+            }
+
+            file_handle(const file_handle&) = delete;
+            file_handle& operator=(const file_handle&) = delete;
+
+            ~file_handle() { ::close(fd); }
+
+            [[nodiscard]] int get() const { return fd; }
+        };
+    }  // namespace m_binary
+
+    /*
+     * STREAMING
+     */
+
+    template <binary_element T>
+    void write_binary(std::ostream& os,
+                      const matrix_base<T>& matrix,
+                      uint32_t alignment = m_binary::default_alignment) {
+        binary_header header = m_binary::make_header(matrix.size_row(), matrix.size_col(), matrix.raw_data(), alignment);
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<char> padding(header.data_offset - sizeof(header), 0);
+        os.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        os.write(reinterpret_cast<const char*>(matrix.raw_data()), static_cast<std::streamsize>(header.data_bytes));
+
+        if (!os)
+            throw std::runtime_error("Failed writing binary matrix");
+    }
+
+    template <binary_element T>
+    matrix_base<T> read_binary(std::istream& is, bool verify_checksum = true) {
+        binary_header header{};
+        if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            throw std::runtime_error("Binary matrix file is truncated or inconsistent");
+
+        // Bound the header by what is left of a seekable stream, so a corrupt
+        // one is rejected before allocating for it
+        uint64_t available = std::numeric_limits<uint64_t>::max();
+        if (const std::streampos here = is.tellg(); here != std::streampos(-1)) {
+            is.seekg(0, std::ios::end);
+            const std::streampos end = is.tellg();
+            is.seekg(here);
+            if (end != std::streampos(-1) && end >= here)
+                available = sizeof(header) + static_cast<uint64_t>(end - here);
+        }
+        m_binary::validate_header<T>(header, available);
+
+        is.ignore(static_cast<std::streamsize>(header.data_offset - sizeof(header)));
+
+        matrix_base<T> result{header.rows, header.cols, for_overwrite};
+        if (!is.read(reinterpret_cast<char*>(result.raw_data()), static_cast<std::streamsize>(header.data_bytes)))
+            throw std::runtime_error("Binary matrix file is truncated or inconsistent");
+
+        if (verify_checksum && m_binary::checksum(result.raw_data(), header.data_bytes) != header.checksum)
+            throw std::runtime_error("Binary matrix checksum mismatch");
+
+        return result;
+    }
+
+    /*
+     * MEMORY MAPPED
+     */
+
+    // Writes the file by sizing it up front and copying straight into a shared
+    // mapping, so the data never passes through a user space stream buffer.
+    template <binary_element T>
+    void write_binary_mapped(const std::string& path,
+                             const matrix_base<T>& matrix,
+                             uint32_t alignment = m_binary::default_alignment) {
+        binary_header header = m_binary::make_header(matrix.size_row(), matrix.size_col(), matrix.raw_data(), alignment);
+        uint64_t file_size = header.data_offset + header.data_bytes;
+
+        m_binary::file_handle file{path, O_RDWR | O_CREAT | O_TRUNC};
+        if (::ftruncate(file.get(), static_cast<off_t>(file_size)) != 0)
+            m_binary::throw_errno("Unable to size " + path);
+
+        void* mapping = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, file.get(), 0);
+        if (mapping == MAP_FAILED)
+            m_binary::throw_errno("Unable to map " + path);
+
+        auto* bytes = static_cast<char*>(mapping);
+        std::memcpy(bytes, &header, sizeof(header));
+        std::memcpy(bytes + header.data_offset, matrix.raw_data(), header.data_bytes);
+
+        ::munmap(mapping, file_size);
+    }
+
+    // Read only, zero copy view of a binary matrix file. The elements are used
+    // in place from the page cache; nothing is parsed or copied on open.
+    template <binary_element T>
+    class mapped_matrix {
+      private:
+        void* mapping = nullptr;
+        size_t mapping_size = 0;
+        binary_header header{};
+
+        void release() {
+            if (mapping != nullptr)
+                ::munmap(mapping, mapping_size);
+            mapping = nullptr;
+            mapping_size = 0;
+        }
+
+      public:
+        explicit mapped_matrix(const std::string& path, bool verify_checksum = false) {
+            m_binary::file_handle file{path, O_RDONLY};
+
+            struct stat info {};
+            if (::fstat(file.get(), &info) != 0)
+                m_binary::throw_errno("Unable to stat " + path);
+            if (static_cast<uint64_t>(info.st_size) < sizeof(binary_header))
+                throw std::runtime_error("Binary matrix file is truncated or inconsistent");
+
+            mapping_size = static_cast<size_t>(info.st_size);
+            mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file.get(), 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                m_binary::throw_errno("Unable to map " + path);
+            }
+
+            try {
+                std::memcpy(&header, mapping, sizeof(header));
+                m_binary::validate_header<T>(header, mapping_size);
+                if (verify_checksum && m_binary::checksum(raw_data(), header.data_bytes) != header.checksum)
+                    throw std::runtime_error("Binary matrix checksum mismatch");
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        mapped_matrix(const mapped_matrix&) = delete;
+        mapped_matrix& operator=(const mapped_matrix&) = delete;
+
+        mapped_matrix(mapped_matrix&& other) noexcept
+            : mapping(std::exchange(other.mapping, nullptr))
+            , mapping_size(std::exchange(other.mapping_size, 0))
+            , header(other.header) {}
+
+        mapped_matrix& operator=(mapped_matrix&& other) noexcept {
+            if (this != &other) {
+                release();
+                mapping = std::exchange(other.mapping, nullptr);
+                mapping_size = std::exchange(other.mapping_size, 0);
+                header = other.header;
+            }
+            return *this;
+        }
+
+        ~mapped_matrix() { release(); }
+
+        [[nodiscard]] size_t size_row() const { return header.rows; }
+
+        [[nodiscard]] size_t size_col() const { return header.cols; }
+
+        [[nodiscard]] const T* raw_data() const {
+            return reinterpret_cast<const T*>(static_cast<const char*>(mapping) + header.data_offset);
+        }
+
+        [[nodiscard]] const binary_header& get_header() const { return header; }
+
+        // 1-indexed like matrix_base.
+        T operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > header.rows || column > header.cols)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            return raw_data()[header.cols * (row - 1) + (column - 1)];
+        }
+
+        // Hints the kernel to start paging the whole matrix in.
+        void prefetch() const { ::madvise(mapping, mapping_size, MADV_WILLNEED); }
+
+        [[nodiscard]] matrix_base<T> to_matrix() const {
+            matrix_base<T> result{header.rows, header.cols, for_overwrite};
+            std::memcpy(result.raw_data(), raw_data(), header.data_bytes);
+            return result;
+        }
+    };
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_BINARY_HPP
@@ -0,0 +1,364 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_BITMATRIX_HPP
+#define MMATH_MMATH_BITMATRIX_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    namespace m_bit {
+
+        using word = uint64_t;
+        constexpr size_t word_bits = 64;
+
+        inline size_t words_for(size_t bits) { return (bits + word_bits - 1) / word_bits; }
+
+        // Rows of B combined per Four Russians table, and words of columns per
+        // task so that the 2^table_bits entry table stays in L1/L2.
+        constexpr size_t table_bits = 8;
+        constexpr size_t column_words = 32;
+
+        // Minimum rows * words of work before a kernel is spread over the pool.
+        constexpr size_t parallel_threshold = size_t{1} << 16;
+
+        // In place transpose of a 64 x 64 bit block, bit j of word i moving to bit
+        // i of word j, by swapping progressively smaller off diagonal sub blocks.
+        inline void transpose_block(std::array<word, word_bits>& block) {
+            word mask = 0x00000000FFFFFFFFull;
+            for (size_t width = 32; width > 0; width >>= 1, mask ^= mask << width) {
+                for (size_t i = 0; i < word_bits; i = (i + width + 1) & ~width) {
+                    word swap = ((block[i] >> width) ^ block[i + width]) & mask;
+                    block[i] ^= swap << width;
+                    block[i + width] ^= swap;
+                }
+            }
+        }
+    }  // namespace m_bit
+
+    // A dense boolean matrix storing 64 entries per word, row major with every
+    // row starting on a word boundary. Bits past the last column of a row are
+    // kept zero. Elements are indexed from 1 like matrix_base.
+    class bit_matrix {
+      private:
+        size_t num_row, num_col, stride;
+        std::vector<m_bit::word> data;
+
+        void check_index(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the matrix.");
+        }
+
+        void check_same_size(const bit_matrix& b) const {
+            if (num_row != b.num_row || num_col != b.num_col)
+                throw std::domain_error("Matrices must be the same size");
+        }
+
+      public:
+        bit_matrix() : num_row(0), num_col(0), stride(0) {}
+
+        bit_matrix(size_t rows, size_t cols)
+            : num_row(rows), num_col(cols), stride(m_bit::words_for(cols)), data(rows * m_bit::words_for(cols), 0) {}
+
+        // Nonzero elements become set bits.
+        template <expression T>
+        explicit bit_matrix(const matrix_base<T>& matrix) : bit_matrix(matrix.size_row(), matrix.size_col()) {
+            const T* in = matrix.raw_data();
+            for (size_t i = 0; i < num_row; ++i) {
+                m_bit::word* out = row(i);
+                for (size_t j = 0; j < num_col; ++j) {
+                    if (in[i * num_col + j] != T{})
+                        out[j / m_bit::word_bits] |= m_bit::word{1} << (j % m_bit::word_bits);
+                }
+            }
+        }
+
+        static bit_matrix identity(size_t size) {
+            bit_matrix result{size, size};
+            for (size_t i = 0; i < size; ++i)
+                result.row(i)[i / m_bit::word_bits] |= m_bit::word{1} << (i % m_bit::word_bits);
+            return result;
+        }
+
+        [[nodiscard]] size_t size_row() const { return num_row; }
+
+        [[nodiscard]] size_t size_col() const { return num_col; }
+
+        [[nodiscard]] bool is_empty() const { return num_row == 0 || num_col == 0; }
+
+        [[nodiscard]] bool is_square() const { return num_row == num_col; }
+
+        // Words per row.
+        [[nodiscard]] size_t row_words() const { return stride; }
+
+        // The words of row i, counted from 0.
+        [[nodiscard]] m_bit::word* row(size_t i) { return data.data() + i * stride; }
+
+        [[nodiscard]] const m_bit::word* row(size_t i) const { return data.data() + i * stride; }
+
+        bool operator()(size_t row, size_t column) const {
+            check_index(row, column);
+            --column;
+            return (this->row(row - 1)[column / m_bit::word_bits] >> (column % m_bit::word_bits)) & 1;
+        }
+
+        void set(size_t row, size_t column, bool value = true) {
+            check_index(row, column);
+            --column;
+            m_bit::word bit = m_bit::word{1} << (column % m_bit::word_bits);
+            m_bit::word& target = this->row(row - 1)[column / m_bit::word_bits];
+            target = value ? target | bit : target & ~bit;
+        }
+
+        void flip(size_t row, size_t column) {
+            check_index(row, column);
+            --column;
+            this->row(row - 1)[column / m_bit::word_bits] ^= m_bit::word{1} << (column % m_bit::word_bits);
+        }
+
+        // Number of set elements.
+        [[nodiscard]] size_t count() const {
+            size_t total = 0;
+            for (m_bit::word w : data)
+                total += static_cast<size_t>(std::popcount(w));
+            return total;
+        }
+
+        template <expression T = int>
+        [[nodiscard]] matrix_base<T> to_matrix() const {
+            matrix_base<T> result{num_row, num_col};
+            T* out = result.raw_data();
+            for (size_t i = 0; i < num_row; ++i) {
+                const m_bit::word* in = row(i);
+                for (size_t j = 0; j < num_col; ++j) {
+                    if ((in[j / m_bit::word_bits] >> (j % m_bit::word_bits)) & 1)
+                        out[i * num_col + j] = 1;
+                }
+            }
+            return result;
+        }
+
+        /*
+         * ELEMENTARY ROW OPERATIONS OVER GF(2)
+         */
+
+        // Rows are counted from 1, as for elements.
+        void swap_rows(size_t a, size_t b) {
+            if (a == 0 || b == 0 || a > num_row || b > num_row)
+                throw std::out_of_range("Requested row lies outside of the matrix.");
+            if (a != b)
+                std::swap_ranges(row(a - 1), row(a - 1) + stride, row(b - 1));
+        }
+
+        // Row target += row source over GF(2), i.e. an XOR.
+        void add_row(size_t target, size_t source) {
+            if (target == 0 || source == 0 || target > num_row || source > num_row)
+                throw std::out_of_range("Requested row lies outside of the matrix.");
+            m_bit::word* out = row(target - 1);
+            const m_bit::word* in = row(source - 1);
+            for (size_t w = 0; w < stride; ++w)
+                out[w] ^= in[w];
+        }
+
+        /*
+         * ELEMENTWISE OPERATIONS
+         */
+
+        bit_matrix operator|(const bit_matrix& b) const {
+            check_same_size(b);
+            bit_matrix result = *this;
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] |= b.data[i];
+            return result;
+        }
+
+        bit_matrix operator&(const bit_matrix& b) const {
+            check_same_size(b);
+            bit_matrix result = *this;
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] &= b.data[i];
+            return result;
+        }
+
+        // Sum over GF(2).
+        bit_matrix operator^(const bit_matrix& b) const {
+            check_same_size(b);
+            bit_matrix result = *this;
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] ^= b.data[i];
+            return result;
+        }
+
+        bool operator==(const bit_matrix& b) const {
+            return num_row == b.num_row && num_col == b.num_col && data == b.data;
+        }
+
+        [[nodiscard]] bit_matrix transpose() const {
+            bit_matrix result{num_col, num_row};
+            std::array<m_bit::word, m_bit::word_bits> block{};
+
+            for (size_t r0 = 0; r0 < num_row; r0 += m_bit::word_bits) {
+                const size_t rows = std::min(m_bit::word_bits, num_row - r0);
+                for (size_t w = 0; w < stride; ++w) {
+                    for (size_t r = 0; r < m_bit::word_bits; ++r)
+                        block[r] = r < rows ? row(r0 + r)[w] : 0;
+                    m_bit::transpose_block(block);
+
+                    const size_t cols = std::min(m_bit::word_bits, num_col - w * m_bit::word_bits);
+                    for (size_t c = 0; c < cols; ++c)
+                        result.row(w * m_bit::word_bits + c)[r0 / m_bit::word_bits] = block[c];
+                }
+            }
+            return result;
+        }
+
+        // Boolean product, (A B)(i, j) = OR_k A(i, k) AND B(k, j).
+        //
+        // Method of the Four Russians: for every 8 rows of B a table of all 256
+        // of their ORs is built, after which each row of A ORs in one table
+        // entry per byte instead of up to 8 rows. Zero bytes of A are skipped,
+        // so sparse operands cost little more than their set bits. Columns are
+        // split into chunks whose tables stay in cache, one task per chunk.
+        bit_matrix operator*(const bit_matrix& b) const {
+            if (is_empty() || b.is_empty())
+                throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+            if (num_col != b.num_row)
+                throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                        "matrix b");
+
+            bit_matrix result{num_row, b.num_col};
+            const size_t out_words = b.stride;
+            const size_t chunks = (out_words + m_bit::column_words - 1) / m_bit::column_words;
+            constexpr size_t entries = size_t{1} << m_bit::table_bits;
+
+            auto columns = [&](size_t chunk_lo, size_t chunk_hi) {
+                std::vector<m_bit::word> table(entries * m_bit::column_words);
+                for (size_t chunk = chunk_lo; chunk < chunk_hi; ++chunk) {
+                    const size_t w_begin = chunk * m_bit::column_words;
+                    const size_t width = std::min(m_bit::column_words, out_words - w_begin);
+
+                    for (size_t k0 = 0; k0 < num_col; k0 += m_bit::table_bits) {
+                        const size_t rows = std::min(m_bit::table_bits, num_col - k0);
+                        // Skip building the table when no row of A uses this block
+                        bool used = false;
+                        for (size_t i = 0; i < num_row && !used; ++i)
+                            used = ((row(i)[k0 / m_bit::word_bits] >> (k0 % m_bit::word_bits)) & 0xff) != 0;
+                        if (!used)
+                            continue;
+
+                        std::fill_n(table.begin(), width, 0);
+                        for (size_t index = 1; index < (size_t{1} << rows); ++index) {
+                            const m_bit::word* previous = table.data() + (index & (index - 1)) * width;
+                            const m_bit::word* source =
+                                b.row(k0 + static_cast<size_t>(std::countr_zero(index))) + w_begin;
+                            m_bit::word* entry = table.data() + index * width;
+                            for (size_t w = 0; w < width; ++w)
+                                entry[w] = previous[w] | source[w];
+                        }
+
+                        for (size_t i = 0; i < num_row; ++i) {
+                            size_t index = (row(i)[k0 / m_bit::word_bits] >> (k0 % m_bit::word_bits)) & 0xff;
+                            if (index == 0)
+                                continue;
+                            const m_bit::word* entry = table.data() + index * width;
+                            m_bit::word* out = result.row(i) + w_begin;
+                            for (size_t w = 0; w < width; ++w)
+                                out[w] |= entry[w];
+                        }
+                    }
+                }
+            };
+
+            if (chunks > 1 && num_row * out_words >= m_bit::parallel_threshold)
+                m_parallel::parallel_for(0, chunks, 1, columns);
+            else
+                columns(0, chunks);
+            return result;
+        }
+    };
+
+    inline bit_matrix transpose(const bit_matrix& matrix) {
+        return matrix.transpose();
+    }
+
+    // Reachability, (I | A) squared until it stops changing: element (i, j) is
+    // set when j can be reached from i, itself included. Takes at most
+    // ceil(log2(n)) products, fewer when the longest shortest path is short.
+    inline bit_matrix transitive_closure(const bit_matrix& adjacency) {
+        if (!adjacency.is_square())
+            throw std::invalid_argument("Matrix must be square to calculate its closure");
+
+        bit_matrix result = adjacency | bit_matrix::identity(adjacency.size_row());
+        for (size_t length = 1; length + 1 < adjacency.size_row(); length *= 2) {
+            bit_matrix next = result * result;
+            if (next == result)
+                break;
+            result = std::move(next);
+        }
+        return result;
+    }
+
+    // Reduces the matrix in place to reduced row echelon form over GF(2) and
+    // returns its rank. Each pivot is XORed into the other rows a word at a
+    // time, starting from the pivot's word; rows are spread over the pool for
+    // large matrices.
+    inline size_t gf2_eliminate(bit_matrix& matrix) {
+        const size_t rows = matrix.size_row(), cols = matrix.size_col(), stride = matrix.row_words();
+        size_t rank = 0;
+
+        for (size_t col = 0; col < cols && rank < rows; ++col) {
+            const size_t w = col / m_bit::word_bits;
+            const m_bit::word bit = m_bit::word{1} << (col % m_bit::word_bits);
+
+            size_t pivot = rank;
+            while (pivot < rows && !(matrix.row(pivot)[w] & bit))
+                ++pivot;
+            if (pivot == rows)
+                continue;
+            if (pivot != rank)
+                std::swap_ranges(matrix.row(pivot), matrix.row(pivot) + stride, matrix.row(rank));
+
+            const m_bit::word* source = matrix.row(rank);
+            auto eliminate = [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    m_bit::word* target = matrix.row(i);
+                    if (i == rank || !(target[w] & bit))
+                        continue;
+                    for (size_t x = w; x < stride; ++x)
+                        target[x] ^= source[x];
+                }
+            };
+            if (rows * (stride - w) >= m_bit::parallel_threshold)
+                m_parallel::parallel_for(0, rows, 256, eliminate);
+            else
+                eliminate(0, rows);
+            ++rank;
+        }
+        return rank;
+    }
+
+    inline bit_matrix gf2_rref(const bit_matrix& matrix) {
+        bit_matrix result = matrix;
+        gf2_eliminate(result);
+        return result;
+    }
+
+    inline size_t gf2_rank(bit_matrix matrix) {
+        return gf2_eliminate(matrix);
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_BITMATRIX_HPP
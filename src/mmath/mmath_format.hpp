@@ -0,0 +1,270 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_FORMAT_HPP
+#define MMATH_MMATH_FORMAT_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <locale>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "mmath_concepts.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    template <expression T>
+    class matrix_base;
+
+    struct format_options {
+        std::string column_delimiter = " ";
+        std::string row_delimiter = "\n";
+        // Significant digits for general and scientific, decimals for fixed. A
+        // negative precision writes the shortest text that reads back exactly.
+        int precision = -1;
+        std::chars_format float_format = std::chars_format::general;
+        // Larger matrices keep only their first and last rows/columns, with the
+        // middle replaced by the ellipsis. Zero prints everything.
+        size_t max_rows = 0;
+        size_t max_cols = 0;
+        std::string ellipsis = "...";
+        bool trailing_row_delimiter = false;
+    };
+
+    namespace m_format {
+
+        template <typename T>
+        concept character = std::same_as<T, char> || std::same_as<T, signed char> || std::same_as<T, unsigned char> ||
+                            std::same_as<T, wchar_t> || std::same_as<T, char8_t> || std::same_as<T, char16_t> ||
+                            std::same_as<T, char32_t>;
+
+        // Types std::to_chars handles. Character types are excluded because
+        // streams print them as characters rather than numbers.
+        template <typename T>
+        concept formattable = std::is_arithmetic_v<T> && !std::same_as<T, bool> && !character<T>;
+
+        // Buffered output is handed to the stream once this much has built up.
+        constexpr size_t flush_threshold = size_t{1} << 20;
+        // Rows formatted per task by the parallel writer.
+        constexpr size_t rows_per_block = 256;
+
+        // Growable character buffer written to directly by to_chars.
+        class buffer {
+          private:
+            std::vector<char> storage;
+            size_t used = 0;
+
+          public:
+            // Space for at least n more characters, starting at the returned pointer.
+            char* reserve(size_t n) {
+                if (storage.size() - used < n)
+                    storage.resize(std::max(storage.size() * 2, used + n));
+                return storage.data() + used;
+            }
+
+            void commit(const char* end) { used = static_cast<size_t>(end - storage.data()); }
+
+            void append(std::string_view text) {
+                char* out = reserve(text.size());
+                std::memcpy(out, text.data(), text.size());
+                used += text.size();
+            }
+
+            [[nodiscard]] size_t size() const { return used; }
+
+            [[nodiscard]] std::string_view view() const { return {storage.data(), used}; }
+
+            void clear() { used = 0; }
+
+            void flush_to(std::ostream& os) {
+                os.write(storage.data(), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        };
+
+        // Reused across calls so repeated printing does not reallocate.
+        inline buffer& scratch() {
+            thread_local buffer instance;
+            return instance;
+        }
+
+        template <formattable T>
+        void append_value(buffer& out, const T& value, const format_options& options) {
+            for (size_t room = 64;; room *= 4) {
+                char* first = out.reserve(room);
+                std::to_chars_result result;
+                if constexpr (std::is_floating_point_v<T>) {
+                    result = options.precision < 0
+                                 ? std::to_chars(first, first + room, value, options.float_format)
+                                 : std::to_chars(first, first + room, value, options.float_format, options.precision);
+                } else {
+                    result = std::to_chars(first, first + room, value);
+                }
+
+                if (result.ec == std::errc{}) {
+                    out.commit(result.ptr);
+                    return;
+                }
+            }
+        }
+
+        // Anything else printable goes through a stream one element at a time.
+        template <expression_printable T>
+            requires(!formattable<T>)
+        void append_value(buffer& out, const T& value, const format_options& options) {
+            thread_local std::ostringstream stream;
+            stream.str({});
+            stream.clear();
+            if (options.precision >= 0)
+                stream.precision(options.precision);
+            stream << value;
+            out.append(stream.view());
+        }
+
+        // Which indices of an axis are printed: [0, head) and [n - tail, n).
+        struct axis_plan {
+            size_t head, tail;
+            bool elided;
+        };
+
+        inline axis_plan plan_axis(size_t n, size_t max) {
+            if (max == 0 || n <= max)
+                return {n, 0, false};
+            return {(max + 1) / 2, max / 2, true};
+        }
+
+        template <typename T>
+        void append_row(buffer& out, const T* row, size_t cols, const axis_plan& columns, const format_options& options) {
+            for (size_t j = 0; j < columns.head; ++j) {
+                if (j != 0)
+                    out.append(options.column_delimiter);
+                append_value(out, row[j], options);
+            }
+            if (columns.elided) {
+                out.append(options.column_delimiter);
+                out.append(options.ellipsis);
+            }
+            for (size_t j = cols - columns.tail; j < cols; ++j) {
+                out.append(options.column_delimiter);
+                append_value(out, row[j], options);
+            }
+        }
+
+        // Formats row by row into the scratch buffer and writes it out in large
+        // pieces.
+        template <typename T>
+        void write(std::ostream& os, const T* data, size_t rows, size_t cols, const format_options& options) {
+            buffer& out = scratch();
+            out.clear();
+
+            axis_plan row_plan = plan_axis(rows, options.max_rows);
+            axis_plan column_plan = plan_axis(cols, options.max_cols);
+
+            auto emit = [&](size_t i, bool last) {
+                append_row(out, data + i * cols, cols, column_plan, options);
+                if (!last || options.trailing_row_delimiter)
+                    out.append(options.row_delimiter);
+                if (out.size() >= flush_threshold)
+                    out.flush_to(os);
+            };
+
+            for (size_t i = 0; i < row_plan.head; ++i)
+                emit(i, i + 1 == rows);
+            if (row_plan.elided) {
+                out.append(options.ellipsis);
+                out.append(options.row_delimiter);
+            }
+            for (size_t i = rows - row_plan.tail; i < rows; ++i)
+                emit(i, i + 1 == rows);
+
+            out.flush_to(os);
+        }
+
+        // Formats blocks of rows concurrently, a wave of blocks at a time, and
+        // writes the finished blocks in order. Elision options are ignored.
+        template <typename T>
+        void write_parallel(std::ostream& os, const T* data, size_t rows, size_t cols, const format_options& options) {
+            size_t num_blocks = (rows + rows_per_block - 1) / rows_per_block;
+            size_t wave = std::max<size_t>(1, m_parallel::thread_pool::instance().concurrency() * 2);
+            std::vector<buffer> blocks(std::min(wave, num_blocks));
+            axis_plan all_columns{cols, 0, false};
+
+            for (size_t first_block = 0; first_block < num_blocks; first_block += wave) {
+                size_t count = std::min(wave, num_blocks - first_block);
+
+                m_parallel::parallel_for(0, count, 1, [&](size_t lo, size_t hi) {
+                    for (size_t b = lo; b < hi; ++b) {
+                        buffer& out = blocks[b];
+                        out.clear();
+                        size_t row_begin = (first_block + b) * rows_per_block;
+                        size_t row_end = std::min(rows, row_begin + rows_per_block);
+                        for (size_t i = row_begin; i < row_end; ++i) {
+                            append_row(out, data + i * cols, cols, all_columns, options);
+                            if (i + 1 != rows || options.trailing_row_delimiter)
+                                out.append(options.row_delimiter);
+                        }
+                    }
+                });
+
+                for (size_t b = 0; b < count; ++b)
+                    blocks[b].flush_to(os);
+            }
+        }
+
+        // The options reproducing what streaming each element with os << would
+        // print, or nothing when os has state to_chars cannot honour.
+        inline std::optional<format_options> stream_options(const std::ostream& os) {
+            using std::ios_base;
+            ios_base::fmtflags flags = os.flags();
+
+            if (os.width() != 0 || (flags & (ios_base::showpos | ios_base::showpoint | ios_base::showbase)) ||
+                (flags & ios_base::uppercase) || !(os.getloc() == std::locale::classic()))
+                return std::nullopt;
+
+            ios_base::fmtflags base = flags & ios_base::basefield;
+            if (base != ios_base::dec && base != ios_base::fmtflags{})
+                return std::nullopt;
+
+            format_options options;
+            options.precision = os.precision() < 0 ? 6 : static_cast<int>(os.precision());
+            const ios_base::fmtflags floatfield = flags & ios_base::floatfield;
+            if (floatfield == ios_base::fixed)
+                options.float_format = std::chars_format::fixed;
+            else if (floatfield == ios_base::scientific)
+                options.float_format = std::chars_format::scientific;
+            else if (floatfield == ios_base::fmtflags{})
+                options.float_format = std::chars_format::general;
+            else
+                return std::nullopt;
+            return options;
+        }
+    }  // namespace m_format
+
+    // Caller owned output buffer for the formatting functions, reusable across
+    // calls without reallocating.
+    using format_buffer = m_format::buffer;
+
+    template <expression_printable T>
+    void format(std::ostream& os, const matrix_base<T>& matrix, const format_options& options = {}) {
+        m_format::write(os, matrix.raw_data(), matrix.size_row(), matrix.size_col(), options);
+    }
+
+    template <expression_printable T>
+    std::string to_string(const matrix_base<T>& matrix, const format_options& options = {}) {
+        std::ostringstream os;
+        format(os, matrix, options);
+        return std::move(os).str();
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_FORMAT_HPP
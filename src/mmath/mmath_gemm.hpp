@@ -0,0 +1,170 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_GEMM_HPP
+#define MMATH_MMATH_GEMM_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include "mmath_concepts.hpp"
+#include "mmath_parallel.hpp"
+#include "mmath_tuning.hpp"
+
+namespace mmath {
+    namespace m_kernel {
+
+        // Blocking parameters of the general matrix multiply. block_k x block_n
+        // of B is kept hot in cache while a block_m row panel of A streams past it.
+        struct gemm_config {
+            size_t block_m = 64;
+            size_t block_n = 256;
+            size_t block_k = 128;
+            // Minimum m * n * k before the row panels are spread over the pool.
+            size_t parallel_threshold = size_t{1} << 18;
+        };
+
+        // The gemm.* settings for the given element type over the defaults.
+        inline gemm_config gemm_config_from(const tuning_settings& settings, const char* type) {
+            gemm_config config;
+            config.block_m = m_tuning::lookup(settings, "gemm", type, "block_m", config.block_m);
+            config.block_n = m_tuning::lookup(settings, "gemm", type, "block_n", config.block_n);
+            config.block_k = m_tuning::lookup(settings, "gemm", type, "block_k", config.block_k);
+            config.parallel_threshold =
+                m_tuning::lookup(settings, "gemm", type, "parallel_threshold", config.parallel_threshold);
+            return config;
+        }
+
+        // Blocking of products of T. Kernels that do not work on plain
+        // arithmetic types, and gemm_tuning<>() itself, use the settings
+        // shared by every type.
+        template <typename T = void>
+        gemm_config& gemm_tuning() {
+            static gemm_config config = gemm_config_from(m_tuning::startup_settings(), m_tuning::type_key<T>());
+            return config;
+        }
+
+        struct transpose_config {
+            // Side of the square tiles copied at a time, so neither the rows read
+            // nor the columns written leave the cache within a tile.
+            size_t tile = 32;
+        };
+
+        inline transpose_config transpose_config_from(const tuning_settings& settings, const char* type) {
+            transpose_config config;
+            config.tile = m_tuning::lookup(settings, "transpose", type, "tile", config.tile);
+            return config;
+        }
+
+        template <typename T = void>
+        transpose_config& transpose_tuning() {
+            static transpose_config config =
+                transpose_config_from(m_tuning::startup_settings(), m_tuning::type_key<T>());
+            return config;
+        }
+
+        // C (m x n) += A (m x k) * B (k x n), or -= when Subtract is set.
+        //
+        // B and C are row major with leading dimensions ldb and ldc. A is addressed
+        // as a[i * a_row_stride + p * a_col_stride], which lets callers pass a
+        // transposed view of A without copying it. A and B may hold a narrower
+        // type than C, in which case each element is widened to T before it is
+        // multiplied, so products and sums are carried out in T.
+        template <expression T, bool Subtract = false, typename TA = T, typename TB = T>
+        void gemm(size_t m,
+                  size_t n,
+                  size_t k,
+                  const TA* a,
+                  size_t a_row_stride,
+                  size_t a_col_stride,
+                  const TB* b,
+                  size_t ldb,
+                  T* c,
+                  size_t ldc,
+                  bool allow_parallel = true) {
+            if (m == 0 || n == 0 || k == 0)
+                return;
+
+            const gemm_config& config = gemm_tuning<T>();
+            const size_t mc = std::max<size_t>(config.block_m, 1);
+            const size_t nc = std::max<size_t>(config.block_n, 1);
+            const size_t kc = std::max<size_t>(config.block_k, 1);
+
+            auto row_panels = [&](size_t panel_lo, size_t panel_hi) {
+                for (size_t panel = panel_lo; panel < panel_hi; ++panel) {
+                    size_t i_begin = panel * mc, i_end = std::min(m, i_begin + mc);
+
+                    for (size_t p_begin = 0; p_begin < k; p_begin += kc) {
+                        size_t p_end = std::min(k, p_begin + kc);
+
+                        for (size_t j_begin = 0; j_begin < n; j_begin += nc) {
+                            size_t j_end = std::min(n, j_begin + nc);
+
+                            for (size_t i = i_begin; i < i_end; ++i) {
+                                T* c_row = c + i * ldc;
+                                for (size_t p = p_begin; p < p_end; ++p) {
+                                    const T a_ip = static_cast<T>(a[i * a_row_stride + p * a_col_stride]);
+                                    const TB* b_row = b + p * ldb;
+                                    // Unit stride over j so the compiler can vectorize
+                                    for (size_t j = j_begin; j < j_end; ++j) {
+                                        if constexpr (Subtract)
+                                            c_row[j] = c_row[j] - a_ip * static_cast<T>(b_row[j]);
+                                        else
+                                            c_row[j] = c_row[j] + a_ip * static_cast<T>(b_row[j]);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+
+            size_t num_panels = (m + mc - 1) / mc;
+
+            if (allow_parallel && m * n * k >= config.parallel_threshold) {
+                m_parallel::parallel_for(0, num_panels, 1, row_panels);
+            } else {
+                row_panels(0, num_panels);
+            }
+        }
+
+        // y (m) = A (m x n) * x (n), A row major with leading dimension lda.
+        template <expression T>
+        void gemv(size_t m, size_t n, const T* a, size_t lda, const T* x, T* y, bool allow_parallel = true) {
+            auto rows = [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    const T* a_row = a + i * lda;
+                    T sum = T{};
+                    for (size_t j = 0; j < n; ++j)
+                        sum = sum + a_row[j] * x[j];
+                    y[i] = sum;
+                }
+            };
+
+            const gemm_config& config = gemm_tuning<T>();
+            if (allow_parallel && m * n >= config.parallel_threshold) {
+                m_parallel::parallel_for(0, m, std::max<size_t>(config.block_m, 1), rows);
+            } else {
+                rows(0, m);
+            }
+        }
+
+        // b (n x m) = transpose of a (m x n), both row major and packed.
+        template <typename T>
+        void transpose(size_t m, size_t n, const T* a, T* b) {
+            const size_t tile = std::max<size_t>(transpose_tuning<T>().tile, 1);
+            for (size_t ib = 0; ib < m; ib += tile) {
+                const size_t i_end = std::min(m, ib + tile);
+                for (size_t jb = 0; jb < n; jb += tile) {
+                    const size_t j_end = std::min(n, jb + tile);
+                    for (size_t i = ib; i < i_end; ++i)
+                        for (size_t j = jb; j < j_end; ++j)
+                            b[j * m + i] = a[i * n + j];
+                }
+            }
+        }
+    }  // namespace m_kernel
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_GEMM_HPP
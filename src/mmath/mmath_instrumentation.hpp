@@ -0,0 +1,233 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_INSTRUMENTATION_HPP
+#define MMATH_MMATH_INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace mmath {
+
+    /*
+     * INSTRUMENTATION
+     *
+     * Define MMATH_INSTRUMENTATION before including mmath to count, per matrix
+     * operation, the calls, wall time, flops, allocations, bytes copied and
+     * result sizes. Without it every hook is an empty inline function and the
+     * statistics stay zero.
+     *
+     * Times are inclusive: a power also counts the time of the multiplies it
+     * performs, which are recorded under multiply as well. Allocations and
+     * copies are charged to the innermost operation running on the thread;
+     * copies of whole matrices outside any operation are charged to copy.
+     */
+
+    enum class operation : size_t {
+        add,
+        subtract,
+        scale,
+        multiply,
+        power,
+        transpose,
+        row_operation,
+        lu_factor,
+        lu_solve,
+        copy,
+        other,
+    };
+
+    namespace m_stats {
+
+        constexpr size_t operation_count = static_cast<size_t>(operation::other) + 1;
+
+        constexpr std::array<const char*, operation_count> operation_names = {
+            "add",           "subtract",  "scale",    "multiply", "power", "transpose",
+            "row_operation", "lu_factor", "lu_solve", "copy",     "other",
+        };
+
+        struct counters {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> nanoseconds{0};
+            std::atomic<uint64_t> flops{0};
+            std::atomic<uint64_t> allocations{0};
+            std::atomic<uint64_t> bytes_allocated{0};
+            std::atomic<uint64_t> bytes_copied{0};
+            std::atomic<uint64_t> elements{0};
+            std::atomic<uint64_t> max_elements{0};
+        };
+
+        inline std::array<counters, operation_count>& global_counters() {
+            static std::array<counters, operation_count> table;
+            return table;
+        }
+
+        inline counters& counters_of(operation op) {
+            return global_counters()[static_cast<size_t>(op)];
+        }
+
+#ifdef MMATH_INSTRUMENTATION
+        // Innermost operation running on this thread, null outside of one.
+        inline counters*& current() {
+            thread_local counters* active = nullptr;
+            return active;
+        }
+
+        // Times one call of an operation and makes it the target of the
+        // allocations and copies made while it runs.
+        class scope {
+          private:
+            counters& target;
+            counters* outer;
+            std::chrono::steady_clock::time_point start;
+
+          public:
+            explicit scope(operation op, uint64_t flops = 0, uint64_t elements = 0)
+                : target(counters_of(op)), outer(current()), start(std::chrono::steady_clock::now()) {
+                current() = &target;
+                target.flops.fetch_add(flops, std::memory_order_relaxed);
+                target.elements.fetch_add(elements, std::memory_order_relaxed);
+                uint64_t largest = target.max_elements.load(std::memory_order_relaxed);
+                while (elements > largest &&
+                       !target.max_elements.compare_exchange_weak(largest, elements, std::memory_order_relaxed)) {
+                }
+            }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            ~scope() {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                target.calls.fetch_add(1, std::memory_order_relaxed);
+                target.nanoseconds.fetch_add(
+                    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                    std::memory_order_relaxed);
+                current() = outer;
+            }
+        };
+
+        inline void record_allocation(size_t bytes) {
+            counters& target = current() ? *current() : counters_of(operation::other);
+            target.allocations.fetch_add(1, std::memory_order_relaxed);
+            target.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        inline void record_copy(size_t bytes) {
+            counters* target = current();
+            if (!target) {
+                target = &counters_of(operation::copy);
+                target->calls.fetch_add(1, std::memory_order_relaxed);
+            }
+            target->bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+        }
+#else
+        class scope {
+          public:
+            explicit scope(operation, uint64_t = 0, uint64_t = 0) {}
+        };
+
+        inline void record_allocation(size_t) {}
+
+        inline void record_copy(size_t) {}
+#endif
+    }  // namespace m_stats
+
+    struct operation_statistics {
+        const char* name;
+        uint64_t calls;
+        double seconds;
+        uint64_t flops;
+        uint64_t allocations;
+        uint64_t bytes_allocated;
+        uint64_t bytes_copied;
+        // Sum and maximum of the number of elements in the results
+        uint64_t elements;
+        uint64_t max_elements;
+    };
+
+    // Totals of one operation since start up or the last reset. Always zero
+    // unless MMATH_INSTRUMENTATION is defined.
+    inline operation_statistics operation_stats(operation op) {
+        const m_stats::counters& c = m_stats::counters_of(op);
+        return {m_stats::operation_names[static_cast<size_t>(op)],
+                c.calls.load(),
+                static_cast<double>(c.nanoseconds.load()) * 1e-9,
+                c.flops.load(),
+                c.allocations.load(),
+                c.bytes_allocated.load(),
+                c.bytes_copied.load(),
+                c.elements.load(),
+                c.max_elements.load()};
+    }
+
+    // Every operation, in the order of the operation enumeration.
+    inline std::vector<operation_statistics> operation_stats() {
+        std::vector<operation_statistics> result;
+        result.reserve(m_stats::operation_count);
+        for (size_t i = 0; i < m_stats::operation_count; ++i)
+            result.push_back(operation_stats(static_cast<operation>(i)));
+        return result;
+    }
+
+    inline void reset_operation_stats() {
+        for (auto& c : m_stats::global_counters()) {
+            c.calls = 0;
+            c.nanoseconds = 0;
+            c.flops = 0;
+            c.allocations = 0;
+            c.bytes_allocated = 0;
+            c.bytes_copied = 0;
+            c.elements = 0;
+            c.max_elements = 0;
+        }
+    }
+
+    // {"multiply": {"calls": 2, "seconds": 0.5, ...}, ...}
+    inline void write_operation_stats_json(std::ostream& os) {
+        os << "{";
+        bool first = true;
+        for (const auto& stats : operation_stats()) {
+            os << (first ? "" : ", ") << "\"" << stats.name << "\": {\"calls\": " << stats.calls
+               << ", \"seconds\": " << stats.seconds << ", \"flops\": " << stats.flops
+               << ", \"allocations\": " << stats.allocations << ", \"bytes_allocated\": " << stats.bytes_allocated
+               << ", \"bytes_copied\": " << stats.bytes_copied << ", \"elements\": " << stats.elements
+               << ", \"max_elements\": " << stats.max_elements << "}";
+            first = false;
+        }
+        os << "}";
+    }
+
+    // Prometheus text exposition format, one counter family per statistic
+    // labelled by operation, e.g. mmath_operation_calls_total{operation="add"}.
+    inline void write_operation_stats_prometheus(std::ostream& os) {
+        const auto all = operation_stats();
+        auto family = [&](const char* name, const char* type, const char* help, auto value) {
+            os << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+            for (const auto& stats : all)
+                os << name << "{operation=\"" << stats.name << "\"} " << value(stats) << "\n";
+        };
+        using s = const operation_statistics&;
+        family("mmath_operation_calls_total", "counter", "Completed calls.", [](s x) { return x.calls; });
+        family("mmath_operation_seconds_total", "counter", "Inclusive wall time.", [](s x) { return x.seconds; });
+        family("mmath_operation_flops_total", "counter", "Floating point or integer operations.",
+               [](s x) { return x.flops; });
+        family("mmath_operation_allocations_total", "counter", "Element buffers allocated.",
+               [](s x) { return x.allocations; });
+        family("mmath_operation_allocated_bytes_total", "counter", "Bytes of element buffers allocated.",
+               [](s x) { return x.bytes_allocated; });
+        family("mmath_operation_copied_bytes_total", "counter", "Bytes of elements copied.",
+               [](s x) { return x.bytes_copied; });
+        family("mmath_operation_elements_total", "counter", "Elements of the results.",
+               [](s x) { return x.elements; });
+        family("mmath_operation_max_elements", "gauge", "Elements of the largest result.",
+               [](s x) { return x.max_elements; });
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_INSTRUMENTATION_HPP
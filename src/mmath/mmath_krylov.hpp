@@ -0,0 +1,669 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_KRYLOV_HPP
+#define MMATH_MMATH_KRYLOV_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_sparse.hpp"
+
+namespace mmath {
+
+    /*
+     * OPERATOR AND PRECONDITIONER CONCEPTS
+     */
+
+    // Anything that can compute y = A x for a square A without exposing its
+    // entries: dense or sparse matrices, or a user supplied function.
+    template <typename Op>
+    concept linear_operator =
+        requires { typename Op::value_type; } &&
+        requires(const Op& op, std::span<const typename Op::value_type> x, std::span<typename Op::value_type> y) {
+            { op.size() } -> std::convertible_to<size_t>;
+            op.apply(x, y);
+        };
+
+    // Computes z = M^-1 r for some approximation M of A.
+    template <typename P, typename T>
+    concept preconditioner = requires(const P& p, std::span<const T> r, std::span<T> z) {
+        p.apply(r, z);
+    };
+
+    // Wraps a dense matrix_base as a linear operator without copying it.
+    template <expression T>
+    class dense_operator {
+      private:
+        const matrix_base<T>* matrix;
+
+      public:
+        using value_type = T;
+
+        explicit dense_operator(const matrix_base<T>& matrix) : matrix(&matrix) {
+            if (!matrix.is_square())
+                throw std::invalid_argument("Matrix must be square to be used as a linear operator");
+        }
+
+        [[nodiscard]] size_t size() const { return matrix->size_row(); }
+
+        void apply(std::span<const T> x, std::span<T> y) const {
+            m_kernel::gemv(size(), size(), matrix->raw_data(), size(), x.data(), y.data());
+        }
+    };
+
+    // Wraps a callable f(std::span<const T> x, std::span<T> y) writing y = A x.
+    template <expression T, typename F>
+    class function_operator {
+      private:
+        size_t n;
+        F function;
+
+      public:
+        using value_type = T;
+
+        function_operator(size_t size, F function) : n(size), function(std::move(function)) {}
+
+        [[nodiscard]] size_t size() const { return n; }
+
+        void apply(std::span<const T> x, std::span<T> y) const { function(x, y); }
+    };
+
+    template <expression T>
+    dense_operator<T> make_operator(const matrix_base<T>& matrix) {
+        return dense_operator<T>{matrix};
+    }
+
+    template <expression T, typename F>
+    function_operator<T, F> make_operator(size_t size, F function) {
+        return function_operator<T, F>{size, std::move(function)};
+    }
+
+    /*
+     * PRECONDITIONERS
+     */
+
+    template <expression T>
+    class identity_preconditioner {
+      public:
+        void apply(std::span<const T> r, std::span<T> z) const { std::copy(r.begin(), r.end(), z.begin()); }
+    };
+
+    template <std::floating_point T>
+    class jacobi_preconditioner {
+      private:
+        std::vector<T> inverse_diagonal;
+
+        void invert() {
+            for (T& d : inverse_diagonal) {
+                if (d == 0)
+                    throw std::domain_error("Jacobi preconditioner requires a nonzero diagonal");
+                d = T{1} / d;
+            }
+        }
+
+      public:
+        explicit jacobi_preconditioner(std::vector<T> diagonal) : inverse_diagonal(std::move(diagonal)) { invert(); }
+
+        explicit jacobi_preconditioner(const matrix_base<T>& a) : inverse_diagonal(a.size_row()) {
+            if (!a.is_square())
+                throw std::invalid_argument("Matrix must be square to build a preconditioner");
+            for (size_t i = 0; i < a.size_row(); ++i)
+                inverse_diagonal[i] = a.raw_data()[i * a.size_col() + i];
+            invert();
+        }
+
+        explicit jacobi_preconditioner(const csr_matrix<T>& a) : inverse_diagonal(a.size_row()) {
+            if (a.size_row() != a.size_col())
+                throw std::invalid_argument("Matrix must be square to build a preconditioner");
+            for (size_t i = 0; i < a.size_row(); ++i)
+                inverse_diagonal[i] = a(i + 1, i + 1);
+            invert();
+        }
+
+        void apply(std::span<const T> r, std::span<T> z) const {
+            for (size_t i = 0; i < r.size(); ++i)
+                z[i] = r[i] * inverse_diagonal[i];
+        }
+    };
+
+    // Incomplete LU with zero fill in. The factors share the sparsity pattern of
+    // A, which must store every diagonal entry.
+    template <std::floating_point T>
+    class ilu0_preconditioner {
+      private:
+        csr_matrix<T> factors;
+        std::vector<size_t> diagonal;  // Position of (i, i) within the values
+
+      public:
+        explicit ilu0_preconditioner(const matrix_base<T>& a) : ilu0_preconditioner(csr_matrix<T>{a}) {}
+
+        explicit ilu0_preconditioner(csr_matrix<T> a) : factors(std::move(a)), diagonal(factors.size_row()) {
+            size_t n = factors.size_row();
+            if (n != factors.size_col())
+                throw std::invalid_argument("Matrix must be square to build a preconditioner");
+
+            const auto& row_ptr = factors.row_pointers();
+            const auto& col_idx = factors.column_indices();
+            auto& vals = factors.values();
+
+            for (size_t i = 0; i < n; ++i) {
+                auto begin = col_idx.begin() + row_ptr[i], end = col_idx.begin() + row_ptr[i + 1];
+                auto found = std::lower_bound(begin, end, i);
+                if (found == end || *found != i)
+                    throw std::domain_error("ILU(0) requires every diagonal entry to be stored");
+                diagonal[i] = found - col_idx.begin();
+            }
+
+            // Scatter map from column to position within the current row
+            constexpr size_t absent = static_cast<size_t>(-1);
+            std::vector<size_t> position(n, absent);
+
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    position[col_idx[k]] = k;
+
+                for (size_t k = row_ptr[i]; k < diagonal[i]; ++k) {
+                    size_t col = col_idx[k];
+                    T pivot = vals[diagonal[col]];
+                    if (pivot == 0)
+                        throw std::domain_error("Zero pivot encountered in ILU(0)");
+                    vals[k] /= pivot;
+                    for (size_t kk = diagonal[col] + 1; kk < row_ptr[col + 1]; ++kk) {
+                        size_t target = position[col_idx[kk]];
+                        if (target != absent)
+                            vals[target] -= vals[k] * vals[kk];
+                    }
+                }
+
+                for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    position[col_idx[k]] = absent;
+
+                if (vals[diagonal[i]] == 0)
+                    throw std::domain_error("Zero pivot encountered in ILU(0)");
+            }
+        }
+
+        void apply(std::span<const T> r, std::span<T> z) const {
+            const auto& row_ptr = factors.row_pointers();
+            const auto& col_idx = factors.column_indices();
+            const auto& vals = factors.values();
+            size_t n = factors.size_row();
+
+            // L has a unit diagonal
+            for (size_t i = 0; i < n; ++i) {
+                T sum = r[i];
+                for (size_t k = row_ptr[i]; k < diagonal[i]; ++k)
+                    sum -= vals[k] * z[col_idx[k]];
+                z[i] = sum;
+            }
+
+            for (size_t i = n; i > 0; --i) {
+                size_t row = i - 1;
+                T sum = z[row];
+                for (size_t k = diagonal[row] + 1; k < row_ptr[row + 1]; ++k)
+                    sum -= vals[k] * z[col_idx[k]];
+                z[row] = sum / vals[diagonal[row]];
+            }
+        }
+    };
+
+    /*
+     * SOLVER OPTIONS AND RESULTS
+     */
+
+    template <std::floating_point T>
+    struct krylov_options {
+        size_t max_iterations = 1000;
+        // Stop once ||b - A x|| <= tolerance * ||b||
+        T tolerance = T{1e-8};
+        // Krylov subspace dimension between GMRES restarts
+        size_t restart = 30;
+    };
+
+    template <std::floating_point T>
+    struct krylov_result {
+        size_t iterations;
+        T relative_residual;
+        bool converged;
+    };
+
+    namespace m_krylov {
+
+        // Default monitor, does nothing.
+        struct no_monitor {
+            template <typename T>
+            void operator()(size_t, T) const {}
+        };
+
+        // Monitors may return void, or a bool where false requests an early stop.
+        template <typename Monitor, typename T>
+        bool notify(Monitor& monitor, size_t iteration, T residual) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Monitor&, size_t, T>, bool>)
+                return monitor(iteration, residual);
+            else {
+                monitor(iteration, residual);
+                return true;
+            }
+        }
+
+        template <std::floating_point T>
+        T dot(std::span<const T> a, std::span<const T> b) {
+            T sum = T{};
+            for (size_t i = 0; i < a.size(); ++i)
+                sum += a[i] * b[i];
+            return sum;
+        }
+
+        template <std::floating_point T>
+        T norm(std::span<const T> a) {
+            return std::sqrt(dot(a, a));
+        }
+
+        // y += alpha * x
+        template <std::floating_point T>
+        void axpy(T alpha, std::span<const T> x, std::span<T> y) {
+            for (size_t i = 0; i < x.size(); ++i)
+                y[i] += alpha * x[i];
+        }
+
+        // r = b - A x
+        template <std::floating_point T, linear_operator Op>
+        void residual(const Op& a, std::span<const T> b, std::span<const T> x, std::span<T> r) {
+            a.apply(x, r);
+            for (size_t i = 0; i < r.size(); ++i)
+                r[i] = b[i] - r[i];
+        }
+
+        template <typename Op, std::floating_point T>
+        void check_sizes(const Op& a, std::span<const T> b, std::span<T> x) {
+            if (b.size() != a.size() || x.size() != a.size())
+                throw std::domain_error("The right hand side and solution must match the operator size");
+        }
+
+        // True when every workspace vector holds n elements.
+        template <typename... Vectors>
+        bool sized(size_t n, const Vectors&... vectors) {
+            return ((vectors.size() == n) && ...);
+        }
+    }  // namespace m_krylov
+
+    /*
+     * WORKSPACES
+     */
+
+    // Scratch vectors for the solvers, allocated once and reused across solves
+    // so no iteration allocates vectors. Operators large enough to be applied
+    // in parallel still allocate the small bookkeeping of each parallel_for.
+    template <std::floating_point T>
+    struct cg_workspace {
+        std::vector<T> r, z, p, ap;
+
+        explicit cg_workspace(size_t n) : r(n), z(n), p(n), ap(n) {}
+    };
+
+    template <std::floating_point T>
+    struct bicgstab_workspace {
+        std::vector<T> r, r_hat, p, v, s, t, p_hat, s_hat;
+
+        explicit bicgstab_workspace(size_t n) : r(n), r_hat(n), p(n), v(n), s(n), t(n), p_hat(n), s_hat(n) {}
+    };
+
+    template <std::floating_point T>
+    struct gmres_workspace {
+        size_t n, m;
+        std::vector<T> basis;  // (m + 1) x n Arnoldi vectors, row per vector
+        std::vector<T> hessenberg;  // (m + 1) x m
+        std::vector<T> cs, sn, g, y, w, z;
+
+        gmres_workspace(size_t n, size_t restart)
+            : n(n)
+            , m(restart)
+            , basis((restart + 1) * n)
+            , hessenberg((restart + 1) * restart)
+            , cs(restart)
+            , sn(restart)
+            , g(restart + 1)
+            , y(restart)
+            , w(n)
+            , z(n) {}
+
+        std::span<T> v(size_t i) { return {basis.data() + i * n, n}; }
+
+        T& h(size_t i, size_t j) { return hessenberg[i * m + j]; }
+    };
+
+    /*
+     * CONJUGATE GRADIENT
+     */
+
+    // Preconditioned conjugate gradient for symmetric positive definite A. x
+    // holds the initial guess and receives the solution.
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> cg(const Op& a,
+                        std::type_identity_t<std::span<const T>> b,
+                        std::type_identity_t<std::span<T>> x,
+                        cg_workspace<T>& ws,
+                        const std::type_identity_t<krylov_options<T>>& options = {},
+                        const Precond& precond = {},
+                        Monitor monitor = {}) {
+        using namespace m_krylov;
+        check_sizes<Op, T>(a, b, x);
+        if (!sized(a.size(), ws.r, ws.z, ws.p, ws.ap))
+            throw std::invalid_argument("CG workspace does not match the operator");
+
+        T b_norm = norm<T>(b);
+        if (b_norm == 0) {
+            std::fill(x.begin(), x.end(), T{});
+            return {0, T{}, true};
+        }
+
+        std::span<T> r{ws.r}, z{ws.z}, p{ws.p}, ap{ws.ap};
+
+        residual<T>(a, b, x, r);
+        T res = norm<T>(r) / b_norm;
+        if (res <= options.tolerance)
+            return {0, res, true};
+
+        precond.apply(r, z);
+        std::copy(z.begin(), z.end(), p.begin());
+        T rz = dot<T>(r, z);
+
+        for (size_t k = 1; k <= options.max_iterations; ++k) {
+            a.apply(p, ap);
+            T p_ap = dot<T>(p, ap);
+            if (p_ap == 0)
+                return {k, res, false};
+
+            T alpha = rz / p_ap;
+            axpy<T>(alpha, p, x);
+            axpy<T>(-alpha, ap, r);
+
+            res = norm<T>(r) / b_norm;
+            if (!notify(monitor, k, res))
+                return {k, res, false};
+            if (res <= options.tolerance)
+                return {k, res, true};
+
+            precond.apply(r, z);
+            T rz_next = dot<T>(r, z);
+            T beta = rz_next / rz;
+            rz = rz_next;
+            for (size_t i = 0; i < p.size(); ++i)
+                p[i] = z[i] + beta * p[i];
+        }
+
+        return {options.max_iterations, res, false};
+    }
+
+    /*
+     * BICGSTAB
+     */
+
+    // Right preconditioned BiCGSTAB for general nonsymmetric A.
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> bicgstab(const Op& a,
+                              std::type_identity_t<std::span<const T>> b,
+                              std::type_identity_t<std::span<T>> x,
+                              bicgstab_workspace<T>& ws,
+                              const std::type_identity_t<krylov_options<T>>& options = {},
+                              const Precond& precond = {},
+                              Monitor monitor = {}) {
+        using namespace m_krylov;
+        check_sizes<Op, T>(a, b, x);
+        if (!sized(a.size(), ws.r, ws.r_hat, ws.p, ws.v, ws.s, ws.t, ws.p_hat, ws.s_hat))
+            throw std::invalid_argument("BiCGSTAB workspace does not match the operator");
+
+        T b_norm = norm<T>(b);
+        if (b_norm == 0) {
+            std::fill(x.begin(), x.end(), T{});
+            return {0, T{}, true};
+        }
+
+        std::span<T> r{ws.r}, r_hat{ws.r_hat}, p{ws.p}, v{ws.v}, s{ws.s}, t{ws.t}, p_hat{ws.p_hat},
+            s_hat{ws.s_hat};
+
+        residual<T>(a, b, x, r);
+        T res = norm<T>(r) / b_norm;
+        if (res <= options.tolerance)
+            return {0, res, true};
+
+        std::copy(r.begin(), r.end(), r_hat.begin());
+        std::fill(p.begin(), p.end(), T{});
+        std::fill(v.begin(), v.end(), T{});
+        T rho = 1, alpha = 1, omega = 1;
+
+        for (size_t k = 1; k <= options.max_iterations; ++k) {
+            T rho_next = dot<T>(r_hat, r);
+            if (rho_next == 0 || omega == 0)
+                return {k, res, false};  // Breakdown
+
+            T beta = (rho_next / rho) * (alpha / omega);
+            rho = rho_next;
+            for (size_t i = 0; i < p.size(); ++i)
+                p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+            precond.apply(p, p_hat);
+            a.apply(p_hat, v);
+            T r_hat_v = dot<T>(r_hat, v);
+            if (r_hat_v == 0)
+                return {k, res, false};
+            alpha = rho / r_hat_v;
+
+            for (size_t i = 0; i < s.size(); ++i)
+                s[i] = r[i] - alpha * v[i];
+
+            T s_res = norm<T>(s) / b_norm;
+            if (s_res <= options.tolerance) {
+                axpy<T>(alpha, p_hat, x);
+                notify(monitor, k, s_res);
+                return {k, s_res, true};
+            }
+
+            precond.apply(s, s_hat);
+            a.apply(s_hat, t);
+            T t_t = dot<T>(t, t);
+            omega = t_t == 0 ? T{} : dot<T>(t, s) / t_t;
+
+            for (size_t i = 0; i < x.size(); ++i) {
+                x[i] += alpha * p_hat[i] + omega * s_hat[i];
+                r[i] = s[i] - omega * t[i];
+            }
+
+            res = norm<T>(r) / b_norm;
+            if (!notify(monitor, k, res))
+                return {k, res, false};
+            if (res <= options.tolerance)
+                return {k, res, true};
+        }
+
+        return {options.max_iterations, res, false};
+    }
+
+    /*
+     * GMRES
+     */
+
+    // Restarted, right preconditioned GMRES(m) using Givens rotations on the
+    // Hessenberg matrix. m comes from the workspace.
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> gmres(const Op& a,
+                           std::type_identity_t<std::span<const T>> b,
+                           std::type_identity_t<std::span<T>> x,
+                           gmres_workspace<T>& ws,
+                           const std::type_identity_t<krylov_options<T>>& options = {},
+                           const Precond& precond = {},
+                           Monitor monitor = {}) {
+        using namespace m_krylov;
+        check_sizes<Op, T>(a, b, x);
+        if (ws.n != a.size() || ws.m == 0)
+            throw std::invalid_argument("GMRES workspace does not match the operator");
+
+        T b_norm = norm<T>(b);
+        if (b_norm == 0) {
+            std::fill(x.begin(), x.end(), T{});
+            return {0, T{}, true};
+        }
+
+        const size_t m = ws.m;
+        std::span<T> w{ws.w}, z{ws.z};
+        size_t iteration = 0;
+        T res = 0;
+
+        while (iteration < options.max_iterations) {
+            std::span<T> v0 = ws.v(0);
+            residual<T>(a, b, x, v0);
+            T beta = norm<T>(v0);
+            res = beta / b_norm;
+            if (res <= options.tolerance)
+                return {iteration, res, true};
+
+            for (T& value : v0)
+                value /= beta;
+            std::fill(ws.g.begin(), ws.g.end(), T{});
+            ws.g[0] = beta;
+
+            size_t j = 0;
+            bool done = false;
+            for (; j < m && iteration < options.max_iterations; ++j) {
+                ++iteration;
+
+                // w = A M^-1 v_j, orthogonalized against the basis (modified Gram-Schmidt)
+                precond.apply(ws.v(j), z);
+                a.apply(z, w);
+                for (size_t i = 0; i <= j; ++i) {
+                    T h = dot<T>(w, ws.v(i));
+                    ws.h(i, j) = h;
+                    axpy<T>(-h, ws.v(i), w);
+                }
+                T w_norm = norm<T>(w);
+                ws.h(j + 1, j) = w_norm;
+
+                // Apply the previous rotations to the new column, then eliminate h(j + 1, j)
+                for (size_t i = 0; i < j; ++i) {
+                    T temp = ws.cs[i] * ws.h(i, j) + ws.sn[i] * ws.h(i + 1, j);
+                    ws.h(i + 1, j) = -ws.sn[i] * ws.h(i, j) + ws.cs[i] * ws.h(i + 1, j);
+                    ws.h(i, j) = temp;
+                }
+                T denom = std::hypot(ws.h(j, j), ws.h(j + 1, j));
+                ws.cs[j] = denom == 0 ? T{1} : ws.h(j, j) / denom;
+                ws.sn[j] = denom == 0 ? T{} : ws.h(j + 1, j) / denom;
+                ws.h(j, j) = denom;
+                ws.h(j + 1, j) = 0;
+                ws.g[j + 1] = -ws.sn[j] * ws.g[j];
+                ws.g[j] = ws.cs[j] * ws.g[j];
+
+                res = std::abs(ws.g[j + 1]) / b_norm;
+                if (!notify(monitor, iteration, res))
+                    return {iteration, res, false};
+                if (res <= options.tolerance || w_norm == 0) {
+                    ++j;
+                    done = true;
+                    break;
+                }
+
+                std::span<T> next = ws.v(j + 1);
+                for (size_t i = 0; i < next.size(); ++i)
+                    next[i] = w[i] / w_norm;
+            }
+
+            // Solve the j x j upper triangular system H y = g, then x += M^-1 V y
+            for (size_t i = j; i > 0; --i) {
+                size_t row = i - 1;
+                T sum = ws.g[row];
+                for (size_t k = row + 1; k < j; ++k)
+                    sum -= ws.h(row, k) * ws.y[k];
+                ws.y[row] = sum / ws.h(row, row);
+            }
+
+            std::fill(w.begin(), w.end(), T{});
+            for (size_t i = 0; i < j; ++i)
+                axpy<T>(ws.y[i], ws.v(i), w);
+            precond.apply(w, z);
+            axpy<T>(T{1}, z, x);
+
+            if (done) {
+                // The rotated residual estimate can drift from the true residual
+                residual<T>(a, b, x, w);
+                res = norm<T>(w) / b_norm;
+                if (res <= options.tolerance)
+                    return {iteration, res, true};
+            }
+        }
+
+        return {iteration, res, false};
+    }
+
+    /*
+     * ALLOCATING CONVENIENCE OVERLOADS
+     */
+
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> cg(const Op& a,
+                        std::type_identity_t<std::span<const T>> b,
+                        std::type_identity_t<std::span<T>> x,
+                        const std::type_identity_t<krylov_options<T>>& options = {},
+                        const Precond& precond = {},
+                        Monitor monitor = {}) {
+        cg_workspace<T> ws{a.size()};
+        return cg(a, b, x, ws, options, precond, std::move(monitor));
+    }
+
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> bicgstab(const Op& a,
+                              std::type_identity_t<std::span<const T>> b,
+                              std::type_identity_t<std::span<T>> x,
+                              const std::type_identity_t<krylov_options<T>>& options = {},
+                              const Precond& precond = {},
+                              Monitor monitor = {}) {
+        bicgstab_workspace<T> ws{a.size()};
+        return bicgstab(a, b, x, ws, options, precond, std::move(monitor));
+    }
+
+    template <linear_operator Op,
+              typename T = typename Op::value_type,
+              preconditioner<T> Precond = identity_preconditioner<T>,
+              typename Monitor = m_krylov::no_monitor>
+        requires std::floating_point<T>
+    krylov_result<T> gmres(const Op& a,
+                           std::type_identity_t<std::span<const T>> b,
+                           std::type_identity_t<std::span<T>> x,
+                           const std::type_identity_t<krylov_options<T>>& options = {},
+                           const Precond& precond = {},
+                           Monitor monitor = {}) {
+        gmres_workspace<T> ws{a.size(), std::max<size_t>(1, std::min(options.restart, a.size()))};
+        return gmres(a, b, x, ws, options, precond, std::move(monitor));
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_KRYLOV_HPP
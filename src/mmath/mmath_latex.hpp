@@ -0,0 +1,307 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_LATEX_HPP
+#define MMATH_MMATH_LATEX_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_format.hpp"
+
+namespace mmath {
+
+    enum class latex_environment { MATRIX, PMATRIX, BMATRIX };
+
+    struct latex_options {
+        latex_environment environment = latex_environment::PMATRIX;
+        // Draws a vertical bar after this many columns, as for an augmented
+        // matrix [A | b]. Zero draws no bar.
+        size_t augment_column = 0;
+        // Same meaning as format_options::precision.
+        int precision = -1;
+        std::chars_format float_format = std::chars_format::general;
+    };
+
+    namespace m_latex {
+
+        inline std::string_view environment_name(latex_environment environment) {
+            switch (environment) {
+                case latex_environment::PMATRIX: return "pmatrix";
+                case latex_environment::BMATRIX: return "bmatrix";
+                default: return "matrix";
+            }
+        }
+
+        // Delimiters wrapped around an array environment when a bar is needed,
+        // since the matrix environments have no column specification.
+        inline std::string_view left_delimiter(latex_environment environment) {
+            switch (environment) {
+                case latex_environment::PMATRIX: return "\\left(";
+                case latex_environment::BMATRIX: return "\\left[";
+                default: return "";
+            }
+        }
+
+        inline std::string_view right_delimiter(latex_environment environment) {
+            switch (environment) {
+                case latex_environment::PMATRIX: return "\\right)";
+                case latex_environment::BMATRIX: return "\\right]";
+                default: return "";
+            }
+        }
+
+        // Walks the source in place; every token is a view into it.
+        class scanner {
+          private:
+            std::string_view text;
+            size_t pos = 0;
+
+          public:
+            explicit scanner(std::string_view text) : text(text) {}
+
+            void skip_space() {
+                while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r' ||
+                                             text[pos] == '\n' || text[pos] == '~'))
+                    ++pos;
+            }
+
+            [[nodiscard]] bool done() {
+                skip_space();
+                return pos == text.size();
+            }
+
+            bool consume(std::string_view literal) {
+                skip_space();
+                if (text.substr(pos, literal.size()) != literal)
+                    return false;
+                pos += literal.size();
+                return true;
+            }
+
+            void expect(std::string_view literal) {
+                if (!consume(literal))
+                    throw std::invalid_argument("Expected " + std::string{literal} + " in LaTeX matrix");
+            }
+
+            // Contents of the next {...} group.
+            std::string_view group() {
+                expect("{");
+                size_t end = text.find('}', pos);
+                if (end == std::string_view::npos)
+                    throw std::invalid_argument("Unterminated group in LaTeX matrix");
+                std::string_view contents = text.substr(pos, end - pos);
+                pos = end + 1;
+                return contents;
+            }
+
+            // Text up to the next cell separator, row separator or \end, trimmed.
+            // Returns the separator that ended the cell.
+            std::string_view cell(std::string_view& contents) {
+                skip_space();
+                size_t start = pos;
+                while (pos < text.size()) {
+                    if (text[pos] == '&') {
+                        contents = trim(text.substr(start, pos - start));
+                        ++pos;
+                        return "&";
+                    }
+                    if (text.compare(pos, 2, "\\\\") == 0) {
+                        contents = trim(text.substr(start, pos - start));
+                        pos += 2;
+                        return "\\\\";
+                    }
+                    if (text.compare(pos, 4, "\\end") == 0) {
+                        contents = trim(text.substr(start, pos - start));
+                        return "\\end";
+                    }
+                    ++pos;
+                }
+                throw std::invalid_argument("Missing \\end in LaTeX matrix");
+            }
+
+            static std::string_view trim(std::string_view s) {
+                while (!s.empty() && (s.front() == ' ' || s.front() == '\n' || s.front() == '\t' || s.front() == '\r' ||
+                                      s.front() == '~' || s.front() == '{'))
+                    s.remove_prefix(1);
+                while (!s.empty() && (s.back() == ' ' || s.back() == '\n' || s.back() == '\t' || s.back() == '\r' ||
+                                      s.back() == '~' || s.back() == '}'))
+                    s.remove_suffix(1);
+                return s;
+            }
+        };
+
+        template <numeric T>
+        T parse_cell(std::string_view cell) {
+            if (!cell.empty() && cell.front() == '+')
+                cell.remove_prefix(1);
+            T value{};
+            auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+            if (ec != std::errc{} || ptr != cell.data() + cell.size())
+                throw std::invalid_argument("Invalid LaTeX matrix entry " + std::string{cell});
+            return value;
+        }
+    }  // namespace m_latex
+
+    /*
+     * SERIALIZATION
+     */
+
+    // Appends to the caller's buffer, so a batch of matrices can be written
+    // without allocating once the buffer has grown.
+    template <expression_printable T>
+    void to_latex(format_buffer& out, const matrix_base<T>& matrix, const latex_options& options = {}) {
+        const size_t rows = matrix.size_row(), cols = matrix.size_col();
+        const bool augmented = options.augment_column > 0 && options.augment_column < cols;
+
+        format_options element;
+        element.precision = options.precision;
+        element.float_format = options.float_format;
+
+        if (augmented) {
+            out.append(m_latex::left_delimiter(options.environment));
+            out.append("\\begin{array}{");
+            for (size_t j = 0; j < cols; ++j) {
+                if (j == options.augment_column)
+                    out.append("|");
+                out.append("c");
+            }
+            out.append("}\n");
+        } else {
+            out.append("\\begin{");
+            out.append(m_latex::environment_name(options.environment));
+            out.append("}\n");
+        }
+
+        const T* data = matrix.raw_data();
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                if (j != 0)
+                    out.append(" & ");
+                m_format::append_value(out, data[i * cols + j], element);
+            }
+            out.append(i + 1 == rows ? "\n" : " \\\\\n");
+        }
+
+        if (augmented) {
+            out.append("\\end{array}");
+            out.append(m_latex::right_delimiter(options.environment));
+        } else {
+            out.append("\\end{");
+            out.append(m_latex::environment_name(options.environment));
+            out.append("}");
+        }
+    }
+
+    template <expression_printable T>
+    void to_latex(std::ostream& os, const matrix_base<T>& matrix, const latex_options& options = {}) {
+        format_buffer& out = m_format::scratch();
+        out.clear();
+        to_latex(out, matrix, options);
+        out.flush_to(os);
+    }
+
+    template <expression_printable T>
+    std::string to_latex(const matrix_base<T>& matrix, const latex_options& options = {}) {
+        format_buffer out;
+        to_latex(out, matrix, options);
+        return std::string{out.view()};
+    }
+
+    /*
+     * DESERIALIZATION
+     */
+
+    // Reads matrix, pmatrix, bmatrix, Bmatrix, vmatrix, Vmatrix and array
+    // environments, optionally wrapped in \left and \right. augment_column is
+    // set to the number of columns before a | in an array column specification,
+    // or zero.
+    template <numeric T>
+    matrix_base<T> from_latex(std::string_view text, size_t& augment_column) {
+        m_latex::scanner scan{text};
+        augment_column = 0;
+
+        bool wrapped = scan.consume("\\left");
+        if (wrapped && !scan.consume("(") && !scan.consume("[") && !scan.consume("\\{") && !scan.consume("|") &&
+            !scan.consume("."))
+            throw std::invalid_argument("Unknown \\left delimiter in LaTeX matrix");
+
+        scan.expect("\\begin");
+        std::string_view environment = scan.group();
+        if (environment == "array") {
+            size_t columns = 0;
+            for (char c : scan.group()) {
+                if (c == '|' && columns > 0 && augment_column == 0)
+                    augment_column = columns;
+                else if (c == 'c' || c == 'l' || c == 'r')
+                    ++columns;
+            }
+        } else if (environment != "matrix" && environment != "pmatrix" && environment != "bmatrix" &&
+                   environment != "Bmatrix" && environment != "vmatrix" && environment != "Vmatrix") {
+            throw std::invalid_argument("Unsupported LaTeX environment " + std::string{environment});
+        }
+
+        std::vector<T> values;
+        size_t cols = 0, current = 0, rows = 0;
+        for (;;) {
+            std::string_view contents;
+            std::string_view separator = scan.cell(contents);
+
+            // A trailing \\ before \end leaves an empty final row
+            bool empty_row = contents.empty() && current == 0 && separator != "&";
+            if (!empty_row) {
+                values.push_back(m_latex::parse_cell<T>(contents));
+                ++current;
+            }
+
+            if (separator == "&")
+                continue;
+
+            if (current > 0) {
+                if (rows == 0)
+                    cols = current;
+                else if (current != cols)
+                    throw std::invalid_argument("Every row of a LaTeX matrix must have the same number of columns");
+                ++rows;
+            }
+            current = 0;
+
+            if (separator == "\\end")
+                break;
+        }
+
+        scan.expect("\\end");
+        if (scan.group() != environment)
+            throw std::invalid_argument("Mismatched \\end in LaTeX matrix");
+        if (wrapped) {
+            scan.expect("\\right");
+            if (!scan.consume(")") && !scan.consume("]") && !scan.consume("\\}") && !scan.consume("|") &&
+                !scan.consume("."))
+                throw std::invalid_argument("Unknown \\right delimiter in LaTeX matrix");
+        }
+        if (!scan.done())
+            throw std::invalid_argument("Unexpected text after LaTeX matrix");
+
+        if (rows == 0)
+            return matrix_base<T>{};
+
+        matrix_base<T> result{rows, cols};
+        std::copy(values.begin(), values.end(), result.raw_data());
+        return result;
+    }
+
+    template <numeric T>
+    matrix_base<T> from_latex(std::string_view text) {
+        size_t augment_column;
+        return from_latex<T>(text, augment_column);
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_LATEX_HPP
@@ -0,0 +1,112 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_LU_HPP
+#define MMATH_MMATH_LU_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_triangular.hpp"
+
+namespace mmath {
+    namespace m_kernel {
+
+        // In place LU factorization with partial pivoting, P A = L U, of the
+        // n x n row major matrix a. L is unit lower and U upper triangular, both
+        // stored over a. Row j was swapped with row pivots[j] at step j.
+        //
+        // Right looking and blocked: each panel of trsm_tuning<T>().block_size
+        // columns is factored unblocked, then the trailing matrix is updated with
+        // a triangular solve and a single gemm. after_panel, when set, is called
+        // with the number of columns done after each panel; an exception thrown
+        // from it abandons the factorization.
+        template <std::floating_point T>
+        void lu_factor(size_t n,
+                       T* a,
+                       size_t lda,
+                       size_t* pivots,
+                       const std::function<void(size_t)>& after_panel = {}) {
+            m_stats::scope stats{operation::lu_factor, 2 * n * n * n / 3, n * n};
+            m_trace::scope<T> trace{operation::lu_factor, n, n};
+            const size_t nb = std::max<size_t>(trsm_tuning<T>().block_size, 1);
+
+            for (size_t j0 = 0; j0 < n; j0 += nb) {
+                const size_t jb = std::min(nb, n - j0);
+
+                for (size_t j = j0; j < j0 + jb; ++j) {
+                    size_t p = j;
+                    for (size_t i = j + 1; i < n; ++i) {
+                        if (std::abs(a[i * lda + j]) > std::abs(a[p * lda + j]))
+                            p = i;
+                    }
+                    pivots[j] = p;
+                    if (a[p * lda + j] == T{})
+                        throw std::domain_error("Matrix is singular");
+                    if (p != j)
+                        std::swap_ranges(a + j * lda, a + j * lda + n, a + p * lda);
+
+                    const T pivot = a[j * lda + j];
+                    const T* u_row = a + j * lda;
+                    for (size_t i = j + 1; i < n; ++i) {
+                        T* row = a + i * lda;
+                        const T l = row[j] / pivot;
+                        row[j] = l;
+                        for (size_t c = j + 1; c < j0 + jb; ++c)
+                            row[c] = row[c] - l * u_row[c];
+                    }
+                }
+
+                const size_t rest = j0 + jb;
+                if (rest < n) {
+                    trsm(jb, n - rest, a + j0 * lda + j0, lda, a + j0 * lda + rest, lda, triangle_type::LOWER,
+                         diagonal_type::UNIT);
+                    gemm<T, true>(n - rest, n - rest, jb, a + rest * lda + j0, lda, 1, a + j0 * lda + rest, lda,
+                                  a + rest * lda + rest, lda);
+                }
+                if (after_panel)
+                    after_panel(rest);
+            }
+        }
+
+        // Solves A x = b in place of x using the output of lu_factor.
+        template <std::floating_point T>
+        void lu_solve(size_t n, const T* lu, size_t lda, const size_t* pivots, T* x) {
+            m_stats::scope stats{operation::lu_solve, 2 * n * n, n};
+            m_trace::scope<T> trace{operation::lu_solve, n, 1};
+            for (size_t j = 0; j < n; ++j) {
+                if (pivots[j] != j)
+                    std::swap(x[j], x[pivots[j]]);
+            }
+            trsv(n, lu, lda, x, triangle_type::LOWER, diagonal_type::UNIT);
+            trsv(n, lu, lda, x, triangle_type::UPPER);
+        }
+    }  // namespace m_kernel
+
+    // Returns x solving A x = b by LU factorization with partial pivoting.
+    template <std::floating_point T>
+    std::vector<T> lu_solve(const matrix_base<T>& a, std::vector<T> b) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to solve a linear system");
+        if (a.size_row() != b.size())
+            throw std::domain_error("The right hand side must have as many entries as the matrix has rows");
+
+        const size_t n = a.size_row();
+        std::vector<T> lu(a.raw_data(), a.raw_data() + n * n);
+        std::vector<size_t> pivots(n);
+        m_kernel::lu_factor(n, lu.data(), n, pivots.data());
+        m_kernel::lu_solve(n, lu.data(), n, pivots.data(), b.data());
+        return b;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_LU_HPP
@@ -0,0 +1,384 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_MATRIXPROPERTIES_HPP
+#define MMATH_MMATH_MATRIXPROPERTIES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+#include "mmath_concepts.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    enum class matrix_property : unsigned {
+        NONE = 0,
+        ZERO = 1u << 0,
+        DIAGONAL = 1u << 1,
+        SCALAR = 1u << 2,
+        IDENTITY = 1u << 3,
+        UPPER_TRIANGULAR = 1u << 4,
+        LOWER_TRIANGULAR = 1u << 5,
+        SYMMETRIC = 1u << 6,
+        SKEW_SYMMETRIC = 1u << 7,
+        ALL = (1u << 8) - 1
+    };
+
+    constexpr matrix_property operator|(matrix_property a, matrix_property b) {
+        return static_cast<matrix_property>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    constexpr matrix_property operator&(matrix_property a, matrix_property b) {
+        return static_cast<matrix_property>(static_cast<unsigned>(a) & static_cast<unsigned>(b));
+    }
+
+    // Result of a structural scan. Only the properties that were requested from
+    // the analyzer are meaningful, every other flag reads as false.
+    class matrix_properties {
+      private:
+        matrix_property flags;
+
+      public:
+        constexpr matrix_properties() : flags(matrix_property::NONE) {}
+
+        constexpr explicit matrix_properties(matrix_property flags) : flags(flags) {}
+
+        [[nodiscard]] constexpr bool has(matrix_property p) const { return (flags & p) == p; }
+
+        [[nodiscard]] constexpr matrix_property get_flags() const { return flags; }
+
+        [[nodiscard]] constexpr bool is_zero() const { return has(matrix_property::ZERO); }
+
+        [[nodiscard]] constexpr bool is_diagonal() const { return has(matrix_property::DIAGONAL); }
+
+        [[nodiscard]] constexpr bool is_scalar() const { return has(matrix_property::SCALAR); }
+
+        [[nodiscard]] constexpr bool is_identity() const { return has(matrix_property::IDENTITY); }
+
+        [[nodiscard]] constexpr bool is_upper_triangular() const { return has(matrix_property::UPPER_TRIANGULAR); }
+
+        [[nodiscard]] constexpr bool is_lower_triangular() const { return has(matrix_property::LOWER_TRIANGULAR); }
+
+        [[nodiscard]] constexpr bool is_triangular() const { return is_upper_triangular() || is_lower_triangular(); }
+
+        [[nodiscard]] constexpr bool is_symmetric() const { return has(matrix_property::SYMMETRIC); }
+
+        [[nodiscard]] constexpr bool is_skew_symmetric() const { return has(matrix_property::SKEW_SYMMETRIC); }
+
+        constexpr bool operator==(const matrix_properties&) const = default;
+    };
+
+    namespace m_prop {
+
+        // Square tile edge used when pairing the upper and lower triangle. Two
+        // tiles of doubles fit comfortably in L1/L2.
+        constexpr size_t tile_size = 64;
+
+        // Number of elements above which the scan is split across the thread pool.
+        constexpr size_t parallel_threshold = 1u << 18;
+
+        // Flags tracked during the off-diagonal pass. The diagonal derived
+        // properties are built from these plus the diagonal scan.
+        constexpr unsigned off_upper = 1u << 0;  // Everything below the diagonal is zero
+        constexpr unsigned off_lower = 1u << 1;  // Everything above the diagonal is zero
+        constexpr unsigned off_symmetric = 1u << 2;
+        constexpr unsigned off_skew = 1u << 3;
+
+        template <expression T>
+        bool all_zero(const T* data, size_t count) {
+            constexpr size_t block = 4096;
+
+            for (size_t start = 0; start < count; start += block) {
+                size_t stop = std::min(count, start + block);
+                // Branch free within a block so arithmetic types vectorize, exit
+                // between blocks as soon as a nonzero has been seen.
+                bool nonzero = false;
+                for (size_t i = start; i < stop; ++i)
+                    nonzero |= static_cast<bool>(data[i] != 0);
+                if (nonzero)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Scans the tile pair (tile_i, tile_j) with tile_i <= tile_j, comparing
+        // every strictly upper element with its mirrored lower element. Returns
+        // the off_* flags that were disproved by this tile.
+        template <expression T>
+        unsigned scan_tile_pair(const T* data, size_t n, size_t tile_i, size_t tile_j, unsigned live) {
+            size_t i_begin = tile_i * tile_size, i_end = std::min(n, i_begin + tile_size);
+            size_t j_begin = tile_j * tile_size, j_end = std::min(n, j_begin + tile_size);
+
+            bool upper_nonzero = false, lower_nonzero = false, not_symmetric = false, not_skew = false;
+
+            for (size_t i = i_begin; i < i_end; ++i) {
+                const T* row = data + i * n;
+                for (size_t j = std::max(j_begin, i + 1); j < j_end; ++j) {
+                    const T& u = row[j];
+                    const T& l = data[j * n + i];
+                    upper_nonzero |= static_cast<bool>(u != 0);
+                    lower_nonzero |= static_cast<bool>(l != 0);
+                    if (live & (off_symmetric | off_skew)) {
+                        not_symmetric |= static_cast<bool>(u != l);
+                        not_skew |= static_cast<bool>(u + l != 0);
+                    }
+                }
+            }
+
+            unsigned cleared = 0;
+            if (upper_nonzero)
+                cleared |= off_lower;
+            if (lower_nonzero)
+                cleared |= off_upper;
+            if (not_symmetric)
+                cleared |= off_symmetric;
+            if (not_skew)
+                cleared |= off_skew;
+
+            return cleared & live;
+        }
+
+        template <expression T>
+        unsigned scan_off_diagonal(const T* data, size_t n, unsigned wanted) {
+            size_t num_tiles = (n + tile_size - 1) / tile_size;
+            std::atomic<unsigned> live{wanted};
+
+            auto scan_rows = [&](size_t lo, size_t hi) {
+                for (size_t ti = lo; ti < hi; ++ti) {
+                    for (size_t tj = ti; tj < num_tiles; ++tj) {
+                        unsigned current = live.load(std::memory_order_relaxed);
+                        if (current == 0)
+                            return;
+                        unsigned cleared = scan_tile_pair(data, n, ti, tj, current);
+                        if (cleared != 0)
+                            live.fetch_and(~cleared, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            if (n * n < parallel_threshold) {
+                scan_rows(0, num_tiles);
+            } else {
+                m_parallel::parallel_for(0, num_tiles, 1, scan_rows);
+            }
+
+            return live.load();
+        }
+
+        // Computes the requested properties of the row major rows x cols matrix
+        // stored at data in a single pass, skipping each flag's work once it has
+        // been disproved.
+        template <expression T>
+        matrix_properties analyze(const T* data, size_t rows, size_t cols, matrix_property wanted = matrix_property::ALL) {
+            using mp = matrix_property;
+
+            if (rows != cols) {
+                // Every structural property other than zero requires a square matrix.
+                if ((wanted & mp::ZERO) == mp::ZERO && all_zero(data, rows * cols))
+                    return matrix_properties{mp::ZERO};
+                return matrix_properties{};
+            }
+
+            size_t n = rows;
+
+            // The diagonal is cheap, so scan it first and use it to drop off-diagonal
+            // work that can no longer change the answer.
+            bool diag_equal = true, diag_one = true, diag_zero = true;
+            for (size_t i = 0; i < n; ++i) {
+                const T& d = data[i * n + i];
+                diag_equal &= static_cast<bool>(d == data[0]);
+                diag_one &= static_cast<bool>(d == 1);
+                diag_zero &= static_cast<bool>(d == 0);
+            }
+
+            bool want_zero = (wanted & mp::ZERO) == mp::ZERO && diag_zero;
+            bool want_scalar = (wanted & mp::SCALAR) == mp::SCALAR && diag_equal;
+            bool want_identity = (wanted & mp::IDENTITY) == mp::IDENTITY && diag_one;
+            bool want_diagonal = (wanted & mp::DIAGONAL) == mp::DIAGONAL || want_zero || want_scalar || want_identity;
+
+            unsigned off_wanted = 0;
+            if (want_diagonal || (wanted & mp::UPPER_TRIANGULAR) == mp::UPPER_TRIANGULAR)
+                off_wanted |= off_upper;
+            if (want_diagonal || (wanted & mp::LOWER_TRIANGULAR) == mp::LOWER_TRIANGULAR)
+                off_wanted |= off_lower;
+            if ((wanted & mp::SYMMETRIC) == mp::SYMMETRIC)
+                off_wanted |= off_symmetric;
+            if ((wanted & mp::SKEW_SYMMETRIC) == mp::SKEW_SYMMETRIC && diag_zero)
+                off_wanted |= off_skew;
+
+            unsigned off = off_wanted == 0 ? 0 : scan_off_diagonal(data, n, off_wanted);
+
+            bool upper = off & off_upper;
+            bool lower = off & off_lower;
+            bool diagonal = upper && lower;
+
+            unsigned flags = 0;
+            if (diagonal && want_zero)
+                flags |= static_cast<unsigned>(mp::ZERO);
+            if (diagonal)
+                flags |= static_cast<unsigned>(mp::DIAGONAL);
+            if (diagonal && want_scalar)
+                flags |= static_cast<unsigned>(mp::SCALAR);
+            if (diagonal && want_identity)
+                flags |= static_cast<unsigned>(mp::IDENTITY);
+            if (upper)
+                flags |= static_cast<unsigned>(mp::UPPER_TRIANGULAR);
+            if (lower)
+                flags |= static_cast<unsigned>(mp::LOWER_TRIANGULAR);
+            if (off & off_symmetric)
+                flags |= static_cast<unsigned>(mp::SYMMETRIC);
+            if (off & off_skew)
+                flags |= static_cast<unsigned>(mp::SKEW_SYMMETRIC);
+
+            return matrix_properties{static_cast<mp>(flags) & wanted};
+        }
+
+        /*
+         * PROPERTY CACHE
+         */
+
+        struct cache_counters {
+            std::atomic<size_t> hits{0};
+            std::atomic<size_t> misses{0};
+        };
+
+        inline cache_counters& global_cache_counters() {
+            static cache_counters counters;
+            return counters;
+        }
+
+        // Memoizes derived values of a matrix until the next mutation. Lookups
+        // and stores are guarded so const members stay safe to call from several
+        // threads on the same matrix.
+        template <expression T>
+        class property_cache {
+          private:
+            mutable std::mutex mutex;
+            // Set while anything is cached, so invalidating an empty cache, as
+            // every element write does, skips the lock.
+            std::atomic<bool> valid{false};
+            unsigned known = 0;
+            matrix_property values = matrix_property::NONE;
+            std::optional<T> trace;
+
+            static void record(bool hit) {
+                auto& counters = global_cache_counters();
+                (hit ? counters.hits : counters.misses).fetch_add(1, std::memory_order_relaxed);
+            }
+
+          public:
+            property_cache() = default;
+
+            property_cache(const property_cache& other) {
+                std::lock_guard lock{other.mutex};
+                valid.store(other.valid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                known = other.known;
+                values = other.values;
+                trace = other.trace;
+            }
+
+            property_cache& operator=(const property_cache& other) {
+                if (this == &other)
+                    return *this;
+                std::scoped_lock lock{mutex, other.mutex};
+                valid.store(other.valid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                known = other.known;
+                values = other.values;
+                trace = other.trace;
+                return *this;
+            }
+
+            std::optional<matrix_properties> lookup(matrix_property wanted) const {
+                std::lock_guard lock{mutex};
+                bool hit = (known & static_cast<unsigned>(wanted)) == static_cast<unsigned>(wanted);
+                record(hit);
+                if (!hit)
+                    return std::nullopt;
+                return matrix_properties{values & wanted};
+            }
+
+            void store(matrix_property wanted, matrix_properties result) {
+                std::lock_guard lock{mutex};
+                unsigned mask = static_cast<unsigned>(wanted);
+                valid.store(true, std::memory_order_relaxed);
+                known |= mask;
+                values = static_cast<matrix_property>((static_cast<unsigned>(values) & ~mask) |
+                                                      (static_cast<unsigned>(result.get_flags()) & mask));
+            }
+
+            std::optional<T> lookup_trace() const {
+                std::lock_guard lock{mutex};
+                record(trace.has_value());
+                return trace;
+            }
+
+            void store_trace(const T& value) {
+                std::lock_guard lock{mutex};
+                valid.store(true, std::memory_order_relaxed);
+                trace = value;
+            }
+
+            void invalidate() {
+                if (!valid.load(std::memory_order_relaxed))
+                    return;
+                std::lock_guard lock{mutex};
+                valid.store(false, std::memory_order_relaxed);
+                known = 0;
+                values = matrix_property::NONE;
+                trace.reset();
+            }
+        };
+
+        // Stand in used when caching is compiled out. Every lookup misses and the
+        // whole object folds away.
+        template <expression T>
+        class null_property_cache {
+          public:
+            std::optional<matrix_properties> lookup(matrix_property) const { return std::nullopt; }
+
+            void store(matrix_property, matrix_properties) {}
+
+            std::optional<T> lookup_trace() const { return std::nullopt; }
+
+            void store_trace(const T&) {}
+
+            void invalidate() {}
+        };
+    }  // namespace m_prop
+
+    // Define MMATH_PROPERTY_CACHE before including mmath to memoize trace and
+    // structural properties on every matrix_base until it is next mutated.
+#ifdef MMATH_PROPERTY_CACHE
+    template <expression T>
+    using matrix_property_cache = m_prop::property_cache<T>;
+#else
+    template <expression T>
+    using matrix_property_cache = m_prop::null_property_cache<T>;
+#endif
+
+    struct property_cache_statistics {
+        size_t hits;
+        size_t misses;
+    };
+
+    // Hit/miss totals across every matrix since start up or the last reset.
+    // Always zero unless MMATH_PROPERTY_CACHE is defined.
+    inline property_cache_statistics property_cache_stats() {
+        auto& counters = m_prop::global_cache_counters();
+        return {counters.hits.load(), counters.misses.load()};
+    }
+
+    inline void reset_property_cache_stats() {
+        auto& counters = m_prop::global_cache_counters();
+        counters.hits = 0;
+        counters.misses = 0;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_MATRIXPROPERTIES_HPP
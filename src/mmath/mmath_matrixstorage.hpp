@@ -0,0 +1,431 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_MATRIXSTORAGE_HPP
+#define MMATH_MMATH_MATRIXSTORAGE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mmath_instrumentation.hpp"
+
+namespace mmath {
+
+    // Selects constructors that leave the elements default initialized, which
+    // for trivial types means indeterminate, for callers that overwrite every
+    // element anyway.
+    struct for_overwrite_t {
+        explicit for_overwrite_t() = default;
+    };
+
+    inline constexpr for_overwrite_t for_overwrite{};
+
+    namespace m_storage {
+
+        // Deleter of memory that is borrowed rather than owned.
+        struct non_owning {
+            void operator()(const void*) const noexcept {}
+        };
+
+        // Element buffer of a fixed size on the heap. It either allocates the
+        // elements itself or adopts memory handed to it, a std::vector<T> or a
+        // raw pointer with the deleter that frees it, without copying. Copies
+        // always allocate their own elements.
+        template <typename T>
+        class heap_buffer {
+          private:
+            T* values = nullptr;
+            size_t count = 0;
+            // Frees adopted memory, null when the elements came from new T[]
+            void (*release)(T*, void*) = nullptr;
+            void* owner = nullptr;
+            // Adopted with the non_owning deleter
+            bool borrowing = false;
+
+            void reset() {
+                if (release)
+                    release(values, owner);
+                else
+                    delete[] values;
+                values = nullptr;
+                count = 0;
+                release = nullptr;
+                owner = nullptr;
+                borrowing = false;
+            }
+
+          public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            heap_buffer() = default;
+
+            heap_buffer(size_t size, for_overwrite_t) : values(size ? new T[size] : nullptr), count(size) {
+                if (size)
+                    m_stats::record_allocation(size * sizeof(T));
+            }
+
+            heap_buffer(size_t size, const T& value) : heap_buffer(size, for_overwrite) {
+                std::fill_n(values, size, value);
+            }
+
+            heap_buffer(const std::vector<T>& source) : heap_buffer(source.size(), for_overwrite) {
+                std::copy(source.begin(), source.end(), values);
+            }
+
+            heap_buffer(std::vector<T>&& source) {
+                if (source.empty())
+                    return;
+                auto* adopted = new std::vector<T>(std::move(source));
+                values = adopted->data();
+                count = adopted->size();
+                owner = adopted;
+                release = [](T*, void* owner) { delete static_cast<std::vector<T>*>(owner); };
+            }
+
+            // Takes ownership of size elements at memory, freed by deleter(memory).
+            // A stateless deleter is stored without allocating.
+            template <typename Deleter>
+            heap_buffer(T* memory, size_t size, Deleter deleter)
+                : values(memory), count(size), borrowing(std::is_same_v<Deleter, non_owning>) {
+                if constexpr (std::is_empty_v<Deleter> && std::is_default_constructible_v<Deleter>) {
+                    release = [](T* values, void*) { Deleter{}(values); };
+                } else {
+                    try {
+                        owner = new Deleter(std::move(deleter));
+                    } catch (...) {
+                        deleter(memory);
+                        throw;
+                    }
+                    release = [](T* values, void* owner) {
+                        auto* stored = static_cast<Deleter*>(owner);
+                        (*stored)(values);
+                        delete stored;
+                    };
+                }
+            }
+
+            heap_buffer(const heap_buffer& other) : heap_buffer(other.count, for_overwrite) {
+                m_stats::record_copy(count * sizeof(T));
+                std::copy_n(other.values, count, values);
+            }
+
+            heap_buffer(heap_buffer&& other) noexcept
+                : values(std::exchange(other.values, nullptr)),
+                  count(std::exchange(other.count, 0)),
+                  release(std::exchange(other.release, nullptr)),
+                  owner(std::exchange(other.owner, nullptr)),
+                  borrowing(std::exchange(other.borrowing, false)) {}
+
+            heap_buffer& operator=(const heap_buffer& other) {
+                if (this == &other)
+                    return *this;
+                // Elements allocated here can be reused when the size matches
+                if (release || count != other.count) {
+                    *this = heap_buffer{other};
+                } else {
+                    m_stats::record_copy(count * sizeof(T));
+                    std::copy_n(other.values, count, values);
+                }
+                return *this;
+            }
+
+            heap_buffer& operator=(heap_buffer&& other) noexcept {
+                if (this != &other) {
+                    reset();
+                    values = std::exchange(other.values, nullptr);
+                    count = std::exchange(other.count, 0);
+                    release = std::exchange(other.release, nullptr);
+                    owner = std::exchange(other.owner, nullptr);
+                    borrowing = std::exchange(other.borrowing, false);
+                }
+                return *this;
+            }
+
+            ~heap_buffer() { reset(); }
+
+            [[nodiscard]] size_t size() const { return count; }
+
+            [[nodiscard]] bool empty() const { return count == 0; }
+
+            // True when the elements are borrowed memory the buffer must never
+            // stop writing to.
+            [[nodiscard]] bool borrowed() const { return borrowing; }
+
+            [[nodiscard]] const T* data() const { return values; }
+
+            [[nodiscard]] T* data() { return values; }
+
+            const T& operator[](size_t i) const { return values[i]; }
+
+            T& operator[](size_t i) { return values[i]; }
+
+            [[nodiscard]] const_iterator begin() const { return values; }
+
+            [[nodiscard]] const_iterator end() const { return values + count; }
+
+            [[nodiscard]] iterator begin() { return values; }
+
+            [[nodiscard]] iterator end() { return values + count; }
+        };
+
+        // Element buffer shared between copies until one of them writes. Copies
+        // only bump an atomic reference count; the first non-const access of a
+        // shared buffer clones it, so readers in other threads keep the values
+        // they copied. Non-const access detaches even when it only reads, so
+        // shared matrices are best read through a const reference.
+        //
+        // As with any copy on write container, a reference or pointer obtained
+        // through non-const access must not be written through after the owner
+        // has been copied, since the copy would see the write.
+        //
+        // Borrowed memory is never shared: copying it allocates at once, so the
+        // borrowing matrix keeps writing to the external elements.
+        template <typename T>
+        class shared_buffer {
+          private:
+            struct block {
+                std::atomic<size_t> references{1};
+                heap_buffer<T> values;
+
+                explicit block(heap_buffer<T> values) : values(std::move(values)) {}
+            };
+
+            block* shared = nullptr;
+
+            // Another reference to the block of other, or a copy of it when its
+            // memory is borrowed
+            static block* share(block* other) {
+                if (other && other->values.borrowed())
+                    return new block{other->values};
+                if (other)
+                    other->references.fetch_add(1, std::memory_order_relaxed);
+                return other;
+            }
+
+            void release() {
+                if (shared && shared->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete shared;
+                shared = nullptr;
+            }
+
+            void detach() {
+                if (shared && shared->references.load(std::memory_order_acquire) != 1) {
+                    auto* copy = new block{shared->values};
+                    release();
+                    shared = copy;
+                }
+            }
+
+          public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            shared_buffer() = default;
+
+            shared_buffer(size_t count, for_overwrite_t) : shared(new block{heap_buffer<T>(count, for_overwrite)}) {}
+
+            shared_buffer(size_t count, const T& value) : shared(new block{heap_buffer<T>(count, value)}) {}
+
+            shared_buffer(heap_buffer<T> values) : shared(new block{std::move(values)}) {}
+
+            shared_buffer(std::vector<T> values) : shared(new block{heap_buffer<T>(std::move(values))}) {}
+
+            shared_buffer(const shared_buffer& other) : shared(share(other.shared)) {}
+
+            shared_buffer(shared_buffer&& other) noexcept : shared(std::exchange(other.shared, nullptr)) {}
+
+            shared_buffer& operator=(const shared_buffer& other) {
+                if (shared != other.shared) {
+                    block* copy = share(other.shared);
+                    release();
+                    shared = copy;
+                }
+                return *this;
+            }
+
+            shared_buffer& operator=(shared_buffer&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    shared = std::exchange(other.shared, nullptr);
+                }
+                return *this;
+            }
+
+            ~shared_buffer() { release(); }
+
+            [[nodiscard]] size_t size() const { return shared ? shared->values.size() : 0; }
+
+            [[nodiscard]] bool empty() const { return size() == 0; }
+
+            // Number of matrices currently sharing the buffer.
+            [[nodiscard]] size_t use_count() const {
+                return shared ? shared->references.load(std::memory_order_relaxed) : 0;
+            }
+
+            [[nodiscard]] const T* data() const { return shared ? shared->values.data() : nullptr; }
+
+            [[nodiscard]] T* data() {
+                detach();
+                return shared ? shared->values.data() : nullptr;
+            }
+
+            const T& operator[](size_t i) const { return shared->values[i]; }
+
+            T& operator[](size_t i) { return data()[i]; }
+
+            [[nodiscard]] const_iterator begin() const { return data(); }
+
+            [[nodiscard]] const_iterator end() const { return data() + size(); }
+
+            [[nodiscard]] iterator begin() { return data(); }
+
+            [[nodiscard]] iterator end() { return data() + size(); }
+        };
+
+        // Element buffer holding up to Capacity elements inline and spilling to
+        // a single heap block beyond that, so small matrices never allocate.
+        // Memory adopted through a heap_buffer stays where it is whatever its
+        // size, so writes keep reaching a borrowed buffer.
+        template <typename T, size_t Capacity>
+        class small_buffer {
+          private:
+            size_t count = 0;
+            std::array<T, Capacity> local;
+            heap_buffer<T> heap;
+
+            [[nodiscard]] bool is_inline() const { return heap.empty(); }
+
+            void allocate(size_t size) {
+                count = size;
+                if (size > Capacity)
+                    heap = heap_buffer<T>(size, for_overwrite);
+            }
+
+          public:
+            using value_type = T;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+            small_buffer() = default;
+
+            small_buffer(size_t size, for_overwrite_t) { allocate(size); }
+
+            small_buffer(size_t size, const T& value) {
+                allocate(size);
+                std::fill_n(data(), size, value);
+            }
+
+            small_buffer(const std::vector<T>& values) {
+                allocate(values.size());
+                std::copy(values.begin(), values.end(), data());
+            }
+
+            // Adopts the vector when it is too large to be held inline
+            small_buffer(std::vector<T>&& values) : count(values.size()) {
+                if (count <= Capacity)
+                    std::move(values.begin(), values.end(), local.begin());
+                else
+                    heap = heap_buffer<T>(std::move(values));
+            }
+
+            small_buffer(heap_buffer<T> values) : count(values.size()), heap(std::move(values)) {}
+
+            small_buffer(const small_buffer& other) {
+                allocate(other.count);
+                m_stats::record_copy(count * sizeof(T));
+                std::copy_n(other.data(), count, data());
+            }
+
+            small_buffer(small_buffer&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+                : count(other.count), heap(std::move(other.heap)) {
+                if (is_inline())
+                    std::move(other.local.begin(), other.local.begin() + count, local.begin());
+                other.count = 0;
+            }
+
+            small_buffer& operator=(const small_buffer& other) {
+                if (this != &other) {
+                    if (is_inline() || other.is_inline()) {
+                        heap = heap_buffer<T>{};
+                        allocate(other.count);
+                        m_stats::record_copy(count * sizeof(T));
+                        std::copy_n(other.data(), count, data());
+                    } else {
+                        heap = other.heap;
+                        count = other.count;
+                    }
+                }
+                return *this;
+            }
+
+            small_buffer& operator=(small_buffer&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
+                if (this != &other) {
+                    count = other.count;
+                    heap = std::move(other.heap);
+                    if (is_inline())
+                        std::move(other.local.begin(), other.local.begin() + count, local.begin());
+                    other.count = 0;
+                }
+                return *this;
+            }
+
+            [[nodiscard]] size_t size() const { return count; }
+
+            [[nodiscard]] bool empty() const { return count == 0; }
+
+            [[nodiscard]] const T* data() const { return is_inline() ? local.data() : heap.data(); }
+
+            [[nodiscard]] T* data() { return is_inline() ? local.data() : heap.data(); }
+
+            const T& operator[](size_t i) const { return data()[i]; }
+
+            T& operator[](size_t i) { return data()[i]; }
+
+            [[nodiscard]] const_iterator begin() const { return data(); }
+
+            [[nodiscard]] const_iterator end() const { return data() + count; }
+
+            [[nodiscard]] iterator begin() { return data(); }
+
+            [[nodiscard]] iterator end() { return data() + count; }
+        };
+    }  // namespace m_storage
+
+#ifndef MMATH_INLINE_CAPACITY
+#define MMATH_INLINE_CAPACITY 0
+#endif
+
+    // Number of elements a matrix_base<T> holds without allocating. Zero keeps
+    // every matrix in a heap_buffer. Defaults to MMATH_INLINE_CAPACITY for every type and
+    // may be specialized per element type before matrix_base<T> is first used:
+    //
+    //     template <>
+    //     struct mmath::matrix_inline_capacity<double> : std::integral_constant<size_t, 16> {};
+    //
+    // Copy on write storage takes precedence when both are enabled.
+    template <typename T>
+    struct matrix_inline_capacity : std::integral_constant<size_t, MMATH_INLINE_CAPACITY> {};
+
+    // Define MMATH_COPY_ON_WRITE before including mmath to share the elements of
+    // copied matrices until one of them is written, making copies O(1).
+#ifdef MMATH_COPY_ON_WRITE
+    template <typename T>
+    using matrix_storage = m_storage::shared_buffer<T>;
+#else
+    template <typename T>
+    using matrix_storage = std::conditional_t<(matrix_inline_capacity<T>::value > 0),
+                                              m_storage::small_buffer<T, matrix_inline_capacity<T>::value>,
+                                              m_storage::heap_buffer<T>>;
+#endif
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_MATRIXSTORAGE_HPP
@@ -0,0 +1,222 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_MIXED_HPP
+#define MMATH_MMATH_MIXED_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_lu.hpp"
+
+namespace mmath {
+
+    /*
+     * MIXED PRECISION MULTIPLY
+     */
+
+    // The type products of T are accumulated in by default: float widens to
+    // double and 8/16 bit integers to 32 bits, everything else stays as is.
+    template <typename T>
+    struct accumulator {
+        using type = T;
+    };
+
+    template <>
+    struct accumulator<float> {
+        using type = double;
+    };
+
+    template <>
+    struct accumulator<int8_t> {
+        using type = int32_t;
+    };
+
+    template <>
+    struct accumulator<uint8_t> {
+        using type = int32_t;
+    };
+
+    template <>
+    struct accumulator<int16_t> {
+        using type = int32_t;
+    };
+
+    template <>
+    struct accumulator<uint16_t> {
+        using type = uint32_t;
+    };
+
+    template <typename T>
+    using accumulator_t = typename accumulator<T>::type;
+
+    // A * B with every element widened to Acc before it is multiplied, so the
+    // inputs can be stored and streamed at their narrow width. Acc defaults to
+    // accumulator_t<T>.
+    template <typename Acc = void, expression T>
+    auto mixed_multiply(const matrix_base<T>& a, const matrix_base<T>& b) {
+        using R = std::conditional_t<std::is_void_v<Acc>, accumulator_t<T>, Acc>;
+        static_assert(expression<R>, "The accumulator type must be usable in a matrix expression");
+
+        if (a.is_empty() || b.is_empty())
+            throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+        if (a.size_col() != b.size_row())
+            throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                    "matrix b");
+
+        matrix_base<R> result{a.size_row(), b.size_col()};
+        m_kernel::gemm(a.size_row(), b.size_col(), a.size_col(), a.raw_data(), a.size_col(), 1, b.raw_data(),
+                       b.size_col(), result.raw_data(), b.size_col());
+        return result;
+    }
+
+    /*
+     * MIXED PRECISION SOLVE
+     */
+
+    template <std::floating_point T>
+    struct refinement_options {
+        size_t max_iterations = 30;
+        // Stop once ||b - A x|| <= tolerance * ||A|| ||x|| in the infinity norm.
+        // Zero uses epsilon * sqrt(n) of the working precision.
+        T tolerance = T{};
+    };
+
+    template <std::floating_point T>
+    struct refinement_result {
+        size_t iterations;
+        // Normwise backward error ||b - A x|| / (||A|| ||x||) of the returned x.
+        T backward_error;
+        bool converged;
+        // Refinement stalled or the low precision factorization failed, so the
+        // system was factored and solved in the working precision instead.
+        bool fell_back;
+    };
+
+    namespace m_mixed {
+
+        template <std::floating_point T>
+        T norm_inf(std::span<const T> x) {
+            T result{};
+            for (const T& value : x)
+                result = std::max(result, std::abs(value));
+            return result;
+        }
+
+        template <std::floating_point T>
+        T matrix_norm_inf(const matrix_base<T>& a) {
+            T result{};
+            const T* data = a.raw_data();
+            for (size_t i = 0; i < a.size_row(); ++i) {
+                T sum{};
+                for (size_t j = 0; j < a.size_col(); ++j)
+                    sum += std::abs(data[i * a.size_col() + j]);
+                result = std::max(result, sum);
+            }
+            return result;
+        }
+
+        // r = b - A x in the working precision, returns ||r||.
+        template <std::floating_point T>
+        T residual(const matrix_base<T>& a, std::span<const T> b, std::span<const T> x, std::vector<T>& r) {
+            const size_t n = a.size_row();
+            m_kernel::gemv(n, n, a.raw_data(), n, x.data(), r.data());
+            for (size_t i = 0; i < n; ++i)
+                r[i] = b[i] - r[i];
+            return norm_inf<T>(r);
+        }
+    }  // namespace m_mixed
+
+    // Solves A x = b by factoring A once in Low precision and refining the
+    // solution with residuals computed in the precision of A. Each refinement
+    // step costs one O(n^2) residual and a pair of Low precision triangular
+    // solves, against the O(n^3) factorization done at Low speed.
+    //
+    // When A is too ill conditioned for Low precision the refinement stops
+    // contracting; the solve then falls back to a full factorization in the
+    // working precision.
+    template <std::floating_point Low = float, std::floating_point T>
+    refinement_result<T> mixed_precision_solve(const matrix_base<T>& a,
+                                               std::span<const T> b,
+                                               std::span<T> x,
+                                               const refinement_options<T>& options = {}) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to solve a linear system");
+        const size_t n = a.size_row();
+        if (b.size() != n || x.size() != n)
+            throw std::domain_error("Vector sizes do not match the matrix");
+
+        const T a_norm = m_mixed::matrix_norm_inf(a);
+        const T tolerance = options.tolerance > T{} ? options.tolerance
+                                                    : std::numeric_limits<T>::epsilon() *
+                                                          std::sqrt(static_cast<T>(std::max<size_t>(n, 1)));
+        auto backward_error = [&](T r_norm) {
+            T scale = a_norm * m_mixed::norm_inf<T>(x);
+            return scale > T{} ? r_norm / scale : r_norm;
+        };
+
+        std::vector<T> r(n);
+        std::vector<Low> correction(n);
+        std::vector<size_t> pivots(n);
+        std::vector<Low> lu(n * n);
+
+        bool factored = true;
+        const T* data = a.raw_data();
+        for (size_t i = 0; i < n * n; ++i) {
+            lu[i] = static_cast<Low>(data[i]);
+            if (!std::isfinite(lu[i]))
+                factored = false;
+        }
+
+        if (factored) {
+            try {
+                m_kernel::lu_factor(n, lu.data(), n, pivots.data());
+            } catch (const std::domain_error&) {
+                factored = false;
+            }
+        }
+
+        if (factored) {
+            for (size_t i = 0; i < n; ++i)
+                correction[i] = static_cast<Low>(b[i]);
+            m_kernel::lu_solve(n, lu.data(), n, pivots.data(), correction.data());
+            for (size_t i = 0; i < n; ++i)
+                x[i] = static_cast<T>(correction[i]);
+
+            T previous = std::numeric_limits<T>::infinity();
+            for (size_t iteration = 0; iteration <= options.max_iterations; ++iteration) {
+                T r_norm = m_mixed::residual<T>(a, b, x, r);
+                T error = backward_error(r_norm);
+                if (error <= tolerance)
+                    return {iteration, error, true, false};
+                // Give up once a step no longer halves the residual
+                if (!std::isfinite(r_norm) || r_norm > previous / 2 || iteration == options.max_iterations)
+                    break;
+                previous = r_norm;
+
+                for (size_t i = 0; i < n; ++i)
+                    correction[i] = static_cast<Low>(r[i]);
+                m_kernel::lu_solve(n, lu.data(), n, pivots.data(), correction.data());
+                for (size_t i = 0; i < n; ++i)
+                    x[i] += static_cast<T>(correction[i]);
+            }
+        }
+
+        std::vector<T> solution = lu_solve(a, std::vector<T>(b.begin(), b.end()));
+        std::copy(solution.begin(), solution.end(), x.begin());
+        T error = backward_error(m_mixed::residual<T>(a, b, x, r));
+        return {0, error, error <= tolerance, true};
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_MIXED_HPP
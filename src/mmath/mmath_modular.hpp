@@ -0,0 +1,392 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_MODULAR_HPP
+#define MMATH_MMATH_MODULAR_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    namespace m_modular {
+
+        // Barrett reduction by a run time modulus p < 2^32. Any 64 bit value is
+        // reduced with one 128 bit multiply and at most two subtractions, so
+        // products only need reducing once enough of them have been summed to
+        // come close to 2^64.
+        class barrett {
+          private:
+            uint64_t p;
+            uint64_t factor;
+            // Number of products (p - 1)^2 that fit in a uint64_t accumulator on
+            // top of an already reduced value.
+            size_t products;
+
+          public:
+            explicit barrett(uint32_t modulus)
+                : p(modulus),
+                  factor(modulus > 1 ? std::numeric_limits<uint64_t>::max() / modulus : 0),
+                  products(1) {
+                if (modulus < 2)
+                    throw std::invalid_argument("Modulus must be at least 2");
+                const uint64_t largest = (p - 1) * (p - 1);
+                products = static_cast<size_t>((std::numeric_limits<uint64_t>::max() - (p - 1)) / largest);
+            }
+
+            [[nodiscard]] uint32_t modulus() const { return static_cast<uint32_t>(p); }
+
+            [[nodiscard]] size_t deferred_products() const { return products; }
+
+            [[nodiscard]] uint32_t reduce(uint64_t x) const {
+                auto q = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * factor) >> 64);
+                uint64_t r = x - q * p;
+                while (r >= p)
+                    r -= p;
+                return static_cast<uint32_t>(r);
+            }
+
+            [[nodiscard]] uint32_t add(uint32_t a, uint32_t b) const {
+                uint64_t sum = uint64_t{a} + b;
+                return static_cast<uint32_t>(sum >= p ? sum - p : sum);
+            }
+
+            [[nodiscard]] uint32_t sub(uint32_t a, uint32_t b) const {
+                return static_cast<uint32_t>(a >= b ? a - b : uint64_t{a} + p - b);
+            }
+
+            [[nodiscard]] uint32_t mul(uint32_t a, uint32_t b) const { return reduce(uint64_t{a} * b); }
+
+            [[nodiscard]] uint32_t pow(uint32_t base, uint64_t exponent) const {
+                uint32_t result = reduce(1);
+                while (exponent > 0) {
+                    if (exponent & 1)
+                        result = mul(result, base);
+                    base = mul(base, base);
+                    exponent >>= 1;
+                }
+                return result;
+            }
+
+            // Multiplicative inverse by the extended Euclidean algorithm. Throws
+            // when a shares a factor with the modulus, which for a prime modulus
+            // only happens for zero.
+            [[nodiscard]] uint32_t inverse(uint32_t a) const {
+                int64_t r0 = static_cast<int64_t>(p), r1 = a, s0 = 0, s1 = 1;
+                while (r1 != 0) {
+                    int64_t q = r0 / r1;
+                    r0 = std::exchange(r1, r0 - q * r1);
+                    s0 = std::exchange(s1, s0 - q * s1);
+                }
+                if (r0 != 1)
+                    throw std::domain_error("Value is not invertible modulo the matrix modulus");
+                return static_cast<uint32_t>(s0 < 0 ? s0 + static_cast<int64_t>(p) : s0);
+            }
+
+            template <std::integral I>
+            [[nodiscard]] uint32_t from(I value) const {
+                if constexpr (std::signed_integral<I>) {
+                    if (value < 0) {
+                        uint32_t r = reduce(static_cast<uint64_t>(-static_cast<__int128>(value)));
+                        return r == 0 ? 0 : static_cast<uint32_t>(p - r);
+                    }
+                }
+                return reduce(static_cast<uint64_t>(value));
+            }
+        };
+
+        // C (m x n) = A (m x k) * B (k x n) mod p, all row major and reduced.
+        //
+        // Blocked like m_kernel::gemm, but products of 32 bit residues are summed
+        // in 64 bit accumulators and only reduced every deferred_products()
+        // terms. The inner loop is a plain widening multiply-add over j that the
+        // compiler vectorizes.
+        inline void gemm(size_t m, size_t n, size_t k, const uint32_t* a, const uint32_t* b, uint32_t* c,
+                         const barrett& mod) {
+            std::fill(c, c + m * n, 0);
+            if (m == 0 || n == 0 || k == 0)
+                return;
+
+            const m_kernel::gemm_config& config = m_kernel::gemm_tuning();
+            const size_t mc = std::max<size_t>(config.block_m, 1);
+            const size_t nc = std::max<size_t>(config.block_n, 1);
+            const size_t kc = std::max<size_t>(config.block_k, 1);
+            const size_t budget = mod.deferred_products();
+
+            auto row_panels = [&](size_t panel_lo, size_t panel_hi) {
+                std::vector<uint64_t> acc(nc);
+                for (size_t panel = panel_lo; panel < panel_hi; ++panel) {
+                    size_t i_begin = panel * mc, i_end = std::min(m, i_begin + mc);
+
+                    for (size_t p_begin = 0; p_begin < k; p_begin += kc) {
+                        size_t p_end = std::min(k, p_begin + kc);
+
+                        for (size_t j_begin = 0; j_begin < n; j_begin += nc) {
+                            size_t j_end = std::min(n, j_begin + nc), width = j_end - j_begin;
+
+                            for (size_t i = i_begin; i < i_end; ++i) {
+                                uint32_t* c_row = c + i * n + j_begin;
+                                uint64_t* sums = acc.data();
+                                for (size_t j = 0; j < width; ++j)
+                                    sums[j] = c_row[j];
+
+                                size_t pending = 0;
+                                for (size_t p = p_begin; p < p_end; ++p) {
+                                    if (pending == budget) {
+                                        for (size_t j = 0; j < width; ++j)
+                                            sums[j] = mod.reduce(sums[j]);
+                                        pending = 0;
+                                    }
+                                    const uint64_t a_ip = a[i * k + p];
+                                    const uint32_t* b_row = b + p * n + j_begin;
+                                    for (size_t j = 0; j < width; ++j)
+                                        sums[j] += a_ip * b_row[j];
+                                    ++pending;
+                                }
+
+                                for (size_t j = 0; j < width; ++j)
+                                    c_row[j] = mod.reduce(sums[j]);
+                            }
+                        }
+                    }
+                }
+            };
+
+            const size_t panels = (m + mc - 1) / mc;
+            if (m * n * k >= config.parallel_threshold && panels > 1)
+                m_parallel::parallel_for(0, panels, 1, row_panels);
+            else
+                row_panels(0, panels);
+        }
+    }  // namespace m_modular
+
+    // A dense row major matrix over the integers modulo p, for 2 <= p < 2^32.
+    // Every stored element is kept reduced to [0, p). Determinants and inverses
+    // assume p is prime, i.e. that the elements form the field GF(p).
+    class mod_matrix {
+      private:
+        size_t num_row, num_col;
+        m_modular::barrett mod;
+        std::vector<uint32_t> data;
+
+        void check_compatible(const mod_matrix& b) const {
+            if (mod.modulus() != b.mod.modulus())
+                throw std::domain_error("Matrices must share the same modulus");
+        }
+
+      public:
+        mod_matrix(size_t rows, size_t cols, uint32_t modulus)
+            : num_row(rows), num_col(cols), mod(modulus), data(rows * cols, 0) {}
+
+        // Reduces every element of an integer matrix, negative values included.
+        template <std::integral I>
+        mod_matrix(const matrix_base<I>& matrix, uint32_t modulus)
+            : num_row(matrix.size_row()), num_col(matrix.size_col()), mod(modulus), data(num_row * num_col) {
+            const I* in = matrix.raw_data();
+            for (size_t i = 0; i < data.size(); ++i)
+                data[i] = mod.from(in[i]);
+        }
+
+        static mod_matrix identity(size_t size, uint32_t modulus) {
+            mod_matrix result{size, size, modulus};
+            for (size_t i = 0; i < size; ++i)
+                result.data[i * size + i] = 1;
+            return result;
+        }
+
+        [[nodiscard]] size_t size_row() const { return num_row; }
+
+        [[nodiscard]] size_t size_col() const { return num_col; }
+
+        [[nodiscard]] uint32_t modulus() const { return mod.modulus(); }
+
+        [[nodiscard]] bool is_empty() const { return num_row == 0 || num_col == 0; }
+
+        [[nodiscard]] bool is_square() const { return num_row == num_col; }
+
+        [[nodiscard]] const uint32_t* raw_data() const { return data.data(); }
+
+        [[nodiscard]] const m_modular::barrett& arithmetic() const { return mod; }
+
+        uint32_t operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the matrix.");
+            return data[(row - 1) * num_col + (column - 1)];
+        }
+
+        // Stores value reduced modulo p.
+        template <std::integral I>
+        void set(size_t row, size_t column, I value) {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the matrix.");
+            data[(row - 1) * num_col + (column - 1)] = mod.from(value);
+        }
+
+        template <std::integral T = uint32_t>
+        [[nodiscard]] matrix_base<T> to_matrix() const {
+            matrix_base<T> result{num_row, num_col, for_overwrite};
+            T* out = result.raw_data();
+            for (size_t i = 0; i < data.size(); ++i)
+                out[i] = static_cast<T>(data[i]);
+            return result;
+        }
+
+        mod_matrix operator+(const mod_matrix& b) const {
+            check_compatible(b);
+            if (num_row != b.num_row || num_col != b.num_col)
+                throw std::domain_error("Matrices must be the same size to add them");
+            mod_matrix result{num_row, num_col, modulus()};
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] = mod.add(data[i], b.data[i]);
+            return result;
+        }
+
+        mod_matrix operator-(const mod_matrix& b) const {
+            check_compatible(b);
+            if (num_row != b.num_row || num_col != b.num_col)
+                throw std::domain_error("Matrices must be the same size to subtract them");
+            mod_matrix result{num_row, num_col, modulus()};
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] = mod.sub(data[i], b.data[i]);
+            return result;
+        }
+
+        template <std::integral I>
+        mod_matrix operator*(I scalar) const {
+            const uint32_t s = mod.from(scalar);
+            mod_matrix result{num_row, num_col, modulus()};
+            for (size_t i = 0; i < data.size(); ++i)
+                result.data[i] = mod.mul(data[i], s);
+            return result;
+        }
+
+        mod_matrix operator*(const mod_matrix& b) const {
+            check_compatible(b);
+            if (is_empty() || b.is_empty())
+                throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+            if (num_col != b.num_row)
+                throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                        "matrix b");
+            mod_matrix result{num_row, b.num_col, modulus()};
+            m_modular::gemm(num_row, b.num_col, num_col, data.data(), b.data.data(), result.data.data(), mod);
+            return result;
+        }
+
+        // A^exponent by repeated squaring, O(n^3 log exponent).
+        mod_matrix operator^(std::integral auto exponent) const {
+            if (!is_square())
+                throw std::invalid_argument("Matrix must be square to raise it to a power.");
+            if (exponent < 0)
+                throw std::invalid_argument("Power cannot be less than 1");
+
+            mod_matrix result = identity(num_row, modulus());
+            if (is_empty())
+                return result;
+            mod_matrix base = *this;
+            auto e = static_cast<uint64_t>(exponent);
+            while (e > 0) {
+                if (e & 1)
+                    result = result * base;
+                e >>= 1;
+                if (e > 0)
+                    base = base * base;
+            }
+            return result;
+        }
+
+        bool operator==(const mod_matrix& b) const {
+            return modulus() == b.modulus() && num_row == b.num_row && num_col == b.num_col && data == b.data;
+        }
+
+        friend uint32_t determinant(const mod_matrix& matrix);
+        friend mod_matrix inverse(const mod_matrix& matrix);
+    };
+
+    template <std::integral I>
+    mod_matrix operator*(I scalar, const mod_matrix& matrix) {
+        return matrix * scalar;
+    }
+
+    namespace m_modular {
+
+        // Reduces rows [0, n) of the n x width row major matrix a to row echelon
+        // form over GF(p), clearing every other row in each pivot column when
+        // full is set (Gauss-Jordan). Returns the determinant of the leading
+        // n x n block, zero when it is singular.
+        inline uint32_t eliminate(size_t n, size_t width, uint32_t* a, const barrett& mod, bool full) {
+            uint32_t det = 1;
+            for (size_t col = 0; col < n; ++col) {
+                size_t pivot = col;
+                while (pivot < n && a[pivot * width + col] == 0)
+                    ++pivot;
+                if (pivot == n)
+                    return 0;
+                if (pivot != col) {
+                    std::swap_ranges(a + pivot * width, a + (pivot + 1) * width, a + col * width);
+                    det = mod.sub(0, det);
+                }
+
+                uint32_t* pivot_row = a + col * width;
+                det = mod.mul(det, pivot_row[col]);
+                const uint32_t scale = mod.inverse(pivot_row[col]);
+                for (size_t j = col; j < width; ++j)
+                    pivot_row[j] = mod.mul(pivot_row[j], scale);
+
+                for (size_t i = full ? 0 : col + 1; i < n; ++i) {
+                    uint32_t* row = a + i * width;
+                    if (i == col || row[col] == 0)
+                        continue;
+                    // row -= f * pivot_row, with f * pivot_row[j] added as p - f
+                    const uint64_t f = mod.sub(0, row[col]);
+                    for (size_t j = col; j < width; ++j)
+                        row[j] = mod.reduce(row[j] + f * pivot_row[j]);
+                }
+            }
+            return det;
+        }
+    }  // namespace m_modular
+
+    inline uint32_t determinant(const mod_matrix& matrix) {
+        if (matrix.is_empty())
+            throw std::invalid_argument("Matrix must not be empty to calculate the determinant");
+        if (!matrix.is_square())
+            throw std::invalid_argument("Matrix must be square to calculate the determinant");
+        std::vector<uint32_t> work = matrix.data;
+        return m_modular::eliminate(matrix.num_row, matrix.num_col, work.data(), matrix.mod, false);
+    }
+
+    // Inverse over GF(p) by Gauss-Jordan elimination of [A | I].
+    inline mod_matrix inverse(const mod_matrix& matrix) {
+        if (matrix.is_empty())
+            throw std::invalid_argument("Matrix must not be empty to calculate the inverse");
+        if (!matrix.is_square())
+            throw std::invalid_argument("Matrix must be square to calculate the inverse");
+
+        const size_t n = matrix.num_row, width = 2 * n;
+        std::vector<uint32_t> work(n * width, 0);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy_n(matrix.data.begin() + i * n, n, work.begin() + i * width);
+            work[i * width + n + i] = 1;
+        }
+        if (m_modular::eliminate(n, width, work.data(), matrix.mod, true) == 0)
+            throw std::domain_error("Matrix is singular modulo p");
+
+        mod_matrix result{n, n, matrix.modulus()};
+        for (size_t i = 0; i < n; ++i)
+            std::copy_n(work.begin() + i * width + n, n, result.data.begin() + i * n);
+        return result;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_MODULAR_HPP
@@ -0,0 +1,836 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_OUTOFCORE_HPP
+#define MMATH_MMATH_OUTOFCORE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mmath.hpp"
+#include "mmath_binary.hpp"
+#include "mmath_gemm.hpp"
+
+namespace mmath {
+
+    struct tiled_options {
+        // Edge length of the square tiles; edge tiles are zero padded on disk.
+        size_t tile_size = 1024;
+        // Bytes of tiles resident at once. A matrix on its own keeps up to
+        // this much; an operation divides the budget of its left operand
+        // evenly between the matrices it reads and writes, so together they
+        // stay within it. Each matrix keeps at least four tiles regardless.
+        size_t memory_budget = size_t{256} << 20;
+        // How many schedule steps ahead the read-ahead thread runs.
+        size_t prefetch_depth = 2;
+        // Where the files of results are created and relative paths are
+        // resolved, empty for the system temporary directory. That is often
+        // tmpfs, held in memory, so point this at a disk for large products.
+        std::string scratch_directory;
+    };
+
+    // I/O and compute accounting for a tiled matrix. Reads issued by the
+    // read-ahead thread only cost time when compute has to wait on them, which
+    // is what overlap() reports.
+    struct out_of_core_statistics {
+        size_t tiles_read = 0;
+        size_t tiles_written = 0;
+        size_t cache_hits = 0;
+        size_t prefetch_hits = 0;
+        double read_seconds = 0;
+        double write_seconds = 0;
+        double stall_seconds = 0;
+        double compute_seconds = 0;
+
+        // Fraction of the read time hidden behind compute.
+        [[nodiscard]] double overlap() const {
+            if (read_seconds <= 0)
+                return 1.0;
+            return std::clamp(1.0 - stall_seconds / read_seconds, 0.0, 1.0);
+        }
+
+        out_of_core_statistics& operator+=(const out_of_core_statistics& other) {
+            tiles_read += other.tiles_read;
+            tiles_written += other.tiles_written;
+            cache_hits += other.cache_hits;
+            prefetch_hits += other.prefetch_hits;
+            read_seconds += other.read_seconds;
+            write_seconds += other.write_seconds;
+            stall_seconds += other.stall_seconds;
+            compute_seconds += other.compute_seconds;
+            return *this;
+        }
+
+        out_of_core_statistics operator+(const out_of_core_statistics& other) const {
+            out_of_core_statistics result = *this;
+            return result += other;
+        }
+    };
+
+    struct tiled_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t element_type;
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t tile_size;
+        uint64_t data_offset;
+        uint64_t reserved[2];
+    };
+
+    static_assert(sizeof(tiled_header) == 64, "The tiled header must stay 64 bytes");
+
+    namespace m_ooc {
+
+        constexpr char magic[8] = {'M', 'M', 'A', 'T', 'H', 'T', 'I', 'L'};
+        constexpr uint32_t version = 1;
+        constexpr uint64_t data_offset = 4096;
+
+        enum class tile_access { READ, WRITE, ZEROED };
+
+        inline double seconds_since(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // Size of the file a header describes, false when the header is
+        // inconsistent or the size does not fit in 64 bits.
+        inline bool file_size(const tiled_header& header, size_t element_size, uint64_t& size) {
+            if (header.tile_size == 0 || header.data_offset != data_offset)
+                return false;
+            const uint64_t tile_rows = header.rows / header.tile_size + (header.rows % header.tile_size != 0);
+            const uint64_t tile_cols = header.cols / header.tile_size + (header.cols % header.tile_size != 0);
+            uint64_t tile_bytes = 0, tiles = 0;
+            return !__builtin_mul_overflow(header.tile_size, header.tile_size, &tile_bytes) &&
+                   !__builtin_mul_overflow(tile_bytes, uint64_t{element_size}, &tile_bytes) &&
+                   !__builtin_mul_overflow(tile_rows, tile_cols, &tiles) &&
+                   !__builtin_mul_overflow(tiles, tile_bytes, &size) &&
+                   !__builtin_add_overflow(size, data_offset, &size);
+        }
+
+        inline std::filesystem::path scratch_directory(const tiled_options& options) {
+            if (options.scratch_directory.empty())
+                return std::filesystem::temp_directory_path();
+            return options.scratch_directory;
+        }
+
+        // path itself when absolute or no scratch directory is set, otherwise
+        // path within the scratch directory.
+        inline std::string resolve(const std::string& path, const tiled_options& options) {
+            if (options.scratch_directory.empty() || std::filesystem::path{path}.is_absolute())
+                return path;
+            return (std::filesystem::path{options.scratch_directory} / path).string();
+        }
+
+        inline std::string temporary_path(const tiled_options& options) {
+            static std::atomic<size_t> counter{0};
+            auto name = "mmath_tiled_" + std::to_string(::getpid()) + "_" + std::to_string(counter++) + ".tile";
+            return (scratch_directory(options) / name).string();
+        }
+
+        // File backed LRU cache of fixed size tiles with a read-ahead thread.
+        //
+        // Tiles handed out by acquire() are pinned for as long as the caller
+        // holds the shared_ptr. Unpinned tiles are evicted least recently used
+        // first once the budget is reached, writing them back if dirty.
+        template <numeric T>
+        class tile_store {
+          private:
+            struct entry {
+                std::shared_ptr<std::vector<T>> tile;
+                bool ready = false;
+                bool dirty = false;
+                bool prefetched = false;
+                std::list<size_t>::iterator position;
+            };
+
+            m_binary::file_handle file;
+            size_t tile_elements;
+            size_t budget;
+            // Resident tiles the budget allows, never fewer than four
+            size_t capacity;
+
+            std::unordered_map<size_t, entry> entries;
+            std::list<size_t> recency;
+            std::mutex mutex;
+            std::condition_variable loaded;
+
+            std::deque<size_t> pending;
+            std::condition_variable wake;
+            bool stopping = false;
+            std::thread reader;
+
+            out_of_core_statistics stats;
+
+            [[nodiscard]] off_t offset_of(size_t id) const {
+                return static_cast<off_t>(data_offset + id * tile_elements * sizeof(T));
+            }
+
+            void read_tile(size_t id, T* destination) {
+                auto* bytes = reinterpret_cast<char*>(destination);
+                size_t remaining = tile_elements * sizeof(T);
+                off_t offset = offset_of(id);
+                while (remaining > 0) {
+                    ssize_t count = ::pread(file.get(), bytes, remaining, offset);
+                    if (count < 0)
+                        m_binary::throw_errno("Unable to read tile");
+                    if (count == 0) {
+                        std::memset(bytes, 0, remaining);
+                        break;
+                    }
+                    bytes += count;
+                    offset += count;
+                    remaining -= static_cast<size_t>(count);
+                }
+            }
+
+            void write_tile(size_t id, const T* source) {
+                const auto* bytes = reinterpret_cast<const char*>(source);
+                size_t remaining = tile_elements * sizeof(T);
+                off_t offset = offset_of(id);
+                while (remaining > 0) {
+                    ssize_t count = ::pwrite(file.get(), bytes, remaining, offset);
+                    if (count < 0)
+                        m_binary::throw_errno("Unable to write tile");
+                    bytes += count;
+                    offset += count;
+                    remaining -= static_cast<size_t>(count);
+                }
+            }
+
+            void write_back(size_t id, entry& e) {
+                auto start = std::chrono::steady_clock::now();
+                write_tile(id, e.tile->data());
+                stats.write_seconds += seconds_since(start);
+                ++stats.tiles_written;
+                e.dirty = false;
+            }
+
+            // Evicts until at most limit tiles are resident. Returns false when
+            // every remaining tile is pinned or still loading.
+            bool evict_to(size_t limit) {
+                while (entries.size() > limit) {
+                    auto victim = std::find_if(recency.rbegin(), recency.rend(), [&](size_t id) {
+                        const entry& e = entries.at(id);
+                        return e.ready && e.tile.use_count() == 1;
+                    });
+                    if (victim == recency.rend())
+                        return false;
+
+                    size_t id = *victim;
+                    entry& e = entries.at(id);
+                    if (e.dirty)
+                        write_back(id, e);
+                    recency.erase(e.position);
+                    entries.erase(id);
+                }
+                return true;
+            }
+
+            // Evicts until there is room for one more tile.
+            bool make_room() { return evict_to(capacity - 1); }
+
+            [[nodiscard]] size_t capacity_for(size_t memory_budget) const {
+                return std::max<size_t>(memory_budget / (tile_elements * sizeof(T)), 4);
+            }
+
+            entry& insert(size_t id) {
+                recency.push_front(id);
+                entry& e = entries[id];
+                e.tile = std::make_shared<std::vector<T>>(tile_elements);
+                e.position = recency.begin();
+                return e;
+            }
+
+            void read_ahead() {
+                std::unique_lock lock{mutex};
+                while (true) {
+                    wake.wait(lock, [&] { return stopping || !pending.empty(); });
+                    if (stopping)
+                        return;
+
+                    size_t id = pending.front();
+                    pending.pop_front();
+                    if (entries.contains(id) || !make_room())
+                        continue;
+
+                    auto tile = insert(id).tile;
+                    lock.unlock();
+                    auto start = std::chrono::steady_clock::now();
+                    bool failed = false;
+                    try {
+                        read_tile(id, tile->data());
+                    } catch (...) {
+                        failed = true;
+                    }
+                    double elapsed = seconds_since(start);
+                    lock.lock();
+
+                    // Leave the error to surface from the synchronous read in acquire()
+                    if (failed) {
+                        recency.erase(entries.at(id).position);
+                        entries.erase(id);
+                        loaded.notify_all();
+                        continue;
+                    }
+
+                    entry& e = entries.at(id);
+                    e.ready = true;
+                    e.prefetched = true;
+                    stats.read_seconds += elapsed;
+                    ++stats.tiles_read;
+                    loaded.notify_all();
+                }
+            }
+
+          public:
+            tile_store(const std::string& path, bool create, tiled_header& header, size_t memory_budget)
+                : file(path, create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR) {
+                if (create) {
+                    if (::pwrite(file.get(), &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+                        m_binary::throw_errno("Unable to write " + path);
+                } else if (::pread(file.get(), &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+                           std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version) {
+                    throw std::runtime_error("Not an mmath tiled matrix file");
+                } else if (header.element_type != m_binary::element_type_code<T>()) {
+                    throw std::runtime_error("Tiled matrix element type does not match the requested type");
+                } else {
+                    struct stat info {};
+                    uint64_t size = 0;
+                    if (::fstat(file.get(), &info) != 0)
+                        m_binary::throw_errno("Unable to stat " + path);
+                    if (!file_size(header, sizeof(T), size) || static_cast<uint64_t>(info.st_size) < size)
+                        throw std::runtime_error("Not an mmath tiled matrix file");
+                }
+
+                tile_elements = header.tile_size * header.tile_size;
+                budget = memory_budget;
+                capacity = capacity_for(memory_budget);
+            }
+
+            tile_store(const tile_store&) = delete;
+            tile_store& operator=(const tile_store&) = delete;
+
+            ~tile_store() {
+                {
+                    std::lock_guard lock{mutex};
+                    stopping = true;
+                }
+                wake.notify_all();
+                if (reader.joinable())
+                    reader.join();
+                // Errors writing back are lost here; call flush() first to see them
+                try {
+                    flush();
+                } catch (...) {
+                }
+            }
+
+            void reserve(uint64_t bytes) {
+                if (::ftruncate(file.get(), static_cast<off_t>(data_offset + bytes)) != 0)
+                    m_binary::throw_errno("Unable to size tiled matrix file");
+            }
+
+            // Returns the tile pinned. WRITE marks it dirty, ZEROED skips the read
+            // entirely and hands back a zero filled dirty tile.
+            std::shared_ptr<std::vector<T>> acquire(size_t id, tile_access access = tile_access::READ) {
+                std::unique_lock lock{mutex};
+
+                if (auto found = entries.find(id); found != entries.end() && !found->second.ready) {
+                    auto start = std::chrono::steady_clock::now();
+                    loaded.wait(lock, [&] {
+                        auto current = entries.find(id);
+                        return current == entries.end() || current->second.ready;
+                    });
+                    stats.stall_seconds += seconds_since(start);
+                }
+
+                if (auto found = entries.find(id); found != entries.end()) {
+                    entry& e = found->second;
+                    if (e.prefetched) {
+                        ++stats.prefetch_hits;
+                        e.prefetched = false;
+                    } else {
+                        ++stats.cache_hits;
+                    }
+                    recency.splice(recency.begin(), recency, e.position);
+                    if (access == tile_access::ZEROED)
+                        std::fill(e.tile->begin(), e.tile->end(), T{});
+                    if (access != tile_access::READ)
+                        e.dirty = true;
+                    return e.tile;
+                }
+
+                while (!make_room()) {
+                    // Tiles still being read become evictable once loaded, pinned ones never do here
+                    bool loading = std::any_of(entries.begin(), entries.end(),
+                                               [](const auto& resident) { return !resident.second.ready; });
+                    if (!loading)
+                        throw std::runtime_error("Memory budget exhausted: every resident tile is pinned");
+                    loaded.wait(lock);
+                }
+                if (entries.contains(id)) {
+                    // Brought in by the read-ahead thread while waiting
+                    lock.unlock();
+                    return acquire(id, access);
+                }
+                entry& inserted = insert(id);
+                auto tile = inserted.tile;
+                if (access == tile_access::ZEROED) {
+                    inserted.ready = true;
+                    inserted.dirty = true;
+                    return tile;
+                }
+
+                lock.unlock();
+                auto start = std::chrono::steady_clock::now();
+                try {
+                    read_tile(id, tile->data());
+                } catch (...) {
+                    lock.lock();
+                    recency.erase(entries.at(id).position);
+                    entries.erase(id);
+                    loaded.notify_all();
+                    throw;
+                }
+                double elapsed = seconds_since(start);
+                lock.lock();
+
+                entry& e = entries.at(id);
+                e.ready = true;
+                e.dirty = access == tile_access::WRITE;
+                stats.read_seconds += elapsed;
+                stats.stall_seconds += elapsed;
+                ++stats.tiles_read;
+                loaded.notify_all();
+                return tile;
+            }
+
+            // Sets how many bytes of tiles may stay resident, evicting down to
+            // the new limit as far as pins allow, and returns the old budget.
+            size_t set_budget(size_t memory_budget) {
+                std::lock_guard lock{mutex};
+                const size_t previous = std::exchange(budget, memory_budget);
+                capacity = capacity_for(memory_budget);
+                evict_to(capacity);
+                return previous;
+            }
+
+            // Queues an asynchronous read. Dropped when the tile is resident or
+            // the budget is exhausted by pinned tiles.
+            void prefetch(size_t id) {
+                {
+                    std::lock_guard lock{mutex};
+                    if (entries.contains(id))
+                        return;
+                    pending.push_back(id);
+                    if (!reader.joinable())
+                        reader = std::thread{[this] { read_ahead(); }};
+                }
+                wake.notify_one();
+            }
+
+            void flush() {
+                std::lock_guard lock{mutex};
+                for (auto& [id, e] : entries) {
+                    if (e.ready && e.dirty)
+                        write_back(id, e);
+                }
+            }
+
+            void add_compute(double seconds) {
+                std::lock_guard lock{mutex};
+                stats.compute_seconds += seconds;
+            }
+
+            [[nodiscard]] out_of_core_statistics statistics() {
+                std::lock_guard lock{mutex};
+                return stats;
+            }
+
+            void reset_statistics() {
+                std::lock_guard lock{mutex};
+                stats = {};
+            }
+        };
+
+        // Splits one memory budget evenly between the distinct stores taking
+        // part in an operation while it runs, and gives them their own budgets
+        // back afterwards.
+        template <numeric T>
+        class budget_split {
+          private:
+            std::vector<std::pair<tile_store<T>*, size_t>> previous;
+
+            void restore() noexcept {
+                for (auto& [store, budget] : previous) {
+                    // Raising a budget evicts nothing, so this cannot fail in practice
+                    try {
+                        store->set_budget(budget);
+                    } catch (...) {
+                    }
+                }
+            }
+
+          public:
+            budget_split(size_t memory_budget, std::initializer_list<tile_store<T>*> stores) {
+                std::vector<tile_store<T>*> distinct;
+                for (auto* store : stores) {
+                    if (std::find(distinct.begin(), distinct.end(), store) == distinct.end())
+                        distinct.push_back(store);
+                }
+                previous.reserve(distinct.size());
+                try {
+                    for (auto* store : distinct)
+                        previous.emplace_back(store, store->set_budget(memory_budget / distinct.size()));
+                } catch (...) {
+                    restore();
+                    throw;
+                }
+            }
+
+            budget_split(const budget_split&) = delete;
+            budget_split& operator=(const budget_split&) = delete;
+
+            ~budget_split() { restore(); }
+        };
+    }  // namespace m_ooc
+
+    // Disk backed matrix stored as square tiles in a file, for matrices that do
+    // not fit in memory. Only memory_budget bytes of tiles are resident at any
+    // time, for a matrix on its own and for an operation as a whole.
+    template <numeric T>
+    class tiled_matrix {
+      private:
+        size_t num_row, num_col;
+        tiled_options options;
+        std::string file_path;
+        bool temporary;
+        std::unique_ptr<m_ooc::tile_store<T>> store;
+
+        tiled_matrix(size_t rows, size_t cols, tiled_options options, std::string path, bool temporary, bool create)
+            : num_row(rows), num_col(cols), options(options), file_path(std::move(path)), temporary(temporary) {
+            tiled_header header{};
+            uint64_t file_bytes = 0;
+            if (create) {
+                if (options.tile_size == 0)
+                    throw std::invalid_argument("Tile size must be nonzero");
+                std::memcpy(header.magic, m_ooc::magic, sizeof(m_ooc::magic));
+                header.version = m_ooc::version;
+                header.element_type = m_binary::element_type_code<T>();
+                header.rows = rows;
+                header.cols = cols;
+                header.tile_size = options.tile_size;
+                header.data_offset = m_ooc::data_offset;
+                if (!m_ooc::file_size(header, sizeof(T), file_bytes))
+                    throw std::invalid_argument("Tiled matrix is too large");
+            }
+
+            store = std::make_unique<m_ooc::tile_store<T>>(file_path, create, header, options.memory_budget);
+
+            if (create) {
+                // A sparse file, so every tile starts out as zeros.
+                store->reserve(file_bytes - m_ooc::data_offset);
+            } else {
+                num_row = header.rows;
+                num_col = header.cols;
+                this->options.tile_size = header.tile_size;
+            }
+        }
+
+        void release() noexcept {
+            store.reset();
+            if (temporary && !file_path.empty()) {
+                std::error_code ignored;
+                std::filesystem::remove(file_path, ignored);
+            }
+            file_path.clear();
+        }
+
+        [[nodiscard]] size_t tile_id(size_t tile_row, size_t tile_col) const {
+            return tile_row * tile_cols() + tile_col;
+        }
+
+        [[nodiscard]] tiled_matrix make_result(size_t rows, size_t cols) const {
+            return tiled_matrix{rows, cols, options, m_ooc::temporary_path(options), true, true};
+        }
+
+        void require_same_tiling(const tiled_matrix& other) const {
+            if (options.tile_size != other.options.tile_size)
+                throw std::invalid_argument("Tiled matrices must share a tile size");
+        }
+
+        template <typename Op>
+        tiled_matrix elementwise(const tiled_matrix& b, Op op) const {
+            if (num_row == 0 || num_col == 0 || b.num_row == 0 || b.num_col == 0)
+                throw std::invalid_argument("Matrices used in addition or subtraction cannot be empty");
+            if (num_row != b.num_row || num_col != b.num_col)
+                throw std::domain_error("Matrices must be the same size");
+            require_same_tiling(b);
+
+            tiled_matrix result = make_result(num_row, num_col);
+            m_ooc::budget_split<T> split{options.memory_budget, {store.get(), b.store.get(), result.store.get()}};
+            size_t count = tile_rows() * tile_cols();
+
+            for (size_t id = 0; id < count; ++id) {
+                for (size_t ahead = 1; ahead <= options.prefetch_depth && id + ahead < count; ++ahead) {
+                    store->prefetch(id + ahead);
+                    b.store->prefetch(id + ahead);
+                }
+
+                auto left = store->acquire(id);
+                auto right = b.store->acquire(id);
+                auto out = result.store->acquire(id, m_ooc::tile_access::ZEROED);
+
+                auto start = std::chrono::steady_clock::now();
+                for (size_t e = 0; e < out->size(); ++e)
+                    (*out)[e] = op((*left)[e], (*right)[e]);
+                result.store->add_compute(m_ooc::seconds_since(start));
+            }
+            return result;
+        }
+
+      public:
+        // Creates a zero filled matrix backed by the file at path. Results of
+        // operations on it are created in options.scratch_directory, which a
+        // relative path is taken from as well.
+        static tiled_matrix create(const std::string& path, size_t rows, size_t cols, tiled_options options = {}) {
+            return tiled_matrix{rows, cols, options, m_ooc::resolve(path, options), false, true};
+        }
+
+        // Opens an existing tiled matrix file. The tile size comes from the file.
+        static tiled_matrix open(const std::string& path, tiled_options options = {}) {
+            return tiled_matrix{0, 0, options, m_ooc::resolve(path, options), false, false};
+        }
+
+        static tiled_matrix from_matrix(const std::string& path, const matrix_base<T>& m, tiled_options options = {}) {
+            tiled_matrix result = create(path, m.size_row(), m.size_col(), options);
+            const T* data = m.raw_data();
+            size_t tile = result.options.tile_size;
+
+            for (size_t ti = 0; ti < result.tile_rows(); ++ti) {
+                for (size_t tj = 0; tj < result.tile_cols(); ++tj) {
+                    auto out = result.store->acquire(result.tile_id(ti, tj), m_ooc::tile_access::ZEROED);
+                    size_t row_end = std::min(tile, m.size_row() - ti * tile);
+                    size_t col_end = std::min(tile, m.size_col() - tj * tile);
+                    for (size_t r = 0; r < row_end; ++r)
+                        std::copy_n(data + (ti * tile + r) * m.size_col() + tj * tile, col_end,
+                                    out->data() + r * tile);
+                }
+            }
+            result.flush();
+            return result;
+        }
+
+        tiled_matrix(tiled_matrix&& other) noexcept
+            : num_row(other.num_row),
+              num_col(other.num_col),
+              options(other.options),
+              file_path(std::move(other.file_path)),
+              temporary(other.temporary),
+              store(std::move(other.store)) {
+            other.file_path.clear();
+            other.temporary = false;
+        }
+
+        tiled_matrix& operator=(tiled_matrix&& other) noexcept {
+            if (this != &other) {
+                release();
+                num_row = other.num_row;
+                num_col = other.num_col;
+                options = other.options;
+                file_path = std::move(other.file_path);
+                temporary = other.temporary;
+                store = std::move(other.store);
+                other.file_path.clear();
+                other.temporary = false;
+            }
+            return *this;
+        }
+
+        ~tiled_matrix() { release(); }
+
+        [[nodiscard]] size_t size_row() const { return num_row; }
+
+        [[nodiscard]] size_t size_col() const { return num_col; }
+
+        [[nodiscard]] size_t tile_size() const { return options.tile_size; }
+
+        [[nodiscard]] size_t tile_rows() const { return (num_row + options.tile_size - 1) / options.tile_size; }
+
+        [[nodiscard]] size_t tile_cols() const { return (num_col + options.tile_size - 1) / options.tile_size; }
+
+        [[nodiscard]] const std::string& path() const { return file_path; }
+
+        // Keeps the backing file when this matrix is destroyed.
+        void persist() { temporary = false; }
+
+        // 1-indexed like matrix_base.
+        T operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            size_t tile = options.tile_size;
+            auto t = store->acquire(tile_id((row - 1) / tile, (column - 1) / tile));
+            return (*t)[((row - 1) % tile) * tile + (column - 1) % tile];
+        }
+
+        void set(size_t row, size_t column, const T& value) {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            size_t tile = options.tile_size;
+            auto t = store->acquire(tile_id((row - 1) / tile, (column - 1) / tile), m_ooc::tile_access::WRITE);
+            (*t)[((row - 1) % tile) * tile + (column - 1) % tile] = value;
+        }
+
+        [[nodiscard]] matrix_base<T> to_matrix() const {
+            matrix_base<T> result{num_row, num_col, for_overwrite};
+            T* data = result.raw_data();
+            size_t tile = options.tile_size;
+
+            for (size_t ti = 0; ti < tile_rows(); ++ti) {
+                for (size_t tj = 0; tj < tile_cols(); ++tj) {
+                    auto in = store->acquire(tile_id(ti, tj));
+                    size_t row_end = std::min(tile, num_row - ti * tile);
+                    size_t col_end = std::min(tile, num_col - tj * tile);
+                    for (size_t r = 0; r < row_end; ++r)
+                        std::copy_n(in->data() + r * tile, col_end, data + (ti * tile + r) * num_col + tj * tile);
+                }
+            }
+            return result;
+        }
+
+        tiled_matrix operator+(const tiled_matrix& b) const {
+            return elementwise(b, [](const T& x, const T& y) { return x + y; });
+        }
+
+        tiled_matrix operator-(const tiled_matrix& b) const {
+            return elementwise(b, [](const T& x, const T& y) { return x - y; });
+        }
+
+        // Each output tile stays resident for its whole k loop. The j loop and
+        // the k loop both run back and forth so the tiles touched last by one
+        // pass are the first ones needed by the next, while they are still in
+        // the LRU window.
+        tiled_matrix operator*(const tiled_matrix& b) const {
+            if (num_row == 0 || num_col == 0 || b.num_row == 0 || b.num_col == 0)
+                throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+            if (num_col != b.num_row)
+                throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                        "matrix b");
+            require_same_tiling(b);
+
+            const size_t mt = tile_rows(), nt = b.tile_cols(), kt = tile_cols();
+            const size_t tile = options.tile_size;
+
+            std::vector<std::array<size_t, 3>> schedule;
+            schedule.reserve(mt * nt * kt);
+            size_t pass = 0;
+            for (size_t i = 0; i < mt; ++i) {
+                for (size_t jj = 0; jj < nt; ++jj, ++pass) {
+                    size_t j = i % 2 == 0 ? jj : nt - 1 - jj;
+                    for (size_t pp = 0; pp < kt; ++pp)
+                        schedule.push_back({i, j, pass % 2 == 0 ? pp : kt - 1 - pp});
+                }
+            }
+
+            tiled_matrix result = make_result(num_row, b.num_col);
+            m_ooc::budget_split<T> split{options.memory_budget, {store.get(), b.store.get(), result.store.get()}};
+
+            for (size_t s = 0; s < schedule.size(); ++s) {
+                for (size_t ahead = 1; ahead <= options.prefetch_depth && s + ahead < schedule.size(); ++ahead) {
+                    auto [ni, nj, np] = schedule[s + ahead];
+                    store->prefetch(tile_id(ni, np));
+                    b.store->prefetch(b.tile_id(np, nj));
+                }
+
+                auto [i, j, p] = schedule[s];
+                bool first = s % kt == 0;
+                auto out = result.store->acquire(result.tile_id(i, j),
+                                                 first ? m_ooc::tile_access::ZEROED : m_ooc::tile_access::WRITE);
+                auto left = store->acquire(tile_id(i, p));
+                auto right = b.store->acquire(b.tile_id(p, j));
+
+                auto start = std::chrono::steady_clock::now();
+                m_kernel::gemm(tile, tile, tile, left->data(), tile, 1, right->data(), tile, out->data(), tile);
+                result.store->add_compute(m_ooc::seconds_since(start));
+            }
+            return result;
+        }
+
+        [[nodiscard]] tiled_matrix transpose() const {
+            tiled_matrix result = make_result(num_col, num_row);
+            m_ooc::budget_split<T> split{options.memory_budget, {store.get(), result.store.get()}};
+            const size_t tile = options.tile_size;
+            const size_t count = tile_rows() * tile_cols();
+
+            for (size_t id = 0; id < count; ++id) {
+                for (size_t ahead = 1; ahead <= options.prefetch_depth && id + ahead < count; ++ahead)
+                    store->prefetch(id + ahead);
+
+                size_t ti = id / tile_cols(), tj = id % tile_cols();
+                auto in = store->acquire(id);
+                auto out = result.store->acquire(result.tile_id(tj, ti), m_ooc::tile_access::ZEROED);
+
+                auto start = std::chrono::steady_clock::now();
+                for (size_t r = 0; r < tile; ++r) {
+                    for (size_t c = 0; c < tile; ++c)
+                        (*out)[c * tile + r] = (*in)[r * tile + c];
+                }
+                result.store->add_compute(m_ooc::seconds_since(start));
+            }
+            return result;
+        }
+
+        // Only the diagonal tiles are read.
+        [[nodiscard]] T tr() const {
+            if (num_row == 0 || num_col == 0)
+                throw std::invalid_argument("Matrix must not be empty to calculate trace");
+            if (num_row != num_col)
+                throw std::invalid_argument("Matrix must be square to calculate trace");
+
+            const size_t tile = options.tile_size;
+            T sum = T{};
+            for (size_t t = 0; t < tile_rows(); ++t) {
+                for (size_t ahead = 1; ahead <= options.prefetch_depth && t + ahead < tile_rows(); ++ahead)
+                    store->prefetch(tile_id(t + ahead, t + ahead));
+
+                auto diagonal = store->acquire(tile_id(t, t));
+                size_t extent = std::min(tile, num_row - t * tile);
+                for (size_t d = 0; d < extent; ++d)
+                    sum = sum + (*diagonal)[d * tile + d];
+            }
+            return sum;
+        }
+
+        // Writes every dirty resident tile back to the file, throwing when a
+        // write fails. The destructor flushes too but has to swallow errors, so
+        // call this first when they matter.
+        void flush() { store->flush(); }
+
+        [[nodiscard]] out_of_core_statistics statistics() const { return store->statistics(); }
+
+        void reset_statistics() { store->reset_statistics(); }
+    };
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_OUTOFCORE_HPP
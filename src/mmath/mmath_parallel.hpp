@@ -0,0 +1,192 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_PARALLEL_HPP
+#define MMATH_MMATH_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace mmath {
+    namespace m_parallel {
+
+        /*
+         * THREAD POOL
+         */
+
+        // Process wide pool of worker threads shared by every parallel kernel in
+        // the library. Workers are started lazily on first use.
+        class thread_pool {
+          private:
+            std::vector<std::thread> workers;
+            size_t num_helpers;
+            std::queue<std::function<void()>> tasks;
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool stopping = false;
+
+            // At least one worker is started even when the kernels are to run
+            // on the calling thread alone, so submitted work always progresses.
+            explicit thread_pool(size_t num_threads) : num_helpers(num_threads) {
+                workers.reserve(std::max<size_t>(num_threads, 1));
+                for (size_t i = 0; i < std::max<size_t>(num_threads, 1); ++i)
+                    workers.emplace_back([this] { this->run(); });
+            }
+
+            void run() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock{mutex};
+                        cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                        if (stopping && tasks.empty())
+                            return;
+                        task = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                }
+            }
+
+          public:
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            ~thread_pool() {
+                {
+                    std::lock_guard lock{mutex};
+                    stopping = true;
+                }
+                cv.notify_all();
+                for (auto& worker : workers)
+                    worker.join();
+            }
+
+            // The MMATH_NUM_THREADS environment variable overrides the thread
+            // count, otherwise one thread per hardware thread is used.
+            static thread_pool& instance() {
+                static thread_pool pool{default_concurrency() - 1};
+                return pool;
+            }
+
+            static size_t default_concurrency() {
+                if (const char* env = std::getenv("MMATH_NUM_THREADS")) {
+                    char* end = nullptr;
+                    unsigned long requested = std::strtoul(env, &end, 10);
+                    if (end != env && requested > 0)
+                        return requested;
+                }
+                return std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            // Number of threads that can work on a job, including the caller.
+            [[nodiscard]] size_t concurrency() const { return num_helpers + 1; }
+
+            void submit(std::function<void()> task) {
+                {
+                    std::lock_guard lock{mutex};
+                    tasks.push(std::move(task));
+                }
+                cv.notify_one();
+            }
+        };
+
+        /*
+         * PARALLEL FOR
+         */
+
+        namespace detail {
+            struct parallel_for_state {
+                std::atomic<size_t> next_chunk{0};
+                std::atomic<size_t> chunks_done{0};
+                size_t num_chunks = 0;
+                size_t begin = 0;
+                size_t end = 0;
+                size_t chunk_size = 0;
+                const std::function<void(size_t, size_t)>* body = nullptr;
+
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::exception_ptr error;
+
+                // Claims and runs chunks until none are left. Chunks are only ever
+                // claimed while the caller is still waiting, so body stays valid.
+                void work() {
+                    for (;;) {
+                        size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                        if (chunk >= num_chunks)
+                            return;
+
+                        size_t lo = begin + chunk * chunk_size;
+                        size_t hi = std::min(end, lo + chunk_size);
+                        try {
+                            (*body)(lo, hi);
+                        } catch (...) {
+                            std::lock_guard lock{mutex};
+                            if (!error)
+                                error = std::current_exception();
+                        }
+
+                        if (chunks_done.fetch_add(1, std::memory_order_acq_rel) + 1 == num_chunks) {
+                            std::lock_guard lock{mutex};
+                            cv.notify_all();
+                        }
+                    }
+                }
+            };
+        }  // namespace detail
+
+        // Calls body(lo, hi) over disjoint sub ranges covering [begin, end). The
+        // range is only split when it holds more than grain indices, and the
+        // calling thread always takes part so nested use cannot deadlock the pool.
+        inline void parallel_for(size_t begin,
+                                 size_t end,
+                                 size_t grain,
+                                 const std::function<void(size_t, size_t)>& body) {
+            if (begin >= end)
+                return;
+
+            thread_pool& pool = thread_pool::instance();
+            size_t count = end - begin;
+            grain = std::max<size_t>(grain, 1);
+
+            if (pool.concurrency() == 1 || count <= grain) {
+                body(begin, end);
+                return;
+            }
+
+            auto state = std::make_shared<detail::parallel_for_state>();
+            state->num_chunks = std::min(pool.concurrency() * 4, (count + grain - 1) / grain);
+            state->chunk_size = (count + state->num_chunks - 1) / state->num_chunks;
+            state->num_chunks = (count + state->chunk_size - 1) / state->chunk_size;
+            state->begin = begin;
+            state->end = end;
+            state->body = &body;
+
+            size_t helpers = std::min(pool.concurrency() - 1, state->num_chunks - 1);
+            for (size_t i = 0; i < helpers; ++i)
+                pool.submit([state] { state->work(); });
+
+            state->work();
+
+            std::unique_lock lock{state->mutex};
+            state->cv.wait(lock, [&] { return state->chunks_done.load(std::memory_order_acquire) == state->num_chunks; });
+
+            if (state->error)
+                std::rethrow_exception(state->error);
+        }
+    }  // namespace m_parallel
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_PARALLEL_HPP
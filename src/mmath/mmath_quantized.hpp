@@ -0,0 +1,272 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_QUANTIZED_HPP
+#define MMATH_MMATH_QUANTIZED_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_parallel.hpp"
+
+// The AVX2 kernel is chosen at run time when the CPU supports it. Define
+// MMATH_QUANTIZED_SCALAR to always use the portable loop.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(MMATH_QUANTIZED_SCALAR)
+#define MMATH_QUANTIZED_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace mmath {
+
+    template <typename T>
+    concept quantized_element = std::same_as<T, int8_t> || std::same_as<T, uint8_t> || std::same_as<T, int16_t>;
+
+    // Affine quantization real = scale * (q - zero_point) of one operand. Each
+    // vector is empty (scale 1, zero point 0), holds a single per tensor value,
+    // or one value per row of A / per column of B.
+    struct quantization_params {
+        std::vector<float> scale;
+        std::vector<int32_t> zero_point;
+    };
+
+    namespace m_quantized {
+
+        // Output columns handled by one kernel call, two AVX2 registers of int32.
+        constexpr size_t block_n = 16;
+        // Rows of A sharing each load of B in the kernel.
+        constexpr size_t block_m = 4;
+
+        inline size_t round_up(size_t value, size_t multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        inline void check_params(const std::vector<float>& scale,
+                                 const std::vector<int32_t>& zero_point,
+                                 size_t count,
+                                 const char* message) {
+            if (scale.size() > 1 && scale.size() != count)
+                throw std::domain_error(message);
+            if (zero_point.size() > 1 && zero_point.size() != count)
+                throw std::domain_error(message);
+        }
+
+        template <typename T>
+        T param(const std::vector<T>& values, size_t index, T fallback) {
+            if (values.empty())
+                return fallback;
+            return values.size() == 1 ? values[0] : values[index];
+        }
+
+        // Operands widened to int16 with k padded to an even length. A stays row
+        // major; B is split into panels of 8 columns in which the rows p and p + 1
+        // of each column are adjacent, matching the pair wise vpmaddwd multiply.
+        struct packed_operands {
+            size_t k_pairs;
+            std::vector<int16_t> a;
+            std::vector<int16_t> b;
+        };
+
+        template <quantized_element TA, quantized_element TB>
+        packed_operands pack(size_t m, size_t n, size_t k, const TA* a, const TB* b) {
+            const size_t kp = round_up(k, 2);
+            const size_t np = round_up(n, block_n);
+            packed_operands packed{kp / 2, std::vector<int16_t>(m * kp, 0), std::vector<int16_t>(np * kp, 0)};
+
+            for (size_t i = 0; i < m; ++i)
+                for (size_t p = 0; p < k; ++p)
+                    packed.a[i * kp + p] = static_cast<int16_t>(a[i * k + p]);
+
+            for (size_t p = 0; p < k; ++p) {
+                const size_t pair = p / 2, lane = p % 2;
+                for (size_t j = 0; j < n; ++j) {
+                    size_t panel = j / 8, column = j % 8;
+                    packed.b[(panel * packed.k_pairs + pair) * 16 + column * 2 + lane] = static_cast<int16_t>(b[p * n + j]);
+                }
+            }
+            return packed;
+        }
+
+#ifdef MMATH_QUANTIZED_AVX2
+        inline bool has_avx2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+
+        // c[rows x 16] = A[rows x k] * B[k x 16] for the 16 columns starting at
+        // panel pair * 8 of the packed operands.
+        template <size_t Rows>
+        __attribute__((target("avx2"))) void kernel_avx2(const packed_operands& packed,
+                                                         size_t row,
+                                                         size_t panel,
+                                                         int32_t* c,
+                                                         size_t ldc) {
+            const size_t kp = packed.k_pairs * 2;
+            const int16_t* b0 = packed.b.data() + panel * packed.k_pairs * 16;
+            const int16_t* b1 = b0 + packed.k_pairs * 16;
+
+            __m256i acc[Rows][2];
+            for (size_t r = 0; r < Rows; ++r) {
+                acc[r][0] = _mm256_setzero_si256();
+                acc[r][1] = _mm256_setzero_si256();
+            }
+
+            for (size_t q = 0; q < packed.k_pairs; ++q) {
+                const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b0 + q * 16));
+                const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b1 + q * 16));
+                for (size_t r = 0; r < Rows; ++r) {
+                    int32_t pair;
+                    std::memcpy(&pair, packed.a.data() + (row + r) * kp + q * 2, sizeof(pair));
+                    const __m256i a = _mm256_set1_epi32(pair);
+                    acc[r][0] = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(a, lo));
+                    acc[r][1] = _mm256_add_epi32(acc[r][1], _mm256_madd_epi16(a, hi));
+                }
+            }
+
+            for (size_t r = 0; r < Rows; ++r) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + (row + r) * ldc), acc[r][0]);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + (row + r) * ldc + 8), acc[r][1]);
+            }
+        }
+#endif
+
+        // c (m x round_up(n, 16)) = A * B with int32 accumulation that wraps on
+        // overflow, which is exact whenever the true sum fits in int32.
+        template <quantized_element TA, quantized_element TB>
+        void accumulate(size_t m, size_t n, size_t k, const TA* a, const TB* b, int32_t* c, size_t ldc) {
+            const size_t panels = round_up(n, block_n) / block_n;
+            const bool parallel = m * n * k >= m_kernel::gemm_tuning().parallel_threshold;
+
+#ifdef MMATH_QUANTIZED_AVX2
+            if (has_avx2()) {
+                const packed_operands packed = pack(m, n, k, a, b);
+                auto columns = [&](size_t lo, size_t hi) {
+                    for (size_t block = lo; block < hi; ++block) {
+                        size_t i = 0;
+                        for (; i + block_m <= m; i += block_m)
+                            kernel_avx2<block_m>(packed, i, block * 2, c + block * block_n, ldc);
+                        for (; i < m; ++i)
+                            kernel_avx2<1>(packed, i, block * 2, c + block * block_n, ldc);
+                    }
+                };
+                if (parallel)
+                    m_parallel::parallel_for(0, panels, 1, columns);
+                else
+                    columns(0, panels);
+                return;
+            }
+#endif
+
+            auto rows = [&](size_t lo, size_t hi) {
+                std::vector<uint32_t> sums(n);
+                for (size_t i = lo; i < hi; ++i) {
+                    std::fill(sums.begin(), sums.end(), 0);
+                    for (size_t p = 0; p < k; ++p) {
+                        const int32_t a_ip = a[i * k + p];
+                        const TB* b_row = b + p * n;
+                        for (size_t j = 0; j < n; ++j)
+                            sums[j] += static_cast<uint32_t>(a_ip * static_cast<int32_t>(b_row[j]));
+                    }
+                    for (size_t j = 0; j < n; ++j)
+                        c[i * ldc + j] = static_cast<int32_t>(sums[j]);
+                }
+            };
+            if (parallel)
+                m_parallel::parallel_for(0, m, block_m, rows);
+            else
+                rows(0, m);
+        }
+
+        template <typename Out>
+        Out convert(int32_t value, double scale, bool scaled) {
+            if constexpr (std::floating_point<Out>) {
+                return static_cast<Out>(scale * value);
+            } else {
+                // Requantize with round to nearest; either way saturate to Out
+                double rounded = scaled ? std::nearbyint(scale * value) : static_cast<double>(value);
+                rounded = std::clamp(rounded, static_cast<double>(std::numeric_limits<Out>::lowest()),
+                                     static_cast<double>(std::numeric_limits<Out>::max()));
+                return static_cast<Out>(rounded);
+            }
+        }
+    }  // namespace m_quantized
+
+    // C = (A - za) * (B - zb) accumulated exactly in int32, then written as Out
+    // (int32 unless given).
+    //
+    // A floating point Out receives the dequantized product
+    // scale_a[i] * scale_b[j] * C(i, j). An integral Out receives C itself when
+    // no scales are given and otherwise the product of C and the scales rounded,
+    // which requantizes the result; both are saturated to the range of Out.
+    //
+    // Zero points are folded in afterwards through the row sums of A and the
+    // column sums of B, so the inner product runs on the raw operands. On x86-64
+    // with AVX2 the operands are widened to int16 and multiplied with vpmaddwd.
+    template <expression Out = int32_t, quantized_element TA, quantized_element TB>
+    matrix_base<Out> quantized_multiply(const matrix_base<TA>& a,
+                                        const matrix_base<TB>& b,
+                                        const quantization_params& a_params = {},
+                                        const quantization_params& b_params = {}) {
+        if (a.is_empty() || b.is_empty())
+            throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+        if (a.size_col() != b.size_row())
+            throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                    "matrix b");
+
+        const size_t m = a.size_row(), n = b.size_col(), k = a.size_col();
+        m_quantized::check_params(a_params.scale, a_params.zero_point, m,
+                                  "Quantization parameters of a must be per tensor or per row");
+        m_quantized::check_params(b_params.scale, b_params.zero_point, n,
+                                  "Quantization parameters of b must be per tensor or per column");
+
+        const size_t ldc = m_quantized::round_up(n, m_quantized::block_n);
+        std::vector<int32_t> c(m * ldc);
+        m_quantized::accumulate(m, n, k, a.raw_data(), b.raw_data(), c.data(), ldc);
+
+        // sum_p (a_ip - za_i)(b_pj - zb_j)
+        //   = sum_p a_ip b_pj - zb_j sum_p a_ip - za_i sum_p b_pj + k za_i zb_j
+        const bool a_offset = !a_params.zero_point.empty(), b_offset = !b_params.zero_point.empty();
+        std::vector<uint32_t> a_sums(a_offset || b_offset ? m : 0), b_sums(a_offset ? n : 0);
+        if (b_offset) {
+            for (size_t i = 0; i < m; ++i)
+                for (size_t p = 0; p < k; ++p)
+                    a_sums[i] += static_cast<uint32_t>(a.raw_data()[i * k + p]);
+        }
+        if (a_offset) {
+            for (size_t p = 0; p < k; ++p)
+                for (size_t j = 0; j < n; ++j)
+                    b_sums[j] += static_cast<uint32_t>(b.raw_data()[p * n + j]);
+        }
+
+        const bool scaled = !a_params.scale.empty() || !b_params.scale.empty();
+        matrix_base<Out> result{m, n, for_overwrite};
+        Out* out = result.raw_data();
+        for (size_t i = 0; i < m; ++i) {
+            const auto za = static_cast<uint32_t>(m_quantized::param(a_params.zero_point, i, 0));
+            const double sa = m_quantized::param(a_params.scale, i, 1.0f);
+            for (size_t j = 0; j < n; ++j) {
+                const auto zb = static_cast<uint32_t>(m_quantized::param(b_params.zero_point, j, 0));
+                auto value = static_cast<uint32_t>(c[i * ldc + j]);
+                if (b_offset)
+                    value -= zb * a_sums[i];
+                if (a_offset)
+                    value -= za * b_sums[j];
+                if (a_offset && b_offset)
+                    value += static_cast<uint32_t>(k) * za * zb;
+                const double scale = sa * m_quantized::param(b_params.scale, j, 1.0f);
+                out[i * n + j] = m_quantized::convert<Out>(static_cast<int32_t>(value), scale, scaled);
+            }
+        }
+        return result;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_QUANTIZED_HPP
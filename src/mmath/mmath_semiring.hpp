@@ -0,0 +1,274 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_SEMIRING_HPP
+#define MMATH_MMATH_SEMIRING_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    /*
+     * SEMIRINGS
+     *
+     * A semiring replaces the + and * of a matrix product. zero() is the
+     * identity of add and annihilates under mul, one() is the identity of mul.
+     */
+
+    template <template <typename> class S, typename T>
+    concept semiring = requires(T a, T b) {
+        { S<T>::zero() } -> std::convertible_to<T>;
+        { S<T>::one() } -> std::convertible_to<T>;
+        { S<T>::add(a, b) } -> std::convertible_to<T>;
+        { S<T>::mul(a, b) } -> std::convertible_to<T>;
+    };
+
+    namespace m_semiring {
+
+        // Unreachable distance of the tropical semirings; infinity where the type
+        // has one, otherwise the largest value, which mul keeps and saturates to.
+        template <typename T>
+        constexpr T infinity() {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return std::numeric_limits<T>::infinity();
+            else
+                return std::numeric_limits<T>::max();
+        }
+
+        template <typename T>
+        constexpr T negative_infinity() {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return -std::numeric_limits<T>::infinity();
+            else
+                return std::numeric_limits<T>::lowest();
+        }
+
+        // a + b, clamped to the range of an integral T instead of overflowing.
+        template <typename T>
+        constexpr T saturating_add(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                T sum{};
+                if (!__builtin_add_overflow(a, b, &sum))
+                    return sum;
+                return b > T{} ? std::numeric_limits<T>::max() : std::numeric_limits<T>::lowest();
+            } else {
+                return a + b;
+            }
+        }
+    }  // namespace m_semiring
+
+    // The ordinary (+, *) semiring, matching operator*.
+    template <typename T>
+    struct plus_times {
+        static constexpr T zero() { return T{}; }
+        static constexpr T one() { return T{1}; }
+        static constexpr T add(T a, T b) { return a + b; }
+        static constexpr T mul(T a, T b) { return a * b; }
+    };
+
+    // (min, +): shortest paths, with infinity() marking a missing edge.
+    template <typename T>
+    struct min_plus {
+        static constexpr T zero() { return m_semiring::infinity<T>(); }
+        static constexpr T one() { return T{}; }
+        static constexpr T add(T a, T b) { return b < a ? b : a; }
+        static constexpr T mul(T a, T b) {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return a + b;
+            else
+                return a == zero() || b == zero() ? zero() : m_semiring::saturating_add(a, b);
+        }
+    };
+
+    // (max, +): longest paths and schedules, with negative_infinity() marking a
+    // missing edge.
+    template <typename T>
+    struct max_plus {
+        static constexpr T zero() { return m_semiring::negative_infinity<T>(); }
+        static constexpr T one() { return T{}; }
+        static constexpr T add(T a, T b) { return a < b ? b : a; }
+        static constexpr T mul(T a, T b) {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return a + b;
+            else
+                return a == zero() || b == zero() ? zero() : m_semiring::saturating_add(a, b);
+        }
+    };
+
+    // (or, and) over 0 and 1: reachability.
+    template <typename T>
+    struct or_and {
+        static constexpr T zero() { return T{}; }
+        static constexpr T one() { return T{1}; }
+        static constexpr T add(T a, T b) { return a | b; }
+        static constexpr T mul(T a, T b) { return a & b; }
+    };
+
+    namespace m_kernel {
+
+        // C (m x n) = C (+) A (m x k) (*) B (k x n) over the semiring S, all row
+        // major.
+        //
+        // Blocked like gemm. The policy calls inline into a unit stride loop over
+        // j, so min/max and add compile to vector instructions. Since zero()
+        // annihilates under mul and is the identity of add, a zero() in A skips
+        // its row of B entirely, which prunes most of the work on sparse graphs.
+        template <template <typename> class S, typename T>
+            requires semiring<S, T>
+        void semiring_gemm(size_t m, size_t n, size_t k, const T* a, const T* b, T* c, bool allow_parallel = true) {
+            if (m == 0 || n == 0 || k == 0)
+                return;
+
+            using ring = S<T>;
+            const gemm_config& config = gemm_tuning();
+            const size_t mc = std::max<size_t>(config.block_m, 1);
+            const size_t nc = std::max<size_t>(config.block_n, 1);
+            const size_t kc = std::max<size_t>(config.block_k, 1);
+
+            auto row_panels = [&](size_t panel_lo, size_t panel_hi) {
+                for (size_t panel = panel_lo; panel < panel_hi; ++panel) {
+                    size_t i_begin = panel * mc, i_end = std::min(m, i_begin + mc);
+
+                    for (size_t p_begin = 0; p_begin < k; p_begin += kc) {
+                        size_t p_end = std::min(k, p_begin + kc);
+
+                        for (size_t j_begin = 0; j_begin < n; j_begin += nc) {
+                            size_t j_end = std::min(n, j_begin + nc);
+
+                            for (size_t i = i_begin; i < i_end; ++i) {
+                                T* c_row = c + i * n;
+                                for (size_t p = p_begin; p < p_end; ++p) {
+                                    const T a_ip = a[i * k + p];
+                                    if (a_ip == ring::zero())
+                                        continue;
+                                    const T* b_row = b + p * n;
+                                    if constexpr (std::is_same_v<ring, or_and<T>>) {
+                                        // a_ip is one(), so the product is B's row
+                                        for (size_t j = j_begin; j < j_end; ++j)
+                                            c_row[j] = c_row[j] | b_row[j];
+                                    } else {
+                                        for (size_t j = j_begin; j < j_end; ++j)
+                                            c_row[j] = ring::add(c_row[j], ring::mul(a_ip, b_row[j]));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+
+            const size_t panels = (m + mc - 1) / mc;
+            if (allow_parallel && m * n * k >= config.parallel_threshold && panels > 1)
+                m_parallel::parallel_for(0, panels, 1, row_panels);
+            else
+                row_panels(0, panels);
+        }
+    }  // namespace m_kernel
+
+    template <template <typename> class S, expression T>
+        requires semiring<S, T>
+    matrix_base<T> semiring_identity(size_t size) {
+        matrix_base<T> result{size, size, S<T>::zero()};
+        T* data = result.raw_data();
+        for (size_t i = 0; i < size; ++i)
+            data[i * size + i] = S<T>::one();
+        return result;
+    }
+
+    // A (*) B over the semiring S, e.g. semiring_multiply<min_plus>(a, b).
+    template <template <typename> class S, expression T>
+        requires semiring<S, T>
+    matrix_base<T> semiring_multiply(const matrix_base<T>& a, const matrix_base<T>& b) {
+        if (a.is_empty() || b.is_empty())
+            throw std::invalid_argument("Matrices used in multiplication cannot be empty");
+        if (a.size_col() != b.size_row())
+            throw std::domain_error("Matrix a must have the same number of columns as there are rows in "
+                                    "matrix b");
+
+        matrix_base<T> result{a.size_row(), b.size_col(), S<T>::zero()};
+        m_kernel::semiring_gemm<S>(a.size_row(), b.size_col(), a.size_col(), a.raw_data(), b.raw_data(),
+                                   result.raw_data());
+        return result;
+    }
+
+    // A^exponent over the semiring S by repeated squaring; A^0 is
+    // semiring_identity.
+    template <template <typename> class S, expression T>
+        requires semiring<S, T>
+    matrix_base<T> semiring_power(const matrix_base<T>& a, std::integral auto exponent) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to raise it to a power.");
+        if (exponent < 0)
+            throw std::invalid_argument("Power cannot be less than 1");
+
+        matrix_base<T> result = semiring_identity<S, T>(a.size_row());
+        if (a.is_empty())
+            return result;
+        matrix_base<T> base = a;
+        auto remaining = static_cast<std::make_unsigned_t<decltype(exponent)>>(exponent);
+        while (remaining > 0) {
+            if (remaining & 1)
+                result = semiring_multiply<S>(result, base);
+            remaining >>= 1;
+            if (remaining > 0)
+                base = semiring_multiply<S>(base, base);
+        }
+        return result;
+    }
+
+    // (I (+) A)^(n - 1), the sum over all paths of at most n - 1 edges. Squares
+    // until the matrix stops changing, so at most ceil(log2(n - 1)) products are
+    // formed and fewer when the longest path is short.
+    template <template <typename> class S, expression T>
+        requires semiring<S, T>
+    matrix_base<T> semiring_closure(const matrix_base<T>& a) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to calculate its closure");
+
+        const size_t n = a.size_row();
+        matrix_base<T> result = a;
+        T* data = result.raw_data();
+        for (size_t i = 0; i < n; ++i)
+            data[i * n + i] = S<T>::add(data[i * n + i], S<T>::one());
+
+        for (size_t length = 1; length + 1 < n; length *= 2) {
+            matrix_base<T> next = semiring_multiply<S>(result, result);
+            if (std::equal(next.raw_data(), next.raw_data() + n * n, result.raw_data()))
+                break;
+            result = std::move(next);
+        }
+        return result;
+    }
+
+    // Reachability: element (i, j) is 1 when j can be reached from i, itself
+    // included. Nonzero elements of the adjacency matrix count as edges.
+    template <std::integral T>
+    matrix_base<T> transitive_closure(const matrix_base<T>& adjacency) {
+        matrix_base<T> edges = adjacency;
+        T* data = edges.raw_data();
+        for (size_t i = 0; i < edges.size_row() * edges.size_col(); ++i)
+            data[i] = data[i] != T{} ? T{1} : T{};
+        return semiring_closure<or_and>(edges);
+    }
+
+    // All pairs shortest path lengths from a matrix of edge weights holding
+    // min_plus<T>::zero() (infinity, or the largest value of an integer type)
+    // where there is no edge. Weights may be negative as long as no cycle is.
+    template <expression T>
+    matrix_base<T> shortest_paths(const matrix_base<T>& weights) {
+        return semiring_closure<min_plus>(weights);
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_SEMIRING_HPP
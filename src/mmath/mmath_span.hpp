@@ -0,0 +1,208 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_SPAN_HPP
+#define MMATH_MMATH_SPAN_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "mmath.hpp"
+#include "mmath_matrixstorage.hpp"
+
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+namespace mmath {
+
+    /*
+     * MATRIX SPANS
+     *
+     * A matrix_span is a non-owning view of rows x cols elements living in
+     * someone else's memory, addressed as values[i * stride_row + j * stride_col]
+     * for 0-indexed i and j. The layouts follow std::mdspan: layout_right is row
+     * major, layout_left column major and layout_stride takes both strides.
+     */
+
+    struct layout_right {};
+    struct layout_left {};
+    struct layout_stride {};
+
+    template <typename T, typename Layout = layout_right>
+    class matrix_span {
+      private:
+        T* values = nullptr;
+        size_t num_row = 0, num_col = 0;
+        size_t row_step = 0, col_step = 0;
+
+        template <typename U, typename L>
+        friend class matrix_span;
+
+      public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using layout_type = Layout;
+
+        matrix_span() = default;
+
+        matrix_span(T* values, size_t rows, size_t cols)
+            requires(!std::same_as<Layout, layout_stride>)
+            : values(values),
+              num_row(rows),
+              num_col(cols),
+              row_step(std::same_as<Layout, layout_right> ? cols : 1),
+              col_step(std::same_as<Layout, layout_right> ? 1 : rows) {}
+
+        matrix_span(T* values, size_t rows, size_t cols, size_t stride_row, size_t stride_col)
+            requires std::same_as<Layout, layout_stride>
+            : values(values), num_row(rows), num_col(cols), row_step(stride_row), col_step(stride_col) {}
+
+        // Adds const, or forgets the layout by converting to layout_stride.
+        template <typename U, typename L>
+            requires std::convertible_to<U (*)[], T (*)[]> &&
+                     (std::same_as<L, Layout> || std::same_as<Layout, layout_stride>)
+        matrix_span(const matrix_span<U, L>& other)
+            : values(other.values),
+              num_row(other.num_row),
+              num_col(other.num_col),
+              row_step(other.row_step),
+              col_step(other.col_step) {}
+
+        [[nodiscard]] size_t size_row() const { return num_row; }
+
+        [[nodiscard]] size_t size_col() const { return num_col; }
+
+        [[nodiscard]] size_t stride_row() const { return row_step; }
+
+        [[nodiscard]] size_t stride_col() const { return col_step; }
+
+        [[nodiscard]] T* data_handle() const { return values; }
+
+        [[nodiscard]] bool is_empty() const { return num_row == 0 || num_col == 0; }
+
+        // True when the elements are packed row major, exactly as a matrix_base
+        // stores them.
+        [[nodiscard]] bool is_contiguous() const { return col_step == 1 && (row_step == num_col || num_row <= 1); }
+
+        T& operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+            return values[(row - 1) * row_step + (column - 1) * col_step];
+        }
+    };
+
+    // Row major view of the elements of a matrix. Like raw_data(), a view of a
+    // non-const matrix counts as a mutation.
+    template <expression T>
+    matrix_span<T> as_span(matrix_base<T>& matrix) {
+        return {matrix.raw_data(), matrix.size_row(), matrix.size_col()};
+    }
+
+    template <expression T>
+    matrix_span<const T> as_span(const matrix_base<T>& matrix) {
+        return {matrix.raw_data(), matrix.size_row(), matrix.size_col()};
+    }
+
+    // A matrix_base working directly on the memory of a row major span. Every
+    // algorithm taking a matrix_base reads and writes the external elements in
+    // place. The memory must outlive the matrix and everything moved from it;
+    // copies own their elements, and assigning another matrix to the borrowed
+    // one replaces the borrowed memory instead of writing into it, use copy_to
+    // for that.
+    template <expression T>
+    matrix_base<T> borrow_matrix(matrix_span<T, layout_right> span) {
+        return matrix_base<T>{span.size_row(), span.size_col(), span.data_handle(), m_storage::non_owning{}};
+    }
+
+    // Copies the elements of a span of any layout into a new matrix.
+    template <typename T, typename Layout>
+    matrix_base<std::remove_cv_t<T>> to_matrix(matrix_span<T, Layout> span) {
+        using value_type = std::remove_cv_t<T>;
+        const size_t rows = span.size_row(), cols = span.size_col();
+        matrix_base<value_type> result{rows, cols, for_overwrite};
+        value_type* out = result.raw_data();
+        const T* in = span.data_handle();
+
+        if (span.is_contiguous()) {
+            std::copy_n(in, rows * cols, out);
+        } else if (span.stride_col() == 1) {
+            for (size_t i = 0; i < rows; ++i)
+                std::copy_n(in + i * span.stride_row(), cols, out + i * cols);
+        } else {
+            // Tiled so a column major source is not walked across a whole row
+            // of cache lines per element
+            const size_t tile = std::max<size_t>(m_kernel::transpose_tuning<value_type>().tile, 1);
+            for (size_t ib = 0; ib < rows; ib += tile)
+                for (size_t jb = 0; jb < cols; jb += tile)
+                    for (size_t j = jb; j < std::min(cols, jb + tile); ++j)
+                        for (size_t i = ib; i < std::min(rows, ib + tile); ++i)
+                            out[i * cols + j] = in[i * span.stride_row() + j * span.stride_col()];
+        }
+        return result;
+    }
+
+    // Writes the elements of a matrix into a span of the same size and any
+    // layout.
+    template <expression T, typename Layout>
+    void copy_to(const matrix_base<T>& matrix, matrix_span<T, Layout> span) {
+        if (matrix.size_row() != span.size_row() || matrix.size_col() != span.size_col())
+            throw std::domain_error("Matrices must be the same size");
+
+        const size_t rows = matrix.size_row(), cols = matrix.size_col();
+        const T* in = matrix.raw_data();
+        T* out = span.data_handle();
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                out[i * span.stride_row() + j * span.stride_col()] = in[i * cols + j];
+    }
+
+#if defined(__cpp_lib_mdspan)
+    // Conversions from and to a rank 2 std::mdspan with the matching layout,
+    // available when the standard library provides one.
+    template <typename T, typename Extents>
+        requires(Extents::rank() == 2)
+    matrix_span<T, layout_right> as_span(std::mdspan<T, Extents, std::layout_right> span) {
+        return {span.data_handle(), span.extent(0), span.extent(1)};
+    }
+
+    template <typename T, typename Extents>
+        requires(Extents::rank() == 2)
+    matrix_span<T, layout_left> as_span(std::mdspan<T, Extents, std::layout_left> span) {
+        return {span.data_handle(), span.extent(0), span.extent(1)};
+    }
+
+    template <typename T, typename Extents>
+        requires(Extents::rank() == 2)
+    matrix_span<T, layout_stride> as_span(std::mdspan<T, Extents, std::layout_stride> span) {
+        return {span.data_handle(), span.extent(0), span.extent(1), span.stride(0), span.stride(1)};
+    }
+
+    template <typename T>
+    auto to_mdspan(matrix_span<T, layout_right> span) {
+        return std::mdspan<T, std::dextents<size_t, 2>, std::layout_right>{span.data_handle(), span.size_row(),
+                                                                            span.size_col()};
+    }
+
+    template <typename T>
+    auto to_mdspan(matrix_span<T, layout_left> span) {
+        return std::mdspan<T, std::dextents<size_t, 2>, std::layout_left>{span.data_handle(), span.size_row(),
+                                                                           span.size_col()};
+    }
+
+    template <typename T>
+    auto to_mdspan(matrix_span<T, layout_stride> span) {
+        using extents = std::dextents<size_t, 2>;
+        std::layout_stride::mapping<extents> mapping{extents{span.size_row(), span.size_col()},
+                                                     std::array<size_t, 2>{span.stride_row(), span.stride_col()}};
+        return std::mdspan<T, extents, std::layout_stride>{span.data_handle(), mapping};
+    }
+#endif
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_SPAN_HPP
@@ -0,0 +1,177 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_SPARSE_HPP
+#define MMATH_MMATH_SPARSE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_parallel.hpp"
+
+namespace mmath {
+
+    // A single stored entry, 1-indexed like matrix_base.
+    template <expression T>
+    struct sparse_entry {
+        size_t row;
+        size_t column;
+        T value;
+    };
+
+    // Compressed sparse row matrix. Column indices are 0-based, sorted and
+    // unique within each row.
+    template <expression T>
+    class csr_matrix {
+      private:
+        size_t num_row, num_col;
+        std::vector<size_t> row_ptr;
+        std::vector<size_t> col_idx;
+        std::vector<T> vals;
+
+      public:
+        using value_type = T;
+
+        csr_matrix() : num_row(0), num_col(0), row_ptr(1, 0){};
+
+        csr_matrix(size_t rows,
+                   size_t cols,
+                   std::vector<size_t> row_pointers,
+                   std::vector<size_t> column_indices,
+                   std::vector<T> values)
+            : num_row(rows)
+            , num_col(cols)
+            , row_ptr(std::move(row_pointers))
+            , col_idx(std::move(column_indices))
+            , vals(std::move(values)) {
+            if (row_ptr.size() != num_row + 1 || row_ptr.front() != 0 || row_ptr.back() != col_idx.size() ||
+                col_idx.size() != vals.size())
+                throw std::invalid_argument("The compressed row data provided does not match the rows and cols");
+
+            for (size_t i = 0; i < num_row; ++i) {
+                if (row_ptr[i] > row_ptr[i + 1])
+                    throw std::invalid_argument("Row pointers must be non decreasing");
+                for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                    if (col_idx[k] >= num_col || (k > row_ptr[i] && col_idx[k] <= col_idx[k - 1]))
+                        throw std::invalid_argument("Column indices must be in range, sorted and unique per row");
+                }
+            }
+        }
+
+        // Builds from unordered entries, summing duplicates.
+        csr_matrix(size_t rows, size_t cols, std::vector<sparse_entry<T>> entries)
+            : num_row(rows), num_col(cols), row_ptr(rows + 1, 0) {
+            for (auto& e : entries) {
+                if (e.row == 0 || e.column == 0 || e.row > rows || e.column > cols)
+                    throw std::out_of_range("Requested element lies outside of the Matrix.");
+            }
+
+            std::sort(entries.begin(), entries.end(), [](const sparse_entry<T>& a, const sparse_entry<T>& b) {
+                return a.row != b.row ? a.row < b.row : a.column < b.column;
+            });
+
+            col_idx.reserve(entries.size());
+            vals.reserve(entries.size());
+            for (size_t k = 0; k < entries.size(); ++k) {
+                const auto& e = entries[k];
+                if (k > 0 && entries[k - 1].row == e.row && entries[k - 1].column == e.column) {
+                    vals.back() = vals.back() + e.value;
+                    continue;
+                }
+                col_idx.push_back(e.column - 1);
+                vals.push_back(e.value);
+                ++row_ptr[e.row];
+            }
+
+            for (size_t i = 0; i < rows; ++i)
+                row_ptr[i + 1] += row_ptr[i];
+        }
+
+        // Keeps every nonzero entry of the dense matrix.
+        explicit csr_matrix(const matrix_base<T>& dense)
+            : num_row(dense.size_row()), num_col(dense.size_col()), row_ptr(dense.size_row() + 1, 0) {
+            const T* data = dense.raw_data();
+            for (size_t i = 0; i < num_row; ++i) {
+                for (size_t j = 0; j < num_col; ++j) {
+                    const T& value = data[i * num_col + j];
+                    if (value != 0) {
+                        col_idx.push_back(j);
+                        vals.push_back(value);
+                    }
+                }
+                row_ptr[i + 1] = col_idx.size();
+            }
+        }
+
+        [[nodiscard]] size_t size_row() const { return num_row; }
+
+        [[nodiscard]] size_t size_col() const { return num_col; }
+
+        [[nodiscard]] size_t nonzeros() const { return vals.size(); }
+
+        [[nodiscard]] const std::vector<size_t>& row_pointers() const { return row_ptr; }
+
+        [[nodiscard]] const std::vector<size_t>& column_indices() const { return col_idx; }
+
+        [[nodiscard]] const std::vector<T>& values() const { return vals; }
+
+        // Only the values may be changed, the sparsity pattern is fixed.
+        std::vector<T>& values() { return vals; }
+
+        // 1-indexed like matrix_base, entries that are not stored read as zero.
+        T operator()(size_t row, size_t column) const {
+            if (row == 0 || column == 0 || row > num_row || column > num_col)
+                throw std::out_of_range("Requested element lies outside of the Matrix.");
+
+            auto begin = col_idx.begin() + row_ptr[row - 1];
+            auto end = col_idx.begin() + row_ptr[row];
+            auto found = std::lower_bound(begin, end, column - 1);
+            if (found == end || *found != column - 1)
+                return T{};
+            return vals[found - col_idx.begin()];
+        }
+
+        [[nodiscard]] matrix_base<T> to_dense() const {
+            matrix_base<T> result{num_row, num_col};
+            T* data = result.raw_data();
+            for (size_t i = 0; i < num_row; ++i) {
+                for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    data[i * num_col + col_idx[k]] = vals[k];
+            }
+            return result;
+        }
+
+        // Linear operator interface, y = A x.
+        [[nodiscard]] size_t size() const { return num_row; }
+
+        void apply(std::span<const T> x, std::span<T> y) const {
+            if (x.size() != num_col || y.size() != num_row)
+                throw std::domain_error("Vector sizes do not match the matrix");
+
+            auto rows = [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    T sum = T{};
+                    for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                        sum = sum + vals[k] * x[col_idx[k]];
+                    y[i] = sum;
+                }
+            };
+
+            // Split by rows once there is enough work to amortize the hand off
+            constexpr size_t grain = 4096;
+            if (vals.size() < grain * 4) {
+                rows(0, num_row);
+            } else {
+                m_parallel::parallel_for(0, num_row, grain, rows);
+            }
+        }
+    };
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_SPARSE_HPP
@@ -0,0 +1,517 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_TEXTIO_HPP
+#define MMATH_MMATH_TEXTIO_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mmath.hpp"
+#include "mmath_binary.hpp"
+#include "mmath_format.hpp"
+#include "mmath_parallel.hpp"
+#include "mmath_sparse.hpp"
+
+namespace mmath {
+
+    struct csv_options {
+        // A space or tab delimiter matches any run of blanks.
+        char delimiter = ',';
+        // Skip the first non blank line.
+        bool header = false;
+    };
+
+    namespace m_text {
+
+        // Bytes of input scanned per task when locating line starts.
+        constexpr size_t scan_chunk = size_t{1} << 20;
+        // Lines parsed per task.
+        constexpr size_t parse_grain = 1024;
+
+        inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+        // Read only mapping of a whole file, exposed as text.
+        class mapped_text {
+          private:
+            void* mapping = nullptr;
+            size_t length = 0;
+
+          public:
+            explicit mapped_text(const std::string& path) {
+                m_binary::file_handle file{path, O_RDONLY};
+
+                struct stat info {};
+                if (::fstat(file.get(), &info) != 0)
+                    m_binary::throw_errno("Unable to stat " + path);
+
+                length = static_cast<size_t>(info.st_size);
+                if (length == 0)
+                    return;
+
+                mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.get(), 0);
+                if (mapping == MAP_FAILED) {
+                    mapping = nullptr;
+                    m_binary::throw_errno("Unable to map " + path);
+                }
+                ::madvise(mapping, length, MADV_SEQUENTIAL);
+            }
+
+            mapped_text(const mapped_text&) = delete;
+            mapped_text& operator=(const mapped_text&) = delete;
+
+            ~mapped_text() {
+                if (mapping != nullptr)
+                    ::munmap(mapping, length);
+            }
+
+            [[nodiscard]] std::string_view text() const {
+                return mapping == nullptr ? std::string_view{} : std::string_view{static_cast<const char*>(mapping), length};
+            }
+        };
+
+        [[nodiscard]] inline size_t line_end(std::string_view text, size_t start) {
+            const void* found = std::memchr(text.data() + start, '\n', text.size() - start);
+            return found == nullptr ? text.size() : static_cast<const char*>(found) - text.data();
+        }
+
+        // Offsets of every line in text[offset, end) holding something other than
+        // blanks, skipping lines that begin with comment when it is nonzero. The
+        // text is split into chunks scanned in parallel, so the row count is
+        // known before anything is parsed.
+        inline std::vector<size_t> line_starts(std::string_view text, size_t offset, char comment = '\0') {
+            offset = std::min(offset, text.size());
+            size_t length = text.size() - offset;
+            size_t num_chunks = std::max<size_t>(1, (length + scan_chunk - 1) / scan_chunk);
+            std::vector<std::vector<size_t>> found(num_chunks);
+
+            m_parallel::parallel_for(0, num_chunks, 1, [&](size_t lo, size_t hi) {
+                for (size_t chunk = lo; chunk < hi; ++chunk) {
+                    size_t begin = offset + chunk * scan_chunk;
+                    size_t end = std::min(text.size(), begin + scan_chunk);
+
+                    // A line belongs to the chunk its first character lies in
+                    size_t pos = begin;
+                    if (pos > offset && text[pos - 1] != '\n')
+                        pos = line_end(text, pos) + 1;
+
+                    while (pos < end) {
+                        size_t first = pos;
+                        while (first < text.size() && is_blank(text[first]))
+                            ++first;
+                        if (first < text.size() && text[first] != '\n' && (comment == '\0' || text[first] != comment))
+                            found[chunk].push_back(pos);
+                        pos = line_end(text, pos) + 1;
+                    }
+                }
+            });
+
+            std::vector<size_t> starts;
+            size_t total = 0;
+            for (auto& chunk : found)
+                total += chunk.size();
+            starts.reserve(total);
+            for (auto& chunk : found)
+                starts.insert(starts.end(), chunk.begin(), chunk.end());
+            return starts;
+        }
+
+        // Parses one value after any leading blanks, returning the position past
+        // it or nullptr when there is no valid value.
+        template <numeric T>
+        const char* parse_value(const char* first, const char* last, T& value) {
+            while (first != last && is_blank(*first))
+                ++first;
+            if (first != last && *first == '+')
+                ++first;
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            return ec == std::errc{} ? ptr : nullptr;
+        }
+
+        inline const char* skip_blanks(const char* first, const char* last) {
+            while (first != last && is_blank(*first))
+                ++first;
+            return first;
+        }
+
+        inline size_t count_fields(std::string_view line, char delimiter) {
+            if (is_blank(delimiter) || delimiter == '\0') {
+                size_t fields = 0;
+                for (size_t i = 0; i < line.size(); ++i) {
+                    if (!is_blank(line[i]) && (i == 0 || is_blank(line[i - 1])))
+                        ++fields;
+                }
+                return fields;
+            }
+            return static_cast<size_t>(std::count(line.begin(), line.end(), delimiter)) + 1;
+        }
+
+        // Parses exactly count values separated by delimiter into out.
+        template <numeric T>
+        bool parse_fields(const char* first, const char* last, char delimiter, T* out, size_t count) {
+            bool blank_delimiter = is_blank(delimiter) || delimiter == '\0';
+            for (size_t c = 0; c < count; ++c) {
+                first = parse_value(first, last, out[c]);
+                if (first == nullptr)
+                    return false;
+                if (c + 1 == count)
+                    break;
+                if (blank_delimiter) {
+                    if (first == last || !is_blank(*first))
+                        return false;
+                } else {
+                    first = skip_blanks(first, last);
+                    if (first == last || *first != delimiter)
+                        return false;
+                    ++first;
+                }
+            }
+            return skip_blanks(first, last) == last;
+        }
+
+        // Builds compressed rows from unordered 0-indexed entries, summing
+        // duplicates. Rows are bucketed with a counting sort, so only the columns
+        // within each row still need sorting.
+        template <numeric T>
+        csr_matrix<T> build_csr(size_t rows, size_t cols, const std::vector<sparse_entry<T>>& entries) {
+            std::vector<size_t> row_ptr(rows + 1, 0);
+            for (const auto& e : entries)
+                ++row_ptr[e.row + 1];
+            for (size_t i = 0; i < rows; ++i)
+                row_ptr[i + 1] += row_ptr[i];
+
+            std::vector<std::pair<size_t, T>> placed(entries.size());
+            std::vector<size_t> cursor(row_ptr.begin(), row_ptr.end() - 1);
+            for (const auto& e : entries)
+                placed[cursor[e.row]++] = {e.column, e.value};
+
+            m_parallel::parallel_for(0, rows, parse_grain, [&](size_t lo, size_t hi) {
+                auto by_column = [](const auto& a, const auto& b) { return a.first < b.first; };
+                for (size_t i = lo; i < hi; ++i) {
+                    auto begin = placed.begin() + row_ptr[i], end = placed.begin() + row_ptr[i + 1];
+                    if (!std::is_sorted(begin, end, by_column))
+                        std::stable_sort(begin, end, by_column);
+                }
+            });
+
+            std::vector<size_t> compact_ptr(rows + 1, 0), col_idx;
+            std::vector<T> vals;
+            col_idx.reserve(placed.size());
+            vals.reserve(placed.size());
+            for (size_t i = 0; i < rows; ++i) {
+                for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                    if (k > row_ptr[i] && placed[k].first == placed[k - 1].first) {
+                        vals.back() = vals.back() + placed[k].second;
+                        continue;
+                    }
+                    col_idx.push_back(placed[k].first);
+                    vals.push_back(placed[k].second);
+                }
+                compact_ptr[i + 1] = col_idx.size();
+            }
+
+            return csr_matrix<T>{rows, cols, std::move(compact_ptr), std::move(col_idx), std::move(vals)};
+        }
+
+        /*
+         * MATRIX MARKET
+         */
+
+        enum class mm_field { REAL, INTEGER, PATTERN };
+        enum class mm_symmetry { GENERAL, SYMMETRIC, SKEW_SYMMETRIC };
+
+        struct mm_info {
+            bool coordinate = true;
+            mm_field field = mm_field::REAL;
+            mm_symmetry symmetry = mm_symmetry::GENERAL;
+            size_t rows = 0, cols = 0, entries = 0;
+            size_t body = 0;
+        };
+
+        inline std::string lower(std::string_view s) {
+            std::string result{s};
+            for (auto& c : result)
+                c = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            return result;
+        }
+
+        inline mm_info parse_mm_header(std::string_view text) {
+            mm_info info;
+            size_t end = line_end(text, 0);
+            std::string banner = lower(text.substr(0, end));
+
+            std::vector<std::string> tokens;
+            for (size_t pos = 0; pos < banner.size();) {
+                while (pos < banner.size() && is_blank(banner[pos]))
+                    ++pos;
+                size_t stop = pos;
+                while (stop < banner.size() && !is_blank(banner[stop]))
+                    ++stop;
+                if (stop > pos)
+                    tokens.push_back(banner.substr(pos, stop - pos));
+                pos = stop;
+            }
+
+            if (tokens.size() != 5 || tokens[0] != "%%matrixmarket" || tokens[1] != "matrix")
+                throw std::invalid_argument("Missing MatrixMarket banner");
+
+            if (tokens[2] == "coordinate")
+                info.coordinate = true;
+            else if (tokens[2] == "array")
+                info.coordinate = false;
+            else
+                throw std::invalid_argument("Unknown MatrixMarket format " + tokens[2]);
+
+            if (tokens[3] == "real" || tokens[3] == "double")
+                info.field = mm_field::REAL;
+            else if (tokens[3] == "integer")
+                info.field = mm_field::INTEGER;
+            else if (tokens[3] == "pattern" && info.coordinate)
+                info.field = mm_field::PATTERN;
+            else
+                throw std::invalid_argument("Unsupported MatrixMarket field " + tokens[3]);
+
+            if (tokens[4] == "general")
+                info.symmetry = mm_symmetry::GENERAL;
+            else if (tokens[4] == "symmetric")
+                info.symmetry = mm_symmetry::SYMMETRIC;
+            else if (tokens[4] == "skew-symmetric")
+                info.symmetry = mm_symmetry::SKEW_SYMMETRIC;
+            else
+                throw std::invalid_argument("Unsupported MatrixMarket symmetry " + tokens[4]);
+
+            // Skip comments and blank lines up to the size line
+            size_t pos = end + 1;
+            while (pos < text.size()) {
+                size_t stop = line_end(text, pos);
+                const char* first = skip_blanks(text.data() + pos, text.data() + stop);
+                if (first != text.data() + stop && *first != '%') {
+                    const char* last = text.data() + stop;
+                    first = parse_value(first, last, info.rows);
+                    if (first != nullptr)
+                        first = parse_value(first, last, info.cols);
+                    if (first != nullptr && info.coordinate)
+                        first = parse_value(first, last, info.entries);
+                    if (first == nullptr || skip_blanks(first, last) != last)
+                        throw std::invalid_argument("Malformed MatrixMarket size line");
+                    info.body = stop + 1;
+                    break;
+                }
+                pos = stop + 1;
+            }
+
+            if (info.body == 0)
+                throw std::invalid_argument("Missing MatrixMarket size line");
+            if (info.symmetry != mm_symmetry::GENERAL && info.rows != info.cols)
+                throw std::invalid_argument("Symmetric MatrixMarket matrices must be square");
+            return info;
+        }
+
+        // Every stored entry, 0-indexed, with the mirrored half of symmetric
+        // matrices filled in.
+        template <numeric T>
+        std::vector<sparse_entry<T>> parse_mm_coordinate(std::string_view text, const mm_info& info) {
+            std::vector<size_t> starts = line_starts(text, info.body, '%');
+            if (starts.size() != info.entries)
+                throw std::invalid_argument("MatrixMarket entry count does not match the size line");
+
+            std::vector<sparse_entry<T>> entries(starts.size());
+            m_parallel::parallel_for(0, starts.size(), parse_grain, [&](size_t lo, size_t hi) {
+                for (size_t k = lo; k < hi; ++k) {
+                    const char* first = text.data() + starts[k];
+                    const char* last = text.data() + line_end(text, starts[k]);
+                    sparse_entry<T>& e = entries[k];
+
+                    first = parse_value(first, last, e.row);
+                    if (first != nullptr)
+                        first = parse_value(first, last, e.column);
+                    e.value = T{1};
+                    if (first != nullptr && info.field != mm_field::PATTERN)
+                        first = parse_value(first, last, e.value);
+
+                    if (first == nullptr || skip_blanks(first, last) != last)
+                        throw std::invalid_argument("Malformed MatrixMarket entry " + std::to_string(k + 1));
+                    if (e.row == 0 || e.column == 0 || e.row > info.rows || e.column > info.cols)
+                        throw std::out_of_range("MatrixMarket entry " + std::to_string(k + 1) +
+                                                " lies outside of the Matrix.");
+                    --e.row;
+                    --e.column;
+                }
+            });
+
+            if (info.symmetry != mm_symmetry::GENERAL) {
+                size_t stored = entries.size();
+                for (size_t k = 0; k < stored; ++k) {
+                    sparse_entry<T> e = entries[k];
+                    if (e.row == e.column)
+                        continue;
+                    T mirrored = info.symmetry == mm_symmetry::SKEW_SYMMETRIC ? T{} - e.value : e.value;
+                    entries.push_back({e.column, e.row, mirrored});
+                }
+            }
+            return entries;
+        }
+
+        // Array bodies list columns top to bottom; symmetric ones store only the
+        // lower triangle, so each column is parsed independently.
+        template <numeric T>
+        matrix_base<T> parse_mm_array(std::string_view text, const mm_info& info) {
+            std::vector<size_t> starts = line_starts(text, info.body, '%');
+            const size_t rows = info.rows, cols = info.cols;
+
+            auto first_row = [&](size_t j) -> size_t {
+                switch (info.symmetry) {
+                    case mm_symmetry::SYMMETRIC: return j;
+                    case mm_symmetry::SKEW_SYMMETRIC: return j + 1;
+                    default: return 0;
+                }
+            };
+
+            std::vector<size_t> column_start(cols + 1, 0);
+            for (size_t j = 0; j < cols; ++j)
+                column_start[j + 1] = column_start[j] + (rows - std::min(rows, first_row(j)));
+            if (starts.size() != column_start[cols])
+                throw std::invalid_argument("MatrixMarket value count does not match the size line");
+
+            matrix_base<T> result{rows, cols};
+            T* data = result.raw_data();
+
+            m_parallel::parallel_for(0, cols, 1, [&](size_t lo, size_t hi) {
+                for (size_t j = lo; j < hi; ++j) {
+                    size_t k = column_start[j];
+                    for (size_t i = first_row(j); i < rows; ++i, ++k) {
+                        const char* last = text.data() + line_end(text, starts[k]);
+                        T value{};
+                        const char* end = parse_value(text.data() + starts[k], last, value);
+                        if (end == nullptr || skip_blanks(end, last) != last)
+                            throw std::invalid_argument("Malformed MatrixMarket value " + std::to_string(k + 1));
+
+                        data[i * cols + j] = value;
+                        if (info.symmetry == mm_symmetry::SYMMETRIC && i != j)
+                            data[j * cols + i] = value;
+                        else if (info.symmetry == mm_symmetry::SKEW_SYMMETRIC)
+                            data[j * cols + i] = T{} - value;
+                    }
+                }
+            });
+            return result;
+        }
+    }  // namespace m_text
+
+    /*
+     * CSV
+     */
+
+    // Every non blank line is a row and all rows must have the same number of
+    // fields. Rows are located up front so the matrix is allocated once, then
+    // parsed in parallel.
+    template <numeric T>
+    matrix_base<T> parse_csv(std::string_view text, const csv_options& options = {}) {
+        std::vector<size_t> starts = m_text::line_starts(text, 0);
+        size_t skip = options.header && !starts.empty() ? 1 : 0;
+        if (starts.size() == skip)
+            return matrix_base<T>{};
+
+        size_t rows = starts.size() - skip;
+        size_t cols = m_text::count_fields(text.substr(starts[skip], m_text::line_end(text, starts[skip]) - starts[skip]),
+                                           options.delimiter);
+
+        // Every field is parsed into place or the parse throws
+        matrix_base<T> result{rows, cols, for_overwrite};
+        T* data = result.raw_data();
+
+        m_parallel::parallel_for(0, rows, m_text::parse_grain, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                size_t start = starts[i + skip];
+                const char* last = text.data() + m_text::line_end(text, start);
+                if (!m_text::parse_fields(text.data() + start, last, options.delimiter, data + i * cols, cols))
+                    throw std::invalid_argument("Malformed CSV row " + std::to_string(i + 1));
+            }
+        });
+        return result;
+    }
+
+    template <numeric T>
+    matrix_base<T> read_csv(const std::string& path, const csv_options& options = {}) {
+        m_text::mapped_text file{path};
+        return parse_csv<T>(file.text(), options);
+    }
+
+    // Writes with the shortest representation that reads back exactly unless a
+    // precision is given. Blocks of rows are formatted in parallel; the header
+    // option does not apply when writing.
+    template <expression_printable T>
+    void write_csv(std::ostream& os, const matrix_base<T>& matrix, const csv_options& options = {}, int precision = -1) {
+        format_options format;
+        format.column_delimiter = std::string(1, options.delimiter);
+        format.precision = precision;
+        format.trailing_row_delimiter = true;
+        m_format::write_parallel(os, matrix.raw_data(), matrix.size_row(), matrix.size_col(), format);
+    }
+
+    template <expression_printable T>
+    void write_csv(const std::string& path,
+                   const matrix_base<T>& matrix,
+                   const csv_options& options = {},
+                   int precision = -1) {
+        std::ofstream out{path, std::ios::binary};
+        if (!out)
+            throw std::runtime_error("Unable to open " + path);
+        write_csv(out, matrix, options, precision);
+        if (!out)
+            throw std::runtime_error("Failed writing " + path);
+    }
+
+    /*
+     * MATRIX MARKET
+     */
+
+    // Supports the real, integer and pattern fields with general, symmetric and
+    // skew-symmetric storage, in both coordinate and array format.
+    template <numeric T>
+    matrix_base<T> parse_matrix_market(std::string_view text) {
+        m_text::mm_info info = m_text::parse_mm_header(text);
+        if (!info.coordinate)
+            return m_text::parse_mm_array<T>(text, info);
+
+        auto entries = m_text::parse_mm_coordinate<T>(text, info);
+        matrix_base<T> result{info.rows, info.cols};
+        T* data = result.raw_data();
+        for (const auto& e : entries)
+            data[e.row * info.cols + e.column] = data[e.row * info.cols + e.column] + e.value;
+        return result;
+    }
+
+    template <numeric T>
+    csr_matrix<T> parse_matrix_market_sparse(std::string_view text) {
+        m_text::mm_info info = m_text::parse_mm_header(text);
+        if (!info.coordinate)
+            return csr_matrix<T>{m_text::parse_mm_array<T>(text, info)};
+        return m_text::build_csr(info.rows, info.cols, m_text::parse_mm_coordinate<T>(text, info));
+    }
+
+    template <numeric T>
+    matrix_base<T> read_matrix_market(const std::string& path) {
+        m_text::mapped_text file{path};
+        return parse_matrix_market<T>(file.text());
+    }
+
+    template <numeric T>
+    csr_matrix<T> read_matrix_market_sparse(const std::string& path) {
+        m_text::mapped_text file{path};
+        return parse_matrix_market_sparse<T>(file.text());
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_TEXTIO_HPP
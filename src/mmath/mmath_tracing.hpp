@@ -0,0 +1,271 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_TRACING_HPP
+#define MMATH_MMATH_TRACING_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "mmath_instrumentation.hpp"
+#include "mmath_tuning.hpp"
+
+namespace mmath {
+
+    /*
+     * TRACING
+     *
+     * Define MMATH_TRACING before including mmath to record a timeline of
+     * matrix operations, viewable in Perfetto or chrome://tracing once written
+     * out with write_chrome_trace. Recording starts switched off; while it is
+     * off each operation costs one relaxed atomic load. Without MMATH_TRACING
+     * the hooks compile to nothing.
+     *
+     * Every thread records into its own ring buffer of trace_buffer_events
+     * events, overwriting the oldest once full, so recording never locks or
+     * allocates after the first event of a thread. The buffer of an exited
+     * thread is handed to the next new thread once its events have been
+     * written out or cleared, or once more than trace_retired_buffers such
+     * buffers wait, so threads coming and going do not grow memory without
+     * bound. The new thread takes over its tid as well. Each event holds the
+     * operation, its start and duration, the thread, the element type and the
+     * shape: rows x cols of the result, plus the inner dimension of a product.
+     */
+
+#ifndef MMATH_TRACE_BUFFER_EVENTS
+#define MMATH_TRACE_BUFFER_EVENTS 16384
+#endif
+
+    inline constexpr size_t trace_buffer_events = MMATH_TRACE_BUFFER_EVENTS;
+
+    // Buffers of exited threads kept with events not yet written out.
+    inline constexpr size_t trace_retired_buffers = 16;
+
+    namespace m_trace {
+
+        // One slot of a ring buffer. The sequence is odd while the owning thread
+        // writes the slot, so a reader can tell a torn event from a whole one.
+        struct slot {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<uint64_t> op{0};
+            std::atomic<const char*> type{nullptr};
+            std::atomic<uint64_t> rows{0}, cols{0}, inner{0};
+            std::atomic<int64_t> start{0}, duration{0};
+        };
+
+        struct thread_buffer {
+            uint64_t thread = 0;
+            std::atomic<uint64_t> written{0};
+            // Events up to here were written out or cleared, guarded by the
+            // registry mutex
+            uint64_t seen = 0;
+            std::array<slot, trace_buffer_events> slots;
+        };
+
+        struct registry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<thread_buffer>> buffers;
+            // Buffers of exited threads, oldest first
+            std::vector<std::shared_ptr<thread_buffer>> retired;
+            std::atomic<bool> enabled{false};
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        inline registry& global_registry() {
+            static registry instance;
+            return instance;
+        }
+
+        // Takes a retired buffer whose events were all seen, or the oldest one
+        // when too many wait, and otherwise registers a new buffer.
+        inline std::shared_ptr<thread_buffer> claim_buffer() {
+            registry& r = global_registry();
+            std::lock_guard lock{r.mutex};
+            auto reusable = std::find_if(r.retired.begin(), r.retired.end(), [](const auto& buffer) {
+                return buffer->seen == buffer->written.load(std::memory_order_relaxed);
+            });
+            if (reusable == r.retired.end() && r.retired.size() > trace_retired_buffers)
+                reusable = r.retired.begin();
+            if (reusable != r.retired.end()) {
+                auto buffer = *reusable;
+                r.retired.erase(reusable);
+                buffer->written.store(0, std::memory_order_relaxed);
+                buffer->seen = 0;
+                return buffer;
+            }
+
+            auto created = std::make_shared<thread_buffer>();
+            created->thread = r.buffers.size() + 1;
+            r.buffers.push_back(created);
+            return created;
+        }
+
+        // Hands the buffer back for reuse when its thread exits.
+        class buffer_owner {
+          private:
+            std::shared_ptr<thread_buffer> buffer = claim_buffer();
+
+          public:
+            buffer_owner() = default;
+            buffer_owner(const buffer_owner&) = delete;
+            buffer_owner& operator=(const buffer_owner&) = delete;
+
+            ~buffer_owner() {
+                registry& r = global_registry();
+                std::lock_guard lock{r.mutex};
+                r.retired.push_back(std::move(buffer));
+            }
+
+            thread_buffer& get() { return *buffer; }
+        };
+
+        inline thread_buffer& local_buffer() {
+            thread_local buffer_owner owner;
+            return owner.get();
+        }
+
+        inline int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                        global_registry().epoch)
+                .count();
+        }
+
+        // Nanoseconds as microseconds with three decimals, independent of the
+        // formatting state of the output stream.
+        inline std::array<char, 32> microseconds(int64_t nanoseconds) {
+            std::array<char, 32> text{};
+            std::snprintf(text.data(), text.size(), "%lld.%03lld", static_cast<long long>(nanoseconds / 1000),
+                          static_cast<long long>(nanoseconds % 1000));
+            return text;
+        }
+
+#ifdef MMATH_TRACING
+        // Records one operation over its lifetime when tracing is switched on.
+        template <typename T>
+        class scope {
+          private:
+            operation op;
+            uint64_t rows, cols, inner;
+            int64_t start = -1;
+
+          public:
+            scope(operation op, uint64_t rows, uint64_t cols, uint64_t inner = 0)
+                : op(op), rows(rows), cols(cols), inner(inner) {
+                if (global_registry().enabled.load(std::memory_order_relaxed))
+                    start = now();
+            }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            ~scope() {
+                if (start < 0)
+                    return;
+                const int64_t end = now();
+                thread_buffer& buffer = local_buffer();
+                const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+                slot& s = buffer.slots[index % trace_buffer_events];
+
+                const uint64_t sequence = s.sequence.load(std::memory_order_relaxed);
+                s.sequence.store(sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                s.op.store(static_cast<uint64_t>(op), std::memory_order_relaxed);
+                s.type.store(type_name<T>(), std::memory_order_relaxed);
+                s.rows.store(rows, std::memory_order_relaxed);
+                s.cols.store(cols, std::memory_order_relaxed);
+                s.inner.store(inner, std::memory_order_relaxed);
+                s.start.store(start, std::memory_order_relaxed);
+                s.duration.store(end - start, std::memory_order_relaxed);
+                s.sequence.store(sequence + 2, std::memory_order_release);
+                buffer.written.store(index + 1, std::memory_order_release);
+            }
+        };
+#else
+        template <typename T>
+        class scope {
+          public:
+            scope(operation, uint64_t, uint64_t, uint64_t = 0) {}
+        };
+#endif
+    }  // namespace m_trace
+
+    // Switches recording on or off at run time. Has no effect unless
+    // MMATH_TRACING is defined.
+    inline void set_tracing(bool enabled) {
+        m_trace::global_registry().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline bool tracing_enabled() {
+        return m_trace::global_registry().enabled.load(std::memory_order_relaxed);
+    }
+
+    // Drops every recorded event. Events being recorded concurrently may
+    // survive.
+    inline void clear_trace() {
+        m_trace::registry& r = m_trace::global_registry();
+        std::lock_guard lock{r.mutex};
+        for (auto& buffer : r.buffers) {
+            for (auto& s : buffer->slots)
+                s.duration.store(-1, std::memory_order_relaxed);
+            buffer->seen = buffer->written.load(std::memory_order_acquire);
+        }
+    }
+
+    // Writes the recorded events as Chrome trace JSON, one complete ("X") event
+    // per operation with times in microseconds. Safe to call while other
+    // threads keep recording, though events overwritten during the call may be
+    // skipped or replaced by newer ones.
+    inline void write_chrome_trace(std::ostream& os) {
+        m_trace::registry& r = m_trace::global_registry();
+        std::lock_guard lock{r.mutex};
+
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        bool first = true;
+        for (const auto& buffer : r.buffers) {
+            os << (first ? "" : ",") << "\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+               << buffer->thread << ", \"args\": {\"name\": \"mmath thread " << buffer->thread << "\"}}";
+            first = false;
+
+            const uint64_t written = buffer->written.load(std::memory_order_acquire);
+            buffer->seen = written;
+            const uint64_t oldest = written > trace_buffer_events ? written - trace_buffer_events : 0;
+            for (uint64_t index = oldest; index < written; ++index) {
+                const m_trace::slot& s = buffer->slots[index % trace_buffer_events];
+                const uint64_t before = s.sequence.load(std::memory_order_acquire);
+                const auto op = s.op.load(std::memory_order_relaxed);
+                const char* type = s.type.load(std::memory_order_relaxed);
+                const auto rows = s.rows.load(std::memory_order_relaxed);
+                const auto cols = s.cols.load(std::memory_order_relaxed);
+                const auto inner = s.inner.load(std::memory_order_relaxed);
+                const auto start = s.start.load(std::memory_order_relaxed);
+                const auto duration = s.duration.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (before % 2 != 0 || s.sequence.load(std::memory_order_relaxed) != before || duration < 0 ||
+                    op >= m_stats::operation_count)
+                    continue;
+
+                os << ",\n{\"name\": \"" << m_stats::operation_names[op] << "\", \"cat\": \"mmath\", \"ph\": \"X\", "
+                   << "\"ts\": " << m_trace::microseconds(start).data()
+                   << ", \"dur\": " << m_trace::microseconds(duration).data() << ", \"pid\": 1, \"tid\": "
+                   << buffer->thread << ", \"args\": {\"type\": \"" << type << "\", \"rows\": " << rows
+                   << ", \"cols\": " << cols;
+                if (inner != 0)
+                    os << ", \"inner\": " << inner;
+                os << "}}";
+            }
+        }
+        os << "\n]}\n";
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_TRACING_HPP
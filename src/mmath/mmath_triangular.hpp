@@ -0,0 +1,210 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_TRIANGULAR_HPP
+#define MMATH_MMATH_TRIANGULAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "mmath.hpp"
+#include "mmath_gemm.hpp"
+#include "mmath_parallel.hpp"
+#include "mmath_tuning.hpp"
+
+namespace mmath {
+
+    enum class triangle_type { UPPER, LOWER };
+
+    enum class diagonal_type { NON_UNIT, UNIT };
+
+    enum class transpose_type { NONE, TRANSPOSE };
+
+    namespace m_kernel {
+
+        struct trsm_config {
+            // Rows solved by plain substitution before the rest is updated by gemm.
+            size_t block_size = 64;
+            // Right hand side columns handed to each thread.
+            size_t column_panel = 64;
+        };
+
+        // The trsm.* settings for the given element type over the defaults.
+        inline trsm_config trsm_config_from(const tuning_settings& settings, const char* type) {
+            trsm_config config;
+            config.block_size = m_tuning::lookup(settings, "trsm", type, "block_size", config.block_size);
+            config.column_panel = m_tuning::lookup(settings, "trsm", type, "column_panel", config.column_panel);
+            return config;
+        }
+
+        // Blocking of triangular solves and LU factorizations of T.
+        template <typename T = void>
+        trsm_config& trsm_tuning() {
+            static trsm_config config = trsm_config_from(m_tuning::startup_settings(), m_tuning::type_key<T>());
+            return config;
+        }
+
+        namespace detail {
+            // Substitution within one diagonal block, rows [begin, end) of B.
+            // op_a(i, j) is A(i, j), or A(j, i) when the solve is transposed.
+            template <expression T>
+            void trsm_diagonal_block(size_t begin,
+                                     size_t end,
+                                     size_t nrhs,
+                                     const T* a,
+                                     size_t rs,
+                                     size_t cs,
+                                     T* b,
+                                     size_t ldb,
+                                     bool forward,
+                                     bool unit) {
+                for (size_t step = 0; step < end - begin; ++step) {
+                    size_t i = forward ? begin + step : end - 1 - step;
+                    T* b_i = b + i * ldb;
+
+                    size_t p_begin = forward ? begin : i + 1;
+                    size_t p_end = forward ? i : end;
+                    for (size_t p = p_begin; p < p_end; ++p) {
+                        const T a_ip = a[i * rs + p * cs];
+                        const T* b_p = b + p * ldb;
+                        for (size_t j = 0; j < nrhs; ++j)
+                            b_i[j] = b_i[j] - a_ip * b_p[j];
+                    }
+
+                    if (!unit) {
+                        const T a_ii = a[i * rs + i * cs];
+                        if (a_ii == 0)
+                            throw std::domain_error("Triangular matrix is singular");
+                        for (size_t j = 0; j < nrhs; ++j)
+                            b_i[j] = b_i[j] / a_ii;
+                    }
+                }
+            }
+
+            template <expression T>
+            void trsm_panel(size_t n,
+                            size_t nrhs,
+                            const T* a,
+                            size_t rs,
+                            size_t cs,
+                            T* b,
+                            size_t ldb,
+                            bool lower,
+                            bool unit,
+                            bool allow_parallel) {
+                const size_t nb = std::max<size_t>(trsm_tuning<T>().block_size, 1);
+
+                if (lower) {
+                    for (size_t k = 0; k < n; k += nb) {
+                        size_t k_end = std::min(n, k + nb);
+                        trsm_diagonal_block(k, k_end, nrhs, a, rs, cs, b, ldb, true, unit);
+                        // B[k_end:n] -= op(A)[k_end:n, k:k_end] * X[k:k_end]
+                        gemm<T, true>(n - k_end, nrhs, k_end - k, a + k_end * rs + k * cs, rs, cs, b + k * ldb, ldb,
+                                      b + k_end * ldb, ldb, allow_parallel);
+                    }
+                } else {
+                    for (size_t k_end = n; k_end > 0;) {
+                        size_t k = k_end > nb ? k_end - nb : 0;
+                        trsm_diagonal_block(k, k_end, nrhs, a, rs, cs, b, ldb, false, unit);
+                        // B[0:k] -= op(A)[0:k, k:k_end] * X[k:k_end]
+                        gemm<T, true>(k, nrhs, k_end - k, a + k * cs, rs, cs, b + k * ldb, ldb, b, ldb,
+                                      allow_parallel);
+                        k_end = k;
+                    }
+                }
+            }
+        }  // namespace detail
+
+        // Solves op(A) X = B in place of B, where A is an n x n triangular matrix
+        // (row major, leading dimension lda) and B is n x nrhs (row major,
+        // leading dimension ldb). Only the triangle named by uplo is read.
+        template <expression T>
+        void trsm(size_t n,
+                  size_t nrhs,
+                  const T* a,
+                  size_t lda,
+                  T* b,
+                  size_t ldb,
+                  triangle_type uplo,
+                  diagonal_type diag = diagonal_type::NON_UNIT,
+                  transpose_type trans = transpose_type::NONE) {
+            if (n == 0 || nrhs == 0)
+                return;
+
+            bool transposed = trans == transpose_type::TRANSPOSE;
+            size_t rs = transposed ? 1 : lda;
+            size_t cs = transposed ? lda : 1;
+            // Transposing swaps which triangle is populated
+            bool lower = (uplo == triangle_type::LOWER) != transposed;
+            bool unit = diag == diagonal_type::UNIT;
+
+            const size_t panel = std::max<size_t>(trsm_tuning<T>().column_panel, 1);
+
+            if (nrhs <= panel) {
+                detail::trsm_panel(n, nrhs, a, rs, cs, b, ldb, lower, unit, true);
+                return;
+            }
+
+            // Right hand side columns are independent, so each thread solves its
+            // own panel of columns with single threaded gemm updates.
+            size_t num_panels = (nrhs + panel - 1) / panel;
+            m_parallel::parallel_for(0, num_panels, 1, [&](size_t lo, size_t hi) {
+                size_t col_begin = lo * panel;
+                size_t col_end = std::min(nrhs, hi * panel);
+                detail::trsm_panel(n, col_end - col_begin, a, rs, cs, b + col_begin, ldb, lower, unit, false);
+            });
+        }
+
+        // Single right hand side version of trsm.
+        template <expression T>
+        void trsv(size_t n,
+                  const T* a,
+                  size_t lda,
+                  T* x,
+                  triangle_type uplo,
+                  diagonal_type diag = diagonal_type::NON_UNIT,
+                  transpose_type trans = transpose_type::NONE) {
+            trsm(n, 1, a, lda, x, 1, uplo, diag, trans);
+        }
+    }  // namespace m_kernel
+
+    // Returns X solving op(A) X = B for a triangular A. Each column of B is a
+    // separate right hand side.
+    template <expression T>
+    matrix_base<T> trsm(const matrix_base<T>& a,
+                        const matrix_base<T>& b,
+                        triangle_type uplo,
+                        diagonal_type diag = diagonal_type::NON_UNIT,
+                        transpose_type trans = transpose_type::NONE) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to solve a triangular system");
+        if (a.size_row() != b.size_row())
+            throw std::domain_error("The right hand side must have as many rows as the triangular matrix");
+
+        matrix_base<T> result = b;
+        m_kernel::trsm(a.size_row(), b.size_col(), a.raw_data(), a.size_col(), result.raw_data(), b.size_col(), uplo,
+                       diag, trans);
+        return result;
+    }
+
+    // Returns x solving op(A) x = b for a triangular A.
+    template <expression T>
+    std::vector<T> trsv(const matrix_base<T>& a,
+                        std::vector<T> b,
+                        triangle_type uplo,
+                        diagonal_type diag = diagonal_type::NON_UNIT,
+                        transpose_type trans = transpose_type::NONE) {
+        if (!a.is_square())
+            throw std::invalid_argument("Matrix must be square to solve a triangular system");
+        if (a.size_row() != b.size())
+            throw std::domain_error("The right hand side must have as many entries as the triangular matrix has rows");
+
+        m_kernel::trsv(a.size_row(), a.raw_data(), a.size_col(), b.data(), uplo, diag, trans);
+        return b;
+    }
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_TRIANGULAR_HPP
@@ -0,0 +1,180 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+
+#ifndef MMATH_MMATH_TUNING_HPP
+#define MMATH_MMATH_TUNING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace mmath {
+
+    /*
+     * TUNING
+     *
+     * The blocked kernels read their tile sizes and thresholds from per type
+     * configurations, e.g. m_kernel::gemm_tuning<double>(). Each is set up on
+     * first use from the tuning file, falling back to the compiled in defaults
+     * for every setting the file does not name. The file is the one named by
+     * MMATH_TUNING_FILE, otherwise mmath/tuning.conf under XDG_CONFIG_HOME or
+     * ~/.config. mmath_tune writes one for the local machine.
+     *
+     * The file holds one "kernel.type.setting = value" or "kernel.setting =
+     * value" per line, # starting a comment. A setting naming the element type
+     * wins over the one without, which applies to every type:
+     *
+     *   gemm.block_k = 128
+     *   gemm.double.block_n = 512
+     *
+     * Types are named float, double, long_double, int8 ... int64 and uint8 ...
+     * uint64.
+     *
+     * The file is read once before main, a file that cannot be read or parsed
+     * is ignored as a whole.
+     */
+
+    using tuning_settings = std::map<std::string, size_t, std::less<>>;
+
+    template <typename T>
+    constexpr const char* type_name() {
+        if constexpr (std::is_same_v<T, float>)
+            return "float";
+        else if constexpr (std::is_same_v<T, double>)
+            return "double";
+        else if constexpr (std::is_same_v<T, long double>)
+            return "long double";
+        else if constexpr (std::is_integral_v<T>) {
+            constexpr std::array<const char*, 4> sign = {"int8", "int16", "int32", "int64"};
+            constexpr std::array<const char*, 4> unsign = {"uint8", "uint16", "uint32", "uint64"};
+            constexpr size_t index = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+            return std::is_signed_v<T> ? sign[index] : unsign[index];
+        } else
+            return "other";
+    }
+
+    inline tuning_settings read_tuning(std::istream& is) {
+        tuning_settings settings;
+        std::string line;
+        auto trim = [](std::string text) {
+            const char* space = " \t\r";
+            text.erase(0, text.find_first_not_of(space));
+            text.erase(text.find_last_not_of(space) + 1);
+            return text;
+        };
+
+        while (std::getline(is, line)) {
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty())
+                continue;
+
+            const size_t equals = line.find('=');
+            if (equals == std::string::npos)
+                throw std::invalid_argument("Tuning line is not of the form key = value: " + line);
+            const std::string key = trim(line.substr(0, equals));
+            const std::string value = trim(line.substr(equals + 1));
+            if (key.empty() || key.find_first_of(" \t") != std::string::npos)
+                throw std::invalid_argument("Invalid tuning key: " + line);
+
+            char* end = nullptr;
+            const unsigned long long number = std::strtoull(value.c_str(), &end, 10);
+            if (value.empty() || value[0] == '-' || *end != '\0')
+                throw std::invalid_argument("Tuning value is not a non-negative integer: " + line);
+            settings[key] = static_cast<size_t>(number);
+        }
+        return settings;
+    }
+
+    inline void write_tuning(std::ostream& os, const tuning_settings& settings) {
+        for (const auto& [key, value] : settings)
+            os << key << " = " << value << "\n";
+    }
+
+    // Where the tuning file is looked for, empty when no location is known.
+    inline std::filesystem::path tuning_file_path() {
+        if (const char* file = std::getenv("MMATH_TUNING_FILE"))
+            return file;
+        if (const char* config = std::getenv("XDG_CONFIG_HOME"); config && *config)
+            return std::filesystem::path{config} / "mmath" / "tuning.conf";
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return std::filesystem::path{home} / ".config" / "mmath" / "tuning.conf";
+        return {};
+    }
+
+    namespace m_tuning {
+
+        // The tuning file as read at start up, empty when it is absent or
+        // broken.
+        inline const tuning_settings& startup_settings() {
+            static const tuning_settings settings = [] {
+                const std::filesystem::path path = tuning_file_path();
+                std::ifstream file;
+                if (!path.empty())
+                    file.open(path);
+                if (!file)
+                    return tuning_settings{};
+                try {
+                    return read_tuning(file);
+                } catch (const std::exception&) {
+                    return tuning_settings{};
+                }
+            }();
+            return settings;
+        }
+
+        // Reads the file during static initialization rather than in the
+        // middle of the first product.
+        inline const tuning_settings& read_at_startup = startup_settings();
+
+        // Key prefix of the settings for element type T, null for types
+        // without settings of their own. Keys cannot hold spaces, so long
+        // double is long_double.
+        template <typename T>
+        constexpr const char* type_key() {
+            if constexpr (std::is_same_v<T, long double>)
+                return "long_double";
+            else if constexpr (std::is_arithmetic_v<T>)
+                return type_name<T>();
+            else
+                return nullptr;
+        }
+
+        // kernel.type.name when present, otherwise kernel.name, otherwise the
+        // fallback. Keys are built on the stack, so looking up never allocates.
+        inline size_t lookup(const tuning_settings& settings,
+                             const char* kernel,
+                             const char* type,
+                             const char* name,
+                             size_t fallback) {
+            std::array<char, 128> key{};
+            auto find = [&](int length) {
+                if (length <= 0 || static_cast<size_t>(length) >= key.size())
+                    return settings.end();
+                return settings.find(std::string_view{key.data(), static_cast<size_t>(length)});
+            };
+
+            if (type) {
+                auto found = find(std::snprintf(key.data(), key.size(), "%s.%s.%s", kernel, type, name));
+                if (found != settings.end())
+                    return found->second;
+            }
+            auto found = find(std::snprintf(key.data(), key.size(), "%s.%s", kernel, name));
+            return found != settings.end() ? found->second : fallback;
+        }
+    }  // namespace m_tuning
+}  // namespace mmath
+
+#endif  // MMATH_MMATH_TUNING_HPP
@@ -0,0 +1,100 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Built with MMATH_PROPERTY_CACHE defined, see CMakeLists.txt
+#include "../../src/mmath/mmath.hpp"
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("Property Cache - Hits and Misses") {
+    mmath::reset_property_cache_stats();
+
+    mmath::matrix_base<int> matrix{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+    CHECK(matrix.is_identity());
+    CHECK(mmath::property_cache_stats().misses == 1);
+    CHECK(mmath::property_cache_stats().hits == 0);
+
+    CHECK(matrix.is_identity());
+    CHECK(matrix.is_identity());
+    CHECK(mmath::property_cache_stats().misses == 1);
+    CHECK(mmath::property_cache_stats().hits == 2);
+
+    CHECK(matrix.tr() == 3);
+    CHECK(matrix.tr() == 3);
+    CHECK(mmath::property_cache_stats().misses == 2);
+    CHECK(mmath::property_cache_stats().hits == 3);
+}
+
+TEST_CASE("Property Cache - Partial Requests") {
+    mmath::reset_property_cache_stats();
+
+    mmath::matrix_base<int> matrix{{1, 2}, {2, 1}};
+
+    auto all = matrix.properties();
+    CHECK(all.is_symmetric());
+
+    // Every flag is known after a full scan, so narrower requests hit
+    CHECK(matrix.is_symmetric());
+    CHECK_FALSE(matrix.is_diagonal());
+    CHECK_FALSE(matrix.is_triangular());
+    CHECK(mmath::property_cache_stats().misses == 1);
+    CHECK(mmath::property_cache_stats().hits == 3);
+}
+
+TEST_CASE("Property Cache - Invalidation") {
+    SECTION("Element Access") {
+        mmath::matrix_base<int> matrix{{1, 0}, {0, 1}};
+        CHECK(matrix.is_identity());
+        CHECK(matrix.tr() == 2);
+        CHECK_FALSE(matrix.is_zero());
+
+        matrix(1, 2) = 5;
+        CHECK_FALSE(matrix.is_identity());
+        CHECK(matrix.is_upper_triangular());
+
+        matrix(1, 1) = 7;
+        CHECK(matrix.tr() == 8);
+
+        matrix(1, 1) = 0;
+        matrix(1, 2) = 0;
+        matrix(2, 2) = 0;
+        CHECK(matrix.is_zero());
+    }
+
+    SECTION("Elementary Operations") {
+        using namespace mmath;
+
+        mmath::matrix_base<int> matrix{{1, 0}, {0, 1}};
+        CHECK(matrix.is_identity());
+
+        auto swapped = matrix | 1_R <=> 2_R;
+        CHECK_FALSE(swapped.is_identity());
+        CHECK(swapped.is_symmetric());
+        CHECK(matrix.is_identity());
+
+        auto scaled = matrix | 3 * 1_R >> 1_R;
+        CHECK_FALSE(scaled.is_identity());
+        CHECK(scaled.tr() == 4);
+    }
+
+    SECTION("Assignment") {
+        mmath::matrix_base<int> matrix{{1, 0}, {0, 1}};
+        mmath::matrix_base<int> other{{1, 2}, {3, 4}};
+        CHECK(matrix.is_identity());
+        CHECK(other.tr() == 5);
+
+        matrix = other;
+        CHECK_FALSE(matrix.is_identity());
+        CHECK(matrix.tr() == 5);
+
+        matrix = mmath::make_identity_matrix<int>(2);
+        CHECK(matrix.is_identity());
+        CHECK(matrix.tr() == 2);
+
+        // Copies carry the cache of the matrix they came from
+        mmath::reset_property_cache_stats();
+        mmath::matrix_base<int> copy = matrix;
+        CHECK(copy.is_identity());
+        CHECK(mmath::property_cache_stats().hits == 1);
+    }
+}
@@ -0,0 +1,132 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Built with MMATH_COPY_ON_WRITE defined, see CMakeLists.txt
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_span.hpp"
+#include <catch2/catch_all.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    template <typename T>
+    const T* storage(const mmath::matrix_base<T>& matrix) {
+        return matrix.raw_data();
+    }
+}  // namespace
+
+TEST_CASE("Copy on Write - Sharing") {
+    mmath::matrix_base<int> matrix{{1, 2}, {3, 4}};
+    mmath::matrix_base<int> copy = matrix;
+    mmath::matrix_base<int> assigned;
+    assigned = copy;
+
+    CHECK(storage(copy) == storage(matrix));
+    CHECK(storage(assigned) == storage(matrix));
+
+    // Reading never detaches
+    CHECK(std::as_const(copy)(2, 1) == 3);
+    CHECK(copy == matrix);
+    CHECK(copy.tr() == 5);
+    CHECK(storage(copy) == storage(matrix));
+
+    SECTION("First write detaches only the writer") {
+        copy(1, 1) = 10;
+        CHECK(storage(copy) != storage(matrix));
+        CHECK(std::as_const(matrix)(1, 1) == 1);
+        CHECK(std::as_const(copy)(1, 1) == 10);
+        CHECK(storage(assigned) == storage(matrix));
+
+        // Non-const element access detaches even when it is only read
+        CHECK(matrix(1, 1) == 1);
+        CHECK(storage(assigned) != storage(matrix));
+
+        // The writer now owns its buffer, later writes stay in place
+        const int* owned = storage(copy);
+        copy(2, 2) = 20;
+        CHECK(storage(copy) == owned);
+    }
+
+    SECTION("Raw data access detaches") {
+        copy.raw_data()[3] = 40;
+        CHECK(std::as_const(matrix)(2, 2) == 4);
+        CHECK(std::as_const(copy)(2, 2) == 40);
+    }
+
+    SECTION("Moves keep the buffer") {
+        const int* shared = storage(matrix);
+        mmath::matrix_base<int> moved = std::move(copy);
+        CHECK(storage(moved) == shared);
+    }
+}
+
+TEST_CASE("Copy on Write - Operations Leave Their Source") {
+    using namespace mmath;
+
+    matrix_base<int> matrix{{1, 0}, {0, 1}};
+    auto swapped = matrix | 1_R <=> 2_R;
+    CHECK(swapped == matrix_base<int>{{0, 1}, {1, 0}});
+    CHECK(matrix == make_identity_matrix<int>(2));
+
+    auto scaled = matrix * 3;
+    CHECK(scaled == matrix_base<int>{{3, 0}, {0, 3}});
+    CHECK(matrix == make_identity_matrix<int>(2));
+
+    // A power of one is a copy and shares storage
+    auto power = matrix ^ 1;
+    CHECK(storage(power) == storage(matrix));
+}
+
+TEST_CASE("Copy on Write - Borrowed Memory") {
+    using namespace mmath;
+
+    std::vector<int> external{1, 2, 3, 4};
+    auto borrowed = borrow_matrix(matrix_span<int>{external.data(), 2, 2});
+    auto copy = borrowed;
+    mmath::matrix_base<int> assigned;
+    assigned = borrowed;
+
+    // Copies own their elements at once, so the borrowed matrix keeps writing to the external memory
+    CHECK(storage(copy) != external.data());
+    CHECK(storage(assigned) != external.data());
+    borrowed(1, 1) = 42;
+    borrowed.raw_data()[3] = 40;
+    CHECK(storage(borrowed) == external.data());
+    CHECK(external == std::vector<int>{42, 2, 3, 40});
+    CHECK(copy == matrix_base<int>{{1, 2}, {3, 4}});
+
+    copy(2, 1) = 30;
+    CHECK(external[2] == 3);
+}
+
+TEST_CASE("Copy on Write - Threads") {
+    const size_t n = 64;
+    mmath::matrix_base<double> source{n, n, 1.0};
+    std::vector<mmath::matrix_base<double>> copies(8, source);
+    std::vector<double> traces(copies.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < copies.size(); ++t) {
+        threads.emplace_back([&, t] {
+            // Half the threads only read, half write their own copy
+            for (int round = 0; round < 200; ++round) {
+                mmath::matrix_base<double> local = copies[t];
+                if (t % 2 == 0)
+                    local(1, 1) = static_cast<double>(t);
+                else
+                    traces[t] += local.tr();
+            }
+            if (t % 2 == 0)
+                copies[t](1, 1) = static_cast<double>(t);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(std::as_const(source)(1, 1) == 1.0);
+    for (size_t t = 0; t < copies.size(); ++t) {
+        CHECK(std::as_const(copies[t])(1, 1) == (t % 2 == 0 ? static_cast<double>(t) : 1.0));
+        CHECK(traces[t] == (t % 2 == 0 ? 0.0 : 200.0 * n));
+        CHECK((storage(copies[t]) == storage(source)) == (t % 2 != 0));
+    }
+}
@@ -0,0 +1,86 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Built with MMATH_INSTRUMENTATION defined, see CMakeLists.txt
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_lu.hpp"
+#include <catch2/catch_all.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Instrumentation - Operations") {
+    using namespace mmath;
+    reset_operation_stats();
+
+    matrix_base<double> a{{1, 2, 3}, {4, 5, 6}};
+    matrix_base<double> b{{1, 0}, {0, 1}, {1, 1}};
+
+    matrix_base<double> product = a * b;
+    CHECK(operation_stats(operation::multiply).calls == 1);
+    CHECK(operation_stats(operation::multiply).flops == 2 * 2 * 2 * 3);
+    CHECK(operation_stats(operation::multiply).allocations == 1);
+    CHECK(operation_stats(operation::multiply).bytes_allocated == 4 * sizeof(double));
+    CHECK(operation_stats(operation::multiply).max_elements == 4);
+
+    matrix_base<double> sum = a + a;
+    matrix_base<double> difference = sum - a;
+    CHECK(operation_stats(operation::add).calls == 1);
+    CHECK(operation_stats(operation::add).flops == 6);
+    CHECK(operation_stats(operation::subtract).calls == 1);
+    CHECK(operation_stats(operation::subtract).bytes_copied == 0);
+
+    // Scaling and row operations start from a copy of the matrix
+    matrix_base<double> scaled = a * 2.0;
+    matrix_base<double> swapped = a | 1_R <=> 2_R;
+    CHECK(operation_stats(operation::scale).bytes_copied == 6 * sizeof(double));
+    CHECK(operation_stats(operation::row_operation).calls == 1);
+    CHECK(operation_stats(operation::row_operation).bytes_copied == 6 * sizeof(double));
+
+    // A power counts its multiplies under multiply as well
+    matrix_base<double> square{{1, 1}, {0, 1}};
+    matrix_base<double> power = square ^ 5;
+    CHECK(power == matrix_base<double>{{1, 5}, {0, 1}});
+    CHECK(operation_stats(operation::power).calls == 1);
+    CHECK(operation_stats(operation::multiply).calls == 4);
+    CHECK(operation_stats(operation::power).seconds > 0);
+
+    // Copies outside any operation
+    matrix_base<double> copy = a;
+    CHECK(operation_stats(operation::copy).calls == 1);
+    CHECK(operation_stats(operation::copy).bytes_copied == 6 * sizeof(double));
+
+    std::vector<double> x = lu_solve(matrix_base<double>{{2, 1}, {1, 3}}, {3, 5});
+    CHECK(x[0] == Catch::Approx(0.8));
+    CHECK(operation_stats(operation::lu_factor).calls == 1);
+    CHECK(operation_stats(operation::lu_solve).calls == 1);
+
+    reset_operation_stats();
+    for (const auto& stats : operation_stats()) {
+        CHECK(stats.calls == 0);
+        CHECK(stats.bytes_allocated == 0);
+    }
+}
+
+TEST_CASE("Instrumentation - Export") {
+    using namespace mmath;
+    reset_operation_stats();
+
+    matrix_base<int> a{{1, 2}, {3, 4}};
+    matrix_base<int> product = a * a;
+    product = product * a;
+
+    std::ostringstream json;
+    write_operation_stats_json(json);
+    CHECK(json.str().front() == '{');
+    CHECK(json.str().back() == '}');
+    CHECK(json.str().find("\"multiply\": {\"calls\": 2, ") != std::string::npos);
+    CHECK(json.str().find("\"flops\": 32, ") != std::string::npos);
+    CHECK(json.str().find("\"lu_solve\": {\"calls\": 0, ") != std::string::npos);
+
+    std::ostringstream prometheus;
+    write_operation_stats_prometheus(prometheus);
+    CHECK(prometheus.str().find("# TYPE mmath_operation_calls_total counter\n") != std::string::npos);
+    CHECK(prometheus.str().find("mmath_operation_calls_total{operation=\"multiply\"} 2\n") != std::string::npos);
+    CHECK(prometheus.str().find("mmath_operation_max_elements{operation=\"multiply\"} 4\n") != std::string::npos);
+}
@@ -0,0 +1,115 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Built with MMATH_INLINE_CAPACITY=16 defined, see CMakeLists.txt
+#include "../../src/mmath/mmath.hpp"
+#include <catch2/catch_all.hpp>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace {
+    size_t allocations = 0;
+
+    template <typename T>
+    const T* storage(const mmath::matrix_base<T>& matrix) {
+        return matrix.raw_data();
+    }
+
+    template <typename T>
+    bool is_inline(const mmath::matrix_base<T>& matrix) {
+        auto* address = reinterpret_cast<const char*>(storage(matrix));
+        auto* object = reinterpret_cast<const char*>(&matrix);
+        return address >= object && address < object + sizeof(matrix);
+    }
+}  // namespace
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+TEST_CASE("Small Buffer - No Allocations") {
+    using namespace mmath;
+
+    // Catch allocates inside CHECK, so only count the arithmetic itself
+    size_t before = allocations;
+    matrix_base<double> a{{1, 2, 3}, {4, 5, 6}, {7, 8, 10}};
+    matrix_base<double> b{{2, 0, 1}, {1, 3, 0}, {0, 1, 4}};
+    matrix_base<double> sum = a + b;
+    matrix_base<double> difference = a - b;
+    matrix_base<double> product = a * b;
+    matrix_base<double> scaled = 2.0 * a;
+    matrix_base<double> transposed = a.transpose();
+    matrix_base<double> power = a ^ 3;
+    matrix_base<double> swapped = a | 1_R <=> 3_R;
+    matrix_base<double> copy = a;
+    copy = b;
+    matrix_base<double> moved = std::move(copy);
+    double trace = a.tr();
+    size_t used = allocations - before;
+
+    CHECK(used == 0);
+    CHECK(is_inline(a));
+    CHECK(is_inline(moved));
+    CHECK(sum == matrix_base<double>{{3, 2, 4}, {5, 8, 6}, {7, 9, 14}});
+    CHECK(difference == matrix_base<double>{{-1, 2, 2}, {3, 2, 6}, {7, 7, 6}});
+    CHECK(product == matrix_base<double>{{4, 9, 13}, {13, 21, 28}, {22, 34, 47}});
+    CHECK(scaled == matrix_base<double>{{2, 4, 6}, {8, 10, 12}, {14, 16, 20}});
+    CHECK(transposed == matrix_base<double>{{1, 4, 7}, {2, 5, 8}, {3, 6, 10}});
+    CHECK(power == a * a * a);
+    CHECK(swapped == matrix_base<double>{{7, 8, 10}, {4, 5, 6}, {1, 2, 3}});
+    CHECK(moved == b);
+    CHECK(trace == 16);
+
+    // Sixteen elements is the largest inline size
+    before = allocations;
+    matrix_base<int> largest{4, 4, 1};
+    matrix_base<int> square = largest * largest;
+    used = allocations - before;
+    CHECK(used == 0);
+    CHECK(square == matrix_base<int>{4, 4, 4});
+}
+
+TEST_CASE("Small Buffer - Spilling") {
+    using namespace mmath;
+
+    size_t before = allocations;
+    matrix_base<int> large{5, 5, 2};
+    size_t used = allocations - before;
+    CHECK(used == 1);
+    CHECK(!is_inline(large));
+
+    matrix_base<int> copy = large;
+    copy(5, 5) = 7;
+    CHECK(std::as_const(large)(5, 5) == 2);
+    CHECK(storage(copy) != storage(large));
+
+    // Moving a spilled buffer hands over the heap block
+    const int* block = storage(copy);
+    matrix_base<int> moved = std::move(copy);
+    CHECK(storage(moved) == block);
+    CHECK(moved(5, 5) == 7);
+
+    // Assigning between sizes switches storage in both directions
+    matrix_base<int> small{{1, 2}, {3, 4}};
+    small = moved;
+    CHECK(!is_inline(small));
+    CHECK(small == moved);
+    small = matrix_base<int>{{1, 2}, {3, 4}};
+    CHECK(is_inline(small));
+    CHECK(small.tr() == 5);
+
+    matrix_base<int> product = large * large;
+    CHECK(product == matrix_base<int>{5, 5, 20});
+}
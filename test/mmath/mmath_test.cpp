@@ -3,8 +3,34 @@
 //
 //#include "catch/catch_test_macros.hpp"
 #include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_async.hpp"
+#include "../../src/mmath/mmath_banded.hpp"
+#include "../../src/mmath/mmath_batch.hpp"
+#include "../../src/mmath/mmath_binary.hpp"
+#include "../../src/mmath/mmath_bitmatrix.hpp"
+#include "../../src/mmath/mmath_krylov.hpp"
+#include "../../src/mmath/mmath_latex.hpp"
+#include "../../src/mmath/mmath_lu.hpp"
+#include "../../src/mmath/mmath_mixed.hpp"
+#include "../../src/mmath/mmath_modular.hpp"
+#include "../../src/mmath/mmath_outofcore.hpp"
+#include "../../src/mmath/mmath_quantized.hpp"
+#include "../../src/mmath/mmath_semiring.hpp"
+#include "../../src/mmath/mmath_sparse.hpp"
+#include "../../src/mmath/mmath_span.hpp"
+#include "../../src/mmath/mmath_textio.hpp"
+#include "../../src/mmath/mmath_triangular.hpp"
+#include <atomic>
 #include <catch2/catch_all.hpp>
+#include <coroutine>
+#include <cstring>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 template <typename T>
 void inline matrix_constructor_test(size_t rows,
@@ -283,6 +309,77 @@ TEMPLATE_TEST_CASE("Matrix Creation",
     }
 }
 
+TEST_CASE("Matrix Creation - Bulk") {
+    using namespace mmath;
+
+    SECTION("For overwrite") {
+        matrix_base<double> matrix{3, 4, for_overwrite};
+        CHECK(matrix.size_row() == 3);
+        CHECK(matrix.size_col() == 4);
+        CHECK_FALSE(matrix.is_empty());
+        CHECK(matrix_base<double>{0, 0, for_overwrite}.is_empty());
+    }
+
+    SECTION("Generator") {
+        matrix_base<int> small{2, 3, [](size_t i, size_t j) { return static_cast<int>(10 * i + j); }};
+        CHECK(small == matrix_base<int>{{11, 12, 13}, {21, 22, 23}});
+
+        // Large enough to be filled by the thread pool
+        const size_t n = 700;
+        matrix_base<double> large{n, n, [](size_t i, size_t j) { return static_cast<double>(i * n + j); }};
+        bool matches = true;
+        for (size_t i = 1; i <= n; ++i)
+            for (size_t j = 1; j <= n; ++j)
+                matches = matches && large(i, j) == static_cast<double>(i * n + j);
+        CHECK(matches);
+    }
+
+    SECTION("Adopted vector") {
+        std::vector<double> values(64 * 64);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<double>(i);
+        const double* elements = values.data();
+
+        matrix_base<double> matrix{64, 64, std::move(values)};
+        CHECK(matrix.raw_data() == elements);
+        CHECK(matrix(2, 1) == 64);
+
+        matrix_base<double> copy = matrix;
+        copy(1, 1) = -1;
+        CHECK(std::as_const(matrix)(1, 1) == 0);
+
+        CHECK_THROWS_AS((matrix_base<int>{2, 2, std::vector<int>(3)}), std::invalid_argument);
+    }
+
+    SECTION("Adopted buffer") {
+        int released = 0;
+        {
+            auto* elements = new int[64];
+            for (int i = 0; i < 64; ++i)
+                elements[i] = i;
+            matrix_base<int> matrix{8, 8, elements, [&](int* memory) {
+                                        ++released;
+                                        delete[] memory;
+                                    }};
+            matrix_base<int> copy = matrix;
+            CHECK(copy == matrix_base<int>{8, 8, [](size_t i, size_t j) { return static_cast<int>(8 * i + j - 9); }});
+            matrix_base<int> moved = std::move(matrix);
+            CHECK(std::as_const(moved)(8, 8) == 63);
+            CHECK(released == 0);
+        }
+        CHECK(released == 1);
+
+        matrix_base<float> owned{2, 2, new float[4]{1, 0, 0, 1}, std::default_delete<float[]>{}};
+        CHECK(owned == make_identity_matrix<float>(2));
+    }
+
+    SECTION("Initializer list padding") {
+        matrix_base<int> ragged{{1}, {2, 3, 4}, {}};
+        CHECK(ragged.size_col() == 3);
+        CHECK(ragged == matrix_base<int>{{1, 0, 0}, {2, 3, 4}, {0, 0, 0}});
+    }
+}
+
 TEST_CASE("Matrix Comparison") {
     SECTION("Equality - int") {
         mmath::matrix_base<int> matrix_a{};
@@ -761,6 +858,31 @@ TEST_CASE("Matrix Powers") {
     }
 }
 
+TEST_CASE("Matrix Multiplication - Blocked Kernel") {
+    // Sizes chosen to straddle the gemm block boundaries
+    const size_t rows = 130, inner = 141, cols = 300;
+
+    mmath::matrix_base<long long> a{rows, inner};
+    mmath::matrix_base<long long> b{inner, cols};
+    for (size_t i = 1; i <= rows; ++i)
+        for (size_t j = 1; j <= inner; ++j)
+            a(i, j) = static_cast<long long>((i * 7 + j * 3) % 11) - 5;
+    for (size_t i = 1; i <= inner; ++i)
+        for (size_t j = 1; j <= cols; ++j)
+            b(i, j) = static_cast<long long>((i * 5 + j) % 13) - 6;
+
+    auto result = a * b;
+
+    for (size_t i = 1; i <= rows; ++i) {
+        for (size_t j = 1; j <= cols; ++j) {
+            long long expected = 0;
+            for (size_t k = 1; k <= inner; ++k)
+                expected += a(i, k) * b(k, j);
+            REQUIRE(result(i, j) == expected);
+        }
+    }
+}
+
 TEST_CASE("Matrix Trace") {
     SECTION("Empty Matrix") {
         mmath::matrix_base<int> matrix_a{};
@@ -873,6 +995,1622 @@ TEST_CASE("Matrix Transpose") {
     CHECK(result2(3, 3) == n(3, 3));
 }
 
+TEST_CASE("Matrix Structural Properties") {
+    SECTION("Diagonal, Scalar and Identity") {
+        mmath::matrix_base<int> diagonal{{1, 0, 0}, {0, 2, 0}, {0, 0, 3}};
+        mmath::matrix_base<int> scalar{{4, 0, 0}, {0, 4, 0}, {0, 0, 4}};
+        mmath::matrix_base<int> identity = mmath::make_identity_matrix<int>(3);
+
+        CHECK(diagonal.is_diagonal());
+        CHECK_FALSE(diagonal.is_scalar());
+        CHECK_FALSE(diagonal.is_identity());
+        CHECK(diagonal.is_upper_triangular());
+        CHECK(diagonal.is_lower_triangular());
+        CHECK(diagonal.is_symmetric());
+
+        CHECK(scalar.is_diagonal());
+        CHECK(scalar.is_scalar());
+        CHECK_FALSE(scalar.is_identity());
+
+        CHECK(identity.is_diagonal());
+        CHECK(identity.is_scalar());
+        CHECK(identity.is_identity());
+    }
+
+    SECTION("Triangular") {
+        mmath::matrix_base<int> upper{{1, 2, 3}, {0, 4, 5}, {0, 0, 6}};
+        mmath::matrix_base<int> lower{{1, 0, 0}, {2, 3, 0}, {4, 5, 6}};
+
+        CHECK(upper.is_upper_triangular());
+        CHECK_FALSE(upper.is_lower_triangular());
+        CHECK(upper.is_triangular());
+        CHECK_FALSE(upper.is_diagonal());
+
+        CHECK(lower.is_lower_triangular());
+        CHECK_FALSE(lower.is_upper_triangular());
+        CHECK(lower.is_triangular());
+
+        CHECK_FALSE(mmath::matrix_base<int>{{1, 2}, {3, 4}}.is_triangular());
+    }
+
+    SECTION("Symmetric and Skew Symmetric") {
+        mmath::matrix_base<int> symmetric{{1, 7, 3}, {7, 4, -5}, {3, -5, 6}};
+        mmath::matrix_base<int> skew{{0, 2, -1}, {-2, 0, -4}, {1, 4, 0}};
+
+        CHECK(symmetric.is_symmetric());
+        CHECK_FALSE(symmetric.is_skew_symmetric());
+
+        CHECK(skew.is_skew_symmetric());
+        CHECK_FALSE(skew.is_symmetric());
+
+        // A nonzero diagonal can never be skew symmetric
+        CHECK_FALSE(mmath::matrix_base<int>{{1, 2}, {-2, 0}}.is_skew_symmetric());
+    }
+
+    SECTION("Non Square") {
+        mmath::matrix_base<int> matrix{{1, 0, 0}, {0, 1, 0}};
+        auto props = matrix.properties();
+
+        CHECK(props == mmath::matrix_properties{});
+        CHECK(mmath::matrix_base<double>{2, 3}.properties().is_zero());
+    }
+
+    SECTION("Single Pass Matches Individual Checks") {
+        mmath::matrix_base<double> matrix{{2, 0, 0}, {0, 2, 0}, {0, 0, 2}};
+        auto props = matrix.properties();
+
+        CHECK(props.is_diagonal() == matrix.is_diagonal());
+        CHECK(props.is_scalar() == matrix.is_scalar());
+        CHECK(props.is_identity() == matrix.is_identity());
+        CHECK(props.is_zero() == matrix.is_zero());
+        CHECK(props.is_upper_triangular() == matrix.is_upper_triangular());
+        CHECK(props.is_lower_triangular() == matrix.is_lower_triangular());
+        CHECK(props.is_symmetric() == matrix.is_symmetric());
+        CHECK(props.is_skew_symmetric() == matrix.is_skew_symmetric());
+
+        auto requested = matrix.properties(mmath::matrix_property::SYMMETRIC);
+        CHECK(requested.is_symmetric());
+        CHECK_FALSE(requested.is_diagonal());
+    }
+
+    SECTION("Large Matrices") {
+        // Large enough to span several tiles and the parallel scan
+        const size_t size = 600;
+        mmath::matrix_base<double> matrix = mmath::make_identity_matrix<double>(size);
+
+        CHECK(matrix.is_identity());
+        CHECK(matrix.is_symmetric());
+
+        matrix(size, 1) = 3;
+        CHECK_FALSE(matrix.is_identity());
+        CHECK_FALSE(matrix.is_upper_triangular());
+        CHECK(matrix.is_lower_triangular());
+        CHECK_FALSE(matrix.is_symmetric());
+
+        matrix(1, size) = 3;
+        CHECK(matrix.is_symmetric());
+        CHECK_FALSE(matrix.is_triangular());
+    }
+}
+
+TEST_CASE("Triangular Solve") {
+    using mmath::diagonal_type;
+    using mmath::transpose_type;
+    using mmath::triangle_type;
+
+    mmath::matrix_base<double> lower{{2, 0, 0}, {1, 4, 0}, {3, -1, 5}};
+    mmath::matrix_base<double> upper = lower.transpose();
+
+    SECTION("Invalid Entries") {
+        mmath::matrix_base<double> non_square{{1, 2}};
+        CHECK_THROWS_AS(mmath::trsm(non_square, non_square, triangle_type::LOWER), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::trsm(lower, mmath::matrix_base<double>{2, 1}, triangle_type::LOWER),
+                        std::domain_error);
+        CHECK_THROWS_AS(mmath::trsv(lower, std::vector<double>{1, 2}, triangle_type::LOWER), std::domain_error);
+
+        mmath::matrix_base<double> singular{{1, 0}, {1, 0}};
+        CHECK_THROWS_AS(mmath::trsv(singular, std::vector<double>{1, 2}, triangle_type::LOWER), std::domain_error);
+    }
+
+    SECTION("Single Right Hand Side") {
+        std::vector<double> x{1, 2, 3};
+        std::vector<double> b{2, 9, 16};
+
+        CHECK(mmath::trsv(lower, b, triangle_type::LOWER) == x);
+
+        std::vector<double> b_upper{2 + 2 + 9, 8 - 3, 15};
+        CHECK(mmath::trsv(upper, b_upper, triangle_type::UPPER) == x);
+
+        // Transposing the lower matrix solves against the upper one
+        CHECK(mmath::trsv(lower, b_upper, triangle_type::LOWER, diagonal_type::NON_UNIT, transpose_type::TRANSPOSE) ==
+              x);
+    }
+
+    SECTION("Unit Diagonal") {
+        // The stored diagonal is ignored when it is declared to be unit
+        std::vector<double> b{1, 1 + 2, 3 - 2 + 3};
+        CHECK(mmath::trsv(lower, b, triangle_type::LOWER, diagonal_type::UNIT) == std::vector<double>{1, 2, 3});
+    }
+
+    SECTION("Blocked Multiple Right Hand Sides") {
+        const size_t n = 150, nrhs = 140;
+
+        mmath::matrix_base<double> a{n, n};
+        mmath::matrix_base<double> x{n, nrhs};
+        for (size_t i = 1; i <= n; ++i) {
+            for (size_t j = 1; j <= n; ++j)
+                a(i, j) = i == j ? 4.0 + static_cast<double>(i % 3) : static_cast<double>((i + 2 * j) % 5) / 10.0;
+            for (size_t j = 1; j <= nrhs; ++j)
+                x(i, j) = static_cast<double>((i * j) % 7) - 3.0;
+        }
+
+        // Zero out the unused triangle for building the right hand sides
+        mmath::matrix_base<double> l = a, u = a;
+        for (size_t i = 1; i <= n; ++i) {
+            for (size_t j = 1; j <= n; ++j) {
+                if (j > i)
+                    l(i, j) = 0;
+                if (j < i)
+                    u(i, j) = 0;
+            }
+        }
+
+        auto check_solution = [&](const mmath::matrix_base<double>& solved) {
+            for (size_t i = 1; i <= n; ++i)
+                for (size_t j = 1; j <= nrhs; ++j)
+                    REQUIRE(solved(i, j) == Catch::Approx(x(i, j)).margin(1e-9));
+        };
+
+        check_solution(mmath::trsm(a, l * x, triangle_type::LOWER));
+        check_solution(mmath::trsm(a, u * x, triangle_type::UPPER));
+        check_solution(
+            mmath::trsm(a, l.transpose() * x, triangle_type::LOWER, diagonal_type::NON_UNIT, transpose_type::TRANSPOSE));
+        check_solution(
+            mmath::trsm(a, u.transpose() * x, triangle_type::UPPER, diagonal_type::NON_UNIT, transpose_type::TRANSPOSE));
+    }
+}
+
+TEST_CASE("Tridiagonal and Banded Solvers") {
+    SECTION("Thomas Algorithm") {
+        mmath::tridiagonal_matrix<double> a{{1, 1, 1}, {4, 4, 4, 4}, {1, 1, 1}};
+        std::vector<double> x{1, -2, 3, 0.5};
+
+        CHECK(a(2, 1) == 1);
+        CHECK(a(1, 3) == 0);
+
+        auto solved = mmath::thomas_solve(a, a.multiply(x));
+        REQUIRE(solved.size() == x.size());
+        for (size_t i = 0; i < x.size(); ++i)
+            CHECK(solved[i] == Catch::Approx(x[i]));
+
+        CHECK_THROWS_AS(mmath::thomas_solve(a, std::vector<double>{1, 2}), std::domain_error);
+        CHECK_THROWS_AS(mmath::tridiagonal_matrix<double>({1}, {1, 2}, {}), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::thomas_solve(mmath::tridiagonal_matrix<double>{2}, std::vector<double>{1, 2}),
+                        std::domain_error);
+    }
+
+    SECTION("Batched Thomas Algorithm") {
+        const size_t size = 17, count = 1000;
+        mmath::tridiagonal_batch<double> batch{size, count};
+
+        auto coefficient = [](size_t system, size_t row, size_t which) {
+            return static_cast<double>((system * 3 + row * 7 + which) % 5) - 2.0;
+        };
+
+        for (size_t s = 0; s < count; ++s) {
+            for (size_t i = 0; i < size; ++i) {
+                batch.lower(s, i) = coefficient(s, i, 0);
+                batch.diagonal(s, i) = 10.0 + coefficient(s, i, 1);
+                batch.upper(s, i) = coefficient(s, i, 2);
+                batch.right_hand_side(s, i) = coefficient(s, i, 3);
+            }
+        }
+        batch.solve();
+
+        for (size_t s : {size_t{0}, size_t{1}, size_t{499}, count - 1}) {
+            mmath::tridiagonal_matrix<double> single{size};
+            std::vector<double> rhs(size);
+            for (size_t i = 0; i < size; ++i) {
+                single.diagonal()[i] = 10.0 + coefficient(s, i, 1);
+                if (i > 0)
+                    single.lower()[i - 1] = coefficient(s, i, 0);
+                if (i + 1 < size)
+                    single.upper()[i] = coefficient(s, i, 2);
+                rhs[i] = coefficient(s, i, 3);
+            }
+
+            auto expected = mmath::thomas_solve(single, rhs);
+            for (size_t i = 0; i < size; ++i)
+                CHECK(batch.solution(s, i) == Catch::Approx(expected[i]));
+        }
+
+        CHECK_THROWS_AS(batch.diagonal(count, 0), std::out_of_range);
+        CHECK_THROWS_AS(mmath::tridiagonal_batch<double>(3, 2).solve(), std::domain_error);
+    }
+
+    SECTION("Banded LU") {
+        const size_t size = 40;
+        mmath::banded_matrix<double> a{size, 2, 3};
+
+        CHECK_THROWS_AS(a(1, 5), std::out_of_range);
+        CHECK(std::as_const(a)(1, 5) == 0);
+
+        for (size_t i = 1; i <= size; ++i) {
+            for (size_t j = i > 2 ? i - 2 : 1; j <= std::min(size, i + 3); ++j)
+                a(i, j) = static_cast<double>((i * 5 + j * 3) % 7) - 3.0;
+            // A zero on the diagonal forces row exchanges
+            a(i, i) = i % 4 == 0 ? 0.0 : a(i, i);
+        }
+
+        std::vector<double> x(size);
+        for (size_t i = 0; i < size; ++i)
+            x[i] = static_cast<double>(i % 9) - 4.0;
+
+        auto solved = mmath::banded_solve(a, a.multiply(x));
+        REQUIRE(solved.size() == size);
+        for (size_t i = 0; i < size; ++i)
+            CHECK(solved[i] == Catch::Approx(x[i]).margin(1e-9));
+
+        mmath::banded_lu<double> lu{a};
+        auto again = lu.solve(a.multiply(x));
+        for (size_t i = 0; i < size; ++i)
+            CHECK(again[i] == Catch::Approx(x[i]).margin(1e-9));
+
+        CHECK_THROWS_AS(mmath::banded_solve(mmath::banded_matrix<double>{3, 1, 1}, std::vector<double>(3)),
+                        std::domain_error);
+    }
+}
+
+TEST_CASE("Sparse CSR Matrix") {
+    mmath::matrix_base<int> dense{{1, 0, 2}, {0, 0, 0}, {0, 3, 0}};
+    mmath::csr_matrix<int> sparse{dense};
+
+    CHECK(sparse.nonzeros() == 3);
+    CHECK(sparse(1, 3) == 2);
+    CHECK(sparse(2, 2) == 0);
+    CHECK(sparse.to_dense() == dense);
+    CHECK_THROWS_AS(sparse(4, 1), std::out_of_range);
+
+    mmath::csr_matrix<int> from_entries{3, 3, {{3, 2, 1}, {1, 3, 2}, {1, 1, 1}, {3, 2, 2}}};
+    CHECK(from_entries.to_dense() == dense);
+
+    std::vector<int> x{1, 2, 3}, y(3);
+    sparse.apply(x, y);
+    CHECK(y == std::vector<int>{7, 0, 6});
+
+    CHECK_THROWS_AS(mmath::csr_matrix<int>(2, 2, {0, 1, 1}, {1}, {}), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::csr_matrix<int>(2, 2, {0, 2, 2}, {1, 0}, {1, 1}), std::invalid_argument);
+}
+
+TEST_CASE("Binary Matrix Format") {
+    mmath::matrix_base<double> m{{1.5, -2.0, 3.25}, {4.0, 5.5, -6.75}};
+    std::string path = (std::filesystem::temp_directory_path() / "mmath_binary_test.bin").string();
+
+    SECTION("Stream round trip") {
+        std::stringstream buffer;
+        mmath::write_binary(buffer, m);
+        CHECK(mmath::read_binary<double>(buffer) == m);
+    }
+
+    SECTION("Mapped round trip") {
+        mmath::write_binary_mapped(path, m, 4096);
+        mmath::mapped_matrix<double> view{path, true};
+        CHECK(view.size_row() == 2);
+        CHECK(view.size_col() == 3);
+        CHECK(view(2, 3) == -6.75);
+        CHECK(reinterpret_cast<uintptr_t>(view.raw_data()) % 4096 == 0);
+        CHECK(view.to_matrix() == m);
+        CHECK_THROWS_AS(view(3, 1), std::out_of_range);
+    }
+
+    SECTION("Streamed file can be mapped") {
+        {
+            std::ofstream out{path, std::ios::binary};
+            mmath::write_binary(out, mmath::matrix_base<int>{});
+        }
+        mmath::mapped_matrix<int> view{path, true};
+        CHECK(view.to_matrix().is_empty());
+    }
+
+    SECTION("Invalid files") {
+        mmath::write_binary_mapped(path, m);
+        CHECK_THROWS_AS(mmath::mapped_matrix<float>(path), std::runtime_error);
+
+        {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(64);
+            file.put(0x7f);
+        }
+        CHECK_NOTHROW(mmath::mapped_matrix<double>(path));
+        CHECK_THROWS_AS(mmath::mapped_matrix<double>(path, true), std::runtime_error);
+
+        std::stringstream garbage{"not a matrix file at all, just some text that is long enough for a header"};
+        CHECK_THROWS_AS(mmath::read_binary<double>(garbage), std::runtime_error);
+        CHECK_THROWS_AS(mmath::mapped_matrix<double>(path + ".missing"), std::system_error);
+        CHECK_THROWS_AS(mmath::write_binary_mapped(path, m, 48), std::invalid_argument);
+    }
+
+    SECTION("Corrupt headers") {
+        std::stringstream valid;
+        mmath::write_binary(valid, m);
+        const std::string bytes = valid.str();
+        auto corrupt = [&](auto change) {
+            mmath::binary_header header{};
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            change(header);
+            std::string patched = bytes;
+            std::memcpy(patched.data(), &header, sizeof(header));
+            std::ofstream{path, std::ios::binary} << patched;
+            std::stringstream stream{patched};
+            CHECK_THROWS_AS(mmath::read_binary<double>(stream), std::runtime_error);
+            CHECK_THROWS_AS(mmath::mapped_matrix<double>(path), std::runtime_error);
+        };
+
+        // rows * cols * sizeof(double) wraps to zero
+        corrupt([](mmath::binary_header& h) {
+            h.rows = uint64_t{1} << 62;
+            h.cols = 8;
+            h.data_bytes = 0;
+        });
+        // data_offset + data_bytes wraps past the end of the file
+        corrupt([](mmath::binary_header& h) {
+            h.rows = h.cols = 1;
+            h.data_bytes = sizeof(double);
+            h.data_offset = ~uint64_t{0} - 3;
+        });
+        // Consistent, but far larger than the file
+        corrupt([](mmath::binary_header& h) {
+            h.rows = h.cols = uint64_t{1} << 20;
+            h.data_bytes = h.rows * h.cols * sizeof(double);
+        });
+        corrupt([](mmath::binary_header& h) { h.data_offset = 68; });
+        corrupt([](mmath::binary_header& h) { h.alignment = 48; });
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Out-of-core Tiled Matrix") {
+    auto make = [](size_t rows, size_t cols, int seed) {
+        mmath::matrix_base<double> m{rows, cols};
+        for (size_t i = 1; i <= rows; ++i)
+            for (size_t j = 1; j <= cols; ++j)
+                m(i, j) = static_cast<double>((i * 7 + j * 3 + seed) % 11) - 5;
+        return m;
+    };
+
+    // Four 4x4 tiles of budget so every operation has to evict and reload
+    mmath::tiled_options options{4, 4 * 16 * sizeof(double), 2};
+    auto dir = std::filesystem::temp_directory_path();
+    std::string path_a = (dir / "mmath_tiled_a.tile").string();
+    std::string path_b = (dir / "mmath_tiled_b.tile").string();
+
+    mmath::matrix_base<double> a = make(10, 7, 1), b = make(7, 9, 2), c = make(10, 7, 3);
+
+    {
+        auto ta = mmath::tiled_matrix<double>::from_matrix(path_a, a, options);
+        auto tb = mmath::tiled_matrix<double>::from_matrix(path_b, b, options);
+        auto tc = mmath::tiled_matrix<double>::from_matrix((dir / "mmath_tiled_c.tile").string(), c, options);
+
+        CHECK(ta.tile_rows() == 3);
+        CHECK(ta.tile_cols() == 2);
+        CHECK(ta(10, 7) == a(10, 7));
+        CHECK(ta.to_matrix() == a);
+
+        CHECK((ta * tb).to_matrix() == a * b);
+        CHECK((ta + tc).to_matrix() == a + c);
+        CHECK((ta - tc).to_matrix() == a - c);
+        CHECK(ta.transpose().to_matrix() == a.transpose());
+
+        auto square = ta * ta.transpose();
+        CHECK(square.tr() == Catch::Approx((a * a.transpose()).tr()));
+
+        auto stats = ta.statistics() + tb.statistics();
+        CHECK(stats.tiles_read > 0);
+        CHECK(stats.overlap() >= 0.0);
+        CHECK(stats.overlap() <= 1.0);
+
+        ta.set(1, 1, 42.0);
+        CHECK_THROWS_AS(ta.set(11, 1, 1.0), std::out_of_range);
+        CHECK_THROWS_AS(ta * tc, std::domain_error);
+        CHECK_THROWS_AS(ta + tb, std::domain_error);
+        CHECK_THROWS_AS(ta.tr(), std::invalid_argument);
+    }
+
+    // Reopening picks the tile size and contents back up from the file
+    {
+        auto reopened = mmath::tiled_matrix<double>::open(path_a);
+        CHECK(reopened.tile_size() == 4);
+        CHECK(reopened(1, 1) == 42.0);
+        CHECK(reopened(2, 3) == a(2, 3));
+        CHECK_THROWS_AS(mmath::tiled_matrix<float>::open(path_a), std::runtime_error);
+    }
+
+    // Headers that do not describe the file are rejected on open
+    auto corrupt = [&](auto change) {
+        mmath::tiled_header header{};
+        std::ifstream{path_a, std::ios::binary}.read(reinterpret_cast<char*>(&header), sizeof(header));
+        change(header);
+        std::filesystem::copy_file(path_a, path_b, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream out{path_b, std::ios::binary | std::ios::in | std::ios::out};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        CHECK_THROWS_AS(mmath::tiled_matrix<double>::open(path_b), std::runtime_error);
+    };
+    corrupt([](mmath::tiled_header& h) { h.tile_size = 0; });
+    corrupt([](mmath::tiled_header& h) { h.tile_size = uint64_t{1} << 32; });
+    corrupt([](mmath::tiled_header& h) { h.rows = 1000; });
+    corrupt([](mmath::tiled_header& h) { h.data_offset = 64; });
+
+    // An operation shares one budget between its matrices, which get their own back afterwards
+    {
+        mmath::tiled_options roomy{4, 16 * 16 * sizeof(double), 0};
+        mmath::matrix_base<double> e = make(16, 16, 4);
+        auto te = mmath::tiled_matrix<double>::from_matrix((dir / "mmath_tiled_e.tile").string(), e, roomy);
+        te.reset_statistics();
+        CHECK(te.to_matrix() == e);
+        CHECK(te.statistics().tiles_read == 0);
+
+        // Half the budget each, so the operand no longer holds all sixteen tiles
+        CHECK(te.transpose().to_matrix() == e.transpose());
+        CHECK(te.statistics().tiles_read > 0);
+
+        CHECK(te.to_matrix() == e);
+        te.reset_statistics();
+        CHECK(te.to_matrix() == e);
+        CHECK(te.statistics().tiles_read == 0);
+    }
+    std::filesystem::remove(dir / "mmath_tiled_e.tile");
+
+    // Results and relative paths go to the scratch directory
+    {
+        auto scratch = dir / "mmath_tiled_scratch";
+        std::filesystem::create_directories(scratch);
+        mmath::tiled_options scratch_options = options;
+        scratch_options.scratch_directory = scratch.string();
+
+        auto td = mmath::tiled_matrix<double>::from_matrix("mmath_tiled_d.tile", c, scratch_options);
+        CHECK(std::filesystem::path{td.path()}.parent_path() == scratch);
+        auto sum = td + td;
+        CHECK(std::filesystem::path{sum.path()}.parent_path() == scratch);
+        CHECK(sum.to_matrix() == c + c);
+        CHECK(mmath::tiled_matrix<double>::open("mmath_tiled_d.tile", scratch_options)(2, 3) == c(2, 3));
+    }
+    std::filesystem::remove_all(dir / "mmath_tiled_scratch");
+
+    std::filesystem::remove(path_a);
+    std::filesystem::remove(path_b);
+    std::filesystem::remove(dir / "mmath_tiled_c.tile");
+}
+
+TEST_CASE("CSV and MatrixMarket Parsing") {
+    SECTION("CSV") {
+        mmath::matrix_base<double> expected{{1.5, -2, 3e2}, {4, 5.25, -6}};
+        CHECK(mmath::parse_csv<double>("1.5, -2,3e2\r\n\n4,+5.25 ,-6") == expected);
+        CHECK(mmath::parse_csv<double>("a,b,c\n1.5,-2,300\n4,5.25,-6\n", {',', true}) == expected);
+        CHECK(mmath::parse_csv<int>("1\t 2\n3\t4\n", {'\t'}) == mmath::matrix_base<int>{{1, 2}, {3, 4}});
+        CHECK(mmath::parse_csv<int>("").is_empty());
+
+        CHECK_THROWS_AS(mmath::parse_csv<int>("1,2\n3\n"), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::parse_csv<int>("1,2\n3,x\n"), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::parse_csv<int>("1,2.5\n"), std::invalid_argument);
+    }
+
+    SECTION("CSV spanning several scan chunks") {
+        const size_t rows = 40000, cols = 8;
+        std::string text;
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j)
+                text += std::to_string(i * cols + j) + (j + 1 == cols ? "\n" : ",");
+        }
+
+        auto path = (std::filesystem::temp_directory_path() / "mmath_parse_test.csv").string();
+        {
+            std::ofstream out{path};
+            out << text;
+        }
+        auto parsed = mmath::read_csv<long>(path);
+        std::filesystem::remove(path);
+
+        REQUIRE(parsed.size_row() == rows);
+        REQUIRE(parsed.size_col() == cols);
+        bool all_match = true;
+        for (size_t i = 0; i < rows * cols; ++i)
+            all_match = all_match && parsed.raw_data()[i] == static_cast<long>(i);
+        CHECK(all_match);
+    }
+
+    SECTION("MatrixMarket coordinate") {
+        std::string text =
+            "%%MatrixMarket matrix coordinate real general\n"
+            "% a comment\n"
+            "3 3 4\n"
+            "1 1 2.5\n"
+            "3 2 -1\n"
+            "1 3 4\n"
+            "3 2 2\n";
+        mmath::matrix_base<double> expected{{2.5, 0, 4}, {0, 0, 0}, {0, 1, 0}};
+        CHECK(mmath::parse_matrix_market<double>(text) == expected);
+
+        auto sparse = mmath::parse_matrix_market_sparse<double>(text);
+        CHECK(sparse.nonzeros() == 3);
+        CHECK(sparse.to_dense() == expected);
+
+        std::string symmetric =
+            "%%MatrixMarket matrix coordinate integer symmetric\n"
+            "2 2 2\n1 1 3\n2 1 7\n";
+        CHECK(mmath::parse_matrix_market<int>(symmetric) == mmath::matrix_base<int>{{3, 7}, {7, 0}});
+
+        std::string pattern =
+            "%%MatrixMarket matrix coordinate pattern skew-symmetric\n"
+            "2 2 1\n2 1\n";
+        CHECK(mmath::parse_matrix_market_sparse<int>(pattern).to_dense() == mmath::matrix_base<int>{{0, -1}, {1, 0}});
+
+        CHECK_THROWS_AS(mmath::parse_matrix_market<double>("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n"),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(mmath::parse_matrix_market<double>("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n"),
+                        std::out_of_range);
+        CHECK_THROWS_AS(mmath::parse_matrix_market<double>("%%MatrixMarket matrix coordinate complex general\n1 1 0\n"),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(mmath::parse_matrix_market<double>("1 1 0\n"), std::invalid_argument);
+    }
+
+    SECTION("MatrixMarket array") {
+        std::string general =
+            "%%MatrixMarket matrix array real general\n"
+            "2 3\n1\n4\n2\n5\n3\n6\n";
+        CHECK(mmath::parse_matrix_market<double>(general) == mmath::matrix_base<double>{{1, 2, 3}, {4, 5, 6}});
+
+        std::string symmetric =
+            "%%MatrixMarket matrix array real symmetric\n"
+            "2 2\n1\n2\n3\n";
+        CHECK(mmath::parse_matrix_market<double>(symmetric) == mmath::matrix_base<double>{{1, 2}, {2, 3}});
+        CHECK(mmath::parse_matrix_market_sparse<double>(symmetric).nonzeros() == 4);
+    }
+}
+
+TEST_CASE("Matrix Formatting") {
+    mmath::matrix_base<double> m{{1.5, -2, 1.0 / 3}, {4e20, 5, 6}};
+
+    SECTION("operator<< matches streaming each element") {
+        auto by_element = [](std::ostream& os, const auto& matrix) {
+            for (size_t i = 1; i <= matrix.size_row(); ++i) {
+                for (size_t j = 1; j <= matrix.size_col(); ++j) {
+                    os << matrix(i, j);
+                    if (j != matrix.size_col())
+                        os << " ";
+                }
+                if (i != matrix.size_row())
+                    os << "\n";
+            }
+        };
+
+        auto check = [&](auto&& configure, const auto& matrix) {
+            std::ostringstream fast, slow;
+            configure(fast);
+            configure(slow);
+            fast << matrix;
+            by_element(slow, matrix);
+            CHECK(fast.str() == slow.str());
+        };
+
+        check([](std::ostream&) {}, m);
+        check([](std::ostream& os) { os.precision(12); }, m);
+        check([](std::ostream& os) { os << std::fixed << std::setprecision(3); }, m);
+        check([](std::ostream& os) { os << std::scientific; }, m);
+        check([](std::ostream& os) { os << std::showpos; }, m);
+        check([](std::ostream& os) { os << std::hex; }, mmath::matrix_base<int>{{255, -1}, {16, 0}});
+        check([](std::ostream&) {}, mmath::matrix_base<float>{{0.1f, 1e-7f}});
+        check([](std::ostream&) {}, mmath::matrix_base<long>{{-9000000000, 42}});
+        check([](std::ostream&) {}, mmath::matrix_base<char>{{'a', 'b'}});
+        check([](std::ostream&) {}, mmath::matrix_base<int>{});
+    }
+
+    SECTION("Options") {
+        mmath::format_options options;
+        options.column_delimiter = ", ";
+        options.row_delimiter = ";\n";
+        options.precision = 2;
+        options.float_format = std::chars_format::fixed;
+        CHECK(mmath::to_string(mmath::matrix_base<double>{{1, 2.5}, {-3.125, 4}}, options) ==
+              "1.00, 2.50;\n-3.12, 4.00");
+
+        // Shortest round trip by default
+        CHECK(mmath::to_string(mmath::matrix_base<double>{{0.1, 1.0 / 3}}) == "0.1 0.3333333333333333");
+
+        mmath::matrix_base<int> big{6, 6};
+        for (size_t i = 1; i <= 6; ++i)
+            for (size_t j = 1; j <= 6; ++j)
+                big(i, j) = static_cast<int>(i * 10 + j);
+        mmath::format_options elide;
+        elide.max_rows = 3;
+        elide.max_cols = 2;
+        CHECK(mmath::to_string(big, elide) == "11 ... 16\n21 ... 26\n...\n61 ... 66");
+    }
+
+    SECTION("CSV writer round trips") {
+        mmath::matrix_base<double> large{700, 5};
+        for (size_t i = 1; i <= 700; ++i)
+            for (size_t j = 1; j <= 5; ++j)
+                large(i, j) = std::sqrt(static_cast<double>(i * 5 + j)) - 10;
+
+        std::ostringstream csv, tsv;
+        mmath::write_csv(csv, large);
+        mmath::write_csv(tsv, large, {'\t'});
+        CHECK(mmath::parse_csv<double>(csv.str()) == large);
+        CHECK(mmath::parse_csv<double>(tsv.str(), {'\t'}) == large);
+        std::string text = csv.str();
+        CHECK(std::count(text.begin(), text.end(), '\n') == 700);
+    }
+}
+
+TEST_CASE("LaTeX Serialization") {
+    mmath::matrix_base<int> m{{1, -2, 3}, {4, 5, -6}};
+
+    CHECK(mmath::to_latex(m) == "\\begin{pmatrix}\n1 & -2 & 3 \\\\\n4 & 5 & -6\n\\end{pmatrix}");
+    CHECK(mmath::to_latex(m, {mmath::latex_environment::BMATRIX, 2}) ==
+          "\\left[\\begin{array}{cc|c}\n1 & -2 & 3 \\\\\n4 & 5 & -6\n\\end{array}\\right]");
+
+    mmath::format_buffer buffer;
+    mmath::to_latex(buffer, m, {mmath::latex_environment::MATRIX});
+    mmath::to_latex(buffer, m);
+    CHECK(buffer.view().starts_with("\\begin{matrix}"));
+    CHECK(buffer.view().ends_with("\\end{pmatrix}"));
+
+    for (auto environment : {mmath::latex_environment::MATRIX, mmath::latex_environment::PMATRIX,
+                             mmath::latex_environment::BMATRIX}) {
+        for (size_t augment : {0, 1, 2}) {
+            size_t detected = 99;
+            CHECK(mmath::from_latex<int>(mmath::to_latex(m, {environment, augment}), detected) == m);
+            CHECK(detected == augment);
+        }
+    }
+
+    mmath::matrix_base<double> d{{0.1, 1.0 / 3}, {-2.5e-10, 7}};
+    CHECK(mmath::from_latex<double>(mmath::to_latex(d)) == d);
+    CHECK(mmath::from_latex<double>("\\begin{vmatrix} {1.5} & +2 \\\\ 3 & 4 \\\\ \\end{vmatrix}") ==
+          mmath::matrix_base<double>{{1.5, 2}, {3, 4}});
+    CHECK(mmath::from_latex<int>(mmath::to_latex(mmath::matrix_base<int>{})).is_empty());
+
+    CHECK_THROWS_AS(mmath::from_latex<int>("\\begin{pmatrix} 1 & 2 \\\\ 3 \\end{pmatrix}"), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::from_latex<int>("\\begin{pmatrix} 1 & x \\end{pmatrix}"), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::from_latex<int>("\\begin{pmatrix} 1 \\end{bmatrix}"), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::from_latex<int>("\\begin{tabular} 1 \\end{tabular}"), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::from_latex<int>("\\begin{pmatrix} 1 "), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE_SIG("Batched Small Matrices", "", ((size_t N), N), 1, 2, 3, 4) {
+    // Large enough to take the parallel path
+    const size_t count = 10000;
+    mmath::matrix_batch<double, N, N> a{count}, b{count};
+    for (size_t k = 0; k < count; ++k) {
+        for (size_t r = 1; r <= N; ++r) {
+            for (size_t c = 1; c <= N; ++c) {
+                a(k, r, c) = static_cast<double>((k + r * 3 + c * 5) % 7) + (r == c ? 8.0 : 0.0);
+                b(k, r, c) = static_cast<double>((k * 2 + r + c) % 5) - 2.0;
+            }
+        }
+    }
+
+    auto product = a * b;
+    auto sum = a + b;
+    auto difference = a - b;
+    auto transposed = mmath::transpose(a);
+    auto traces = mmath::trace(a);
+    auto determinants = mmath::determinant(a);
+    auto inverses = mmath::inverse(a);
+
+    bool all_match = true;
+    for (size_t k = 0; k < count; k += 997) {
+        auto ak = a.get(k), bk = b.get(k);
+        all_match = all_match && product.get(k) == ak * bk;
+        all_match = all_match && sum.get(k) == ak + bk;
+        all_match = all_match && difference.get(k) == ak - bk;
+        all_match = all_match && transposed.get(k) == ak.transpose();
+        all_match = all_match && traces[k] == ak.tr();
+
+        auto identity = ak * inverses.get(k);
+        for (size_t r = 1; r <= N; ++r)
+            for (size_t c = 1; c <= N; ++c)
+                all_match = all_match && std::abs(identity(r, c) - (r == c ? 1.0 : 0.0)) < 1e-12;
+
+        // det(A) * det(A^-1) == 1
+        mmath::matrix_batch<double, N, N> single{1};
+        single.set(0, inverses.get(k));
+        all_match = all_match && std::abs(determinants[k] * mmath::determinant(single)[0] - 1.0) < 1e-12;
+    }
+    CHECK(all_match);
+    CHECK(mmath::transpose(transposed) == a);
+}
+
+TEST_CASE("Batched Small Matrices - Invalid Operations") {
+    mmath::matrix_batch<int, 2, 3> a{3};
+    mmath::matrix_batch<int, 3, 2> b{4};
+    CHECK_THROWS_AS(a * b, std::domain_error);
+    CHECK_THROWS_AS(a(3, 1, 1), std::out_of_range);
+    CHECK_THROWS_AS(a(0, 3, 1), std::out_of_range);
+    CHECK_THROWS_AS(a.set(0, mmath::matrix_base<int>{{1, 2}}), std::domain_error);
+
+    mmath::matrix_batch<int, 3, 3> integer{2};
+    integer.set(1, mmath::matrix_base<int>{{2, 0, 1}, {1, 3, 2}, {1, 1, 2}});
+    CHECK(mmath::determinant(integer) == std::vector<int>{0, 6});
+
+    mmath::matrix_batch<double, 2, 2> singular{2};
+    singular.set(0, mmath::matrix_base<double>{{1, 0}, {0, 1}});
+    singular.set(1, mmath::matrix_base<double>{{1, 2}, {2, 4}});
+    CHECK_THROWS_AS(mmath::inverse(singular), std::domain_error);
+}
+
+TEST_CASE("Mixed Precision") {
+    SECTION("Widening multiply") {
+        mmath::matrix_base<float> a{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+        mmath::matrix_base<float> b{{7.0f, 8.0f}, {9.0f, 10.0f}, {11.0f, 12.0f}};
+        auto product = mmath::mixed_multiply(a, b);
+        STATIC_REQUIRE(std::is_same_v<decltype(product), mmath::matrix_base<double>>);
+        CHECK(product == mmath::matrix_base<double>{{58, 64}, {139, 154}});
+
+        // 1 + 1e-8 rounds back to 1 in float but not in double
+        mmath::matrix_base<float> row{{1.0f, 1e-8f}};
+        mmath::matrix_base<float> col{{1.0f}, {1.0f}};
+        CHECK((row * col)(1, 1) == 1.0f);
+        CHECK(mmath::mixed_multiply(row, col)(1, 1) == Catch::Approx(1.0 + 1e-8).epsilon(1e-12));
+
+        // 127 * 127 * 4 overflows int8 and int16 but not int32
+        mmath::matrix_base<int8_t> a8{{127, 127, 127, 127}, {-128, -128, -128, -128}};
+        mmath::matrix_base<int8_t> b8{{127}, {127}, {127}, {127}};
+        auto product8 = mmath::mixed_multiply(a8, b8);
+        STATIC_REQUIRE(std::is_same_v<decltype(product8), mmath::matrix_base<int32_t>>);
+        CHECK(product8 == mmath::matrix_base<int32_t>{{64516}, {-65024}});
+
+        mmath::matrix_base<int16_t> a16{{32767, 32767}};
+        mmath::matrix_base<int16_t> b16{{2}, {2}};
+        CHECK(mmath::mixed_multiply(a16, b16) == mmath::matrix_base<int32_t>{{131068}});
+        CHECK(mmath::mixed_multiply<int64_t>(a16, b16) == mmath::matrix_base<int64_t>{{131068}});
+
+        CHECK_THROWS_AS(mmath::mixed_multiply(a, a), std::domain_error);
+        CHECK_THROWS_AS(mmath::mixed_multiply(mmath::matrix_base<float>{}, b), std::invalid_argument);
+    }
+
+    SECTION("LU solve") {
+        mmath::matrix_base<double> a{{0, 2, 1}, {1, 1, 1}, {2, 1, 0}};
+        auto x = mmath::lu_solve(a, std::vector<double>{7, 6, 4});
+        CHECK(x[0] == Catch::Approx(1));
+        CHECK(x[1] == Catch::Approx(2));
+        CHECK(x[2] == Catch::Approx(3));
+
+        CHECK_THROWS_AS(mmath::lu_solve(mmath::matrix_base<double>{{1, 2}, {2, 4}}, std::vector<double>{1, 2}),
+                        std::domain_error);
+        CHECK_THROWS_AS(mmath::lu_solve(mmath::matrix_base<double>{{1, 2}}, std::vector<double>{1}),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(mmath::lu_solve(a, std::vector<double>{1, 2}), std::domain_error);
+    }
+
+    SECTION("Iterative refinement") {
+        // Larger than one LU panel so the blocked update is exercised
+        const size_t n = 150;
+        std::vector<double> expected(n), b(n), x(n);
+        for (size_t i = 0; i < n; ++i)
+            expected[i] = std::sin(static_cast<double>(i) + 1.0);
+
+        auto make_rhs = [&](const mmath::matrix_base<double>& a) {
+            mmath::m_kernel::gemv(n, n, a.raw_data(), n, expected.data(), b.data());
+        };
+        auto max_error = [&] {
+            double error = 0;
+            for (size_t i = 0; i < n; ++i)
+                error = std::max(error, std::abs(x[i] - expected[i]));
+            return error;
+        };
+
+        mmath::matrix_base<double> well{n, n};
+        for (size_t i = 1; i <= n; ++i)
+            for (size_t j = 1; j <= n; ++j)
+                well(i, j) = std::cos(static_cast<double>(i * 7 + j * 3)) + (i == j ? static_cast<double>(n) : 0.0);
+        make_rhs(well);
+
+        auto result = mmath::mixed_precision_solve(well, std::span<const double>{b}, std::span<double>{x});
+        CHECK(result.converged);
+        CHECK_FALSE(result.fell_back);
+        CHECK(result.iterations > 0);
+        CHECK(result.backward_error < 1e-14);
+        CHECK(max_error() < 1e-12);
+
+        // Hilbert matrices lose everything in float beyond n = 8 or so
+        const size_t h = 10;
+        mmath::matrix_base<double> hilbert{h, h};
+        for (size_t i = 1; i <= h; ++i)
+            for (size_t j = 1; j <= h; ++j)
+                hilbert(i, j) = 1.0 / static_cast<double>(i + j - 1);
+        std::vector<double> hb(h, 1.0), hx(h);
+        auto ill = mmath::mixed_precision_solve(hilbert, std::span<const double>{hb}, std::span<double>{hx});
+        CHECK(ill.fell_back);
+        CHECK(ill.backward_error < 1e-14);
+
+        // Singular in float after rounding, but not in double
+        mmath::matrix_base<double> rounded{{1.0, 1.0}, {1.0, 1.0 + 1e-10}};
+        std::vector<double> rb{2.0, 2.0 + 1e-10}, rx(2);
+        auto fallback = mmath::mixed_precision_solve(rounded, std::span<const double>{rb}, std::span<double>{rx});
+        CHECK(fallback.fell_back);
+        CHECK(rx[0] == Catch::Approx(1.0).epsilon(1e-5));
+        CHECK(rx[1] == Catch::Approx(1.0).epsilon(1e-5));
+
+        std::vector<double> short_b(n - 1);
+        CHECK_THROWS_AS(mmath::mixed_precision_solve(well, std::span<const double>{short_b}, std::span<double>{x}),
+                        std::domain_error);
+        CHECK_THROWS_AS(mmath::mixed_precision_solve(mmath::matrix_base<double>{{1, 2}}, std::span<const double>{b},
+                                                     std::span<double>{x}),
+                        std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE("Quantized Multiply", "", int8_t, uint8_t, int16_t) {
+    // Sizes that leave remainders in both kernel dimensions and an odd k
+    const size_t m = 37, n = 29, k = 51;
+    mmath::matrix_base<TestType> a{m, k};
+    mmath::matrix_base<int8_t> b{k, n};
+    for (size_t i = 1; i <= m; ++i)
+        for (size_t p = 1; p <= k; ++p)
+            a(i, p) = static_cast<TestType>(std::numeric_limits<TestType>::min() + (i * 31 + p * 17) % 251);
+    for (size_t p = 1; p <= k; ++p)
+        for (size_t j = 1; j <= n; ++j)
+            b(p, j) = static_cast<int8_t>(static_cast<int>((p * 13 + j * 7) % 256) - 128);
+
+    auto reference = [&](int32_t za, int32_t zb) {
+        mmath::matrix_base<int64_t> result{m, n};
+        for (size_t i = 1; i <= m; ++i)
+            for (size_t j = 1; j <= n; ++j)
+                for (size_t p = 1; p <= k; ++p)
+                    result(i, j) += (static_cast<int64_t>(a(i, p)) - za) * (static_cast<int64_t>(b(p, j)) - zb);
+        return result;
+    };
+
+    auto raw = mmath::quantized_multiply(a, b);
+    STATIC_REQUIRE(std::is_same_v<decltype(raw), mmath::matrix_base<int32_t>>);
+    auto expected = reference(0, 0);
+    bool all_match = true;
+    for (size_t i = 1; i <= m; ++i)
+        for (size_t j = 1; j <= n; ++j)
+            all_match = all_match && raw(i, j) == expected(i, j);
+    CHECK(all_match);
+
+    // Per tensor zero points
+    auto offset = mmath::quantized_multiply(a, b, {{}, {3}}, {{}, {-5}});
+    expected = reference(3, -5);
+    all_match = true;
+    for (size_t i = 1; i <= m; ++i)
+        for (size_t j = 1; j <= n; ++j)
+            all_match = all_match && offset(i, j) == expected(i, j);
+    CHECK(all_match);
+
+    // Per row and per column scales dequantize to float
+    mmath::quantization_params a_params{std::vector<float>(m), {3}}, b_params{std::vector<float>(n), {-5}};
+    for (size_t i = 0; i < m; ++i)
+        a_params.scale[i] = 0.01f * static_cast<float>(i + 1);
+    for (size_t j = 0; j < n; ++j)
+        b_params.scale[j] = 0.5f / static_cast<float>(j + 1);
+    auto real = mmath::quantized_multiply<float>(a, b, a_params, b_params);
+    all_match = true;
+    for (size_t i = 1; i <= m; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            double value = static_cast<double>(a_params.scale[i - 1]) * b_params.scale[j - 1] * expected(i, j);
+            all_match = all_match && real(i, j) == Catch::Approx(value).epsilon(1e-6);
+        }
+    }
+    CHECK(all_match);
+}
+
+TEST_CASE("Quantized Multiply - Requantization and Invalid Operations") {
+    mmath::matrix_base<uint8_t> a{{255, 255}, {0, 1}};
+    mmath::matrix_base<int8_t> b{{127, -128}, {127, 1}};
+    CHECK(mmath::quantized_multiply(a, b) == mmath::matrix_base<int32_t>{{64770, -32385}, {127, 1}});
+    // Rounded to nearest and saturated to the int8 range
+    CHECK(mmath::quantized_multiply<int8_t>(a, b, {{0.01f}, {}}) ==
+          mmath::matrix_base<int8_t>{{127, -128}, {1, 0}});
+    // Saturated without scales too
+    CHECK(mmath::quantized_multiply<int16_t>(a, b) == mmath::matrix_base<int16_t>{{32767, -32385}, {127, 1}});
+    CHECK(mmath::quantized_multiply<int8_t>(a, b) == mmath::matrix_base<int8_t>{{127, -128}, {127, 1}});
+
+    CHECK_THROWS_AS(mmath::quantized_multiply(a, mmath::matrix_base<int8_t>{{1, 2}}), std::domain_error);
+    CHECK_THROWS_AS(mmath::quantized_multiply(mmath::matrix_base<int8_t>{}, b), std::invalid_argument);
+    CHECK_THROWS_AS(mmath::quantized_multiply(a, b, {{1.0f, 2.0f, 3.0f}, {}}), std::domain_error);
+    CHECK_THROWS_AS(mmath::quantized_multiply(a, b, {}, {{}, {1, 2, 3}}), std::domain_error);
+}
+
+TEST_CASE("Modular Matrices") {
+    SECTION("Multiply matches exact arithmetic") {
+        // A prime just below 2^32 reduces after every product, 1e9 + 7 defers 18
+        for (uint32_t p : {2u, 998244353u, 1000000007u, 4294967291u}) {
+            const size_t m = 70, k = 300, n = 45;
+            mmath::mod_matrix a{m, k, p}, b{k, n, p};
+            for (size_t i = 1; i <= m; ++i)
+                for (size_t j = 1; j <= k; ++j)
+                    a.set(i, j, (i * 2654435761u + j * 40503u) % p);
+            for (size_t i = 1; i <= k; ++i)
+                for (size_t j = 1; j <= n; ++j)
+                    b.set(i, j, p - 1 - (i * 97u + j * 2246822519u) % p);
+
+            auto c = a * b;
+            bool all_match = true;
+            for (size_t i = 1; i <= m; i += 7) {
+                for (size_t j = 1; j <= n; j += 5) {
+                    unsigned __int128 sum = 0;
+                    for (size_t q = 1; q <= k; ++q)
+                        sum += static_cast<unsigned __int128>(a(i, q)) * b(q, j);
+                    all_match = all_match && c(i, j) == static_cast<uint32_t>(sum % p);
+                }
+            }
+            CHECK(all_match);
+        }
+    }
+
+    SECTION("Linear recurrences") {
+        const uint32_t p = 1000000007;
+        mmath::mod_matrix fibonacci{mmath::matrix_base<int>{{1, 1}, {1, 0}}, p};
+        uint64_t previous = 0, current = 1;
+        for (int i = 1; i < 1000; ++i)
+            previous = std::exchange(current, (previous + current) % p);
+        CHECK((fibonacci ^ 1000)(1, 2) == current);
+        CHECK((fibonacci ^ 0) == mmath::mod_matrix::identity(2, p));
+        // F(10^18) mod 1e9 + 7
+        CHECK((fibonacci ^ 1000000000000000000LL)(1, 2) == 209783453);
+        CHECK_THROWS_AS(fibonacci ^ -1, std::invalid_argument);
+    }
+
+    SECTION("Elementwise and conversions") {
+        const uint32_t p = 7;
+        mmath::mod_matrix a{mmath::matrix_base<int>{{-1, 8}, {14, -15}}, p};
+        CHECK(a.to_matrix() == mmath::matrix_base<uint32_t>{{6, 1}, {0, 6}});
+        CHECK((a + a).to_matrix<int>() == mmath::matrix_base<int>{{5, 2}, {0, 5}});
+        CHECK((a - a * 3).to_matrix<int>() == mmath::matrix_base<int>{{2, 5}, {0, 2}});
+        CHECK((-2 * a) == a * 5);
+        CHECK(mmath::mod_matrix{mmath::matrix_base<int64_t>{{std::numeric_limits<int64_t>::min()}}, p}(1, 1) ==
+              static_cast<uint32_t>((std::numeric_limits<int64_t>::min() % 7 + 7) % 7));
+    }
+
+    SECTION("Determinant and inverse over GF(p)") {
+        const uint32_t p = 998244353;
+        const size_t n = 40;
+        mmath::mod_matrix a{n, n, p}, b{n, n, p};
+        uint64_t state = 1;
+        auto next = [&] { return (state = state * 6364136223846793005u + 1442695040888963407u) >> 33; };
+        for (size_t i = 1; i <= n; ++i) {
+            for (size_t j = 1; j <= n; ++j) {
+                a.set(i, j, next());
+                b.set(i, j, -static_cast<int64_t>(next()));
+            }
+        }
+        CHECK(mmath::determinant(a * b) == a.arithmetic().mul(mmath::determinant(a), mmath::determinant(b)));
+        CHECK(a * mmath::inverse(a) == mmath::mod_matrix::identity(n, p));
+        CHECK(mmath::inverse(mmath::inverse(b)) == b);
+
+        mmath::mod_matrix small{mmath::matrix_base<int>{{0, 1}, {1, 0}}, 5};
+        CHECK(mmath::determinant(small) == 4);
+        CHECK(mmath::inverse(small) == small);
+
+        // Singular modulo 5 but not over the integers
+        mmath::mod_matrix singular{mmath::matrix_base<int>{{1, 2}, {3, 1}}, 5};
+        CHECK(mmath::determinant(singular) == 0);
+        CHECK_THROWS_AS(mmath::inverse(singular), std::domain_error);
+    }
+
+    SECTION("Invalid operations") {
+        CHECK_THROWS_AS(mmath::mod_matrix(2, 2, 1), std::invalid_argument);
+        mmath::mod_matrix a{2, 3, 7}, b{2, 3, 11};
+        CHECK_THROWS_AS(a + b, std::domain_error);
+        CHECK_THROWS_AS(a * mmath::mod_matrix(2, 3, 7), std::domain_error);
+        CHECK_THROWS_AS(a * mmath::mod_matrix(0, 0, 7), std::invalid_argument);
+        CHECK_THROWS_AS(a ^ 2, std::invalid_argument);
+        CHECK_THROWS_AS(mmath::determinant(a), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::inverse(a), std::invalid_argument);
+        CHECK_THROWS_AS(a(3, 1), std::out_of_range);
+        CHECK_THROWS_AS(a.set(0, 1, 1), std::out_of_range);
+    }
+}
+
+TEMPLATE_TEST_CASE("Semiring Shortest Paths", "", double, int) {
+    // Larger than one gemm block so the blocked and parallel paths are used
+    const size_t n = 150;
+    const TestType none = mmath::min_plus<TestType>::zero();
+    mmath::matrix_base<TestType> weights{n, n, none};
+    uint64_t state = 7;
+    auto next = [&] { return (state = state * 6364136223846793005u + 1442695040888963407u) >> 33; };
+    for (size_t i = 1; i <= n; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            if (next() % 20 == 0)
+                weights(i, j) = static_cast<TestType>(next() % 100);
+        }
+    }
+
+    // Floyd-Warshall reference
+    auto expected = weights;
+    for (size_t i = 1; i <= n; ++i)
+        expected(i, i) = std::min(expected(i, i), TestType{});
+    for (size_t k = 1; k <= n; ++k)
+        for (size_t i = 1; i <= n; ++i)
+            for (size_t j = 1; j <= n; ++j)
+                if (expected(i, k) != none && expected(k, j) != none)
+                    expected(i, j) = std::min(expected(i, j), expected(i, k) + expected(k, j));
+
+    auto distances = mmath::shortest_paths(weights);
+    CHECK(std::equal(distances.raw_data(), distances.raw_data() + n * n, expected.raw_data()));
+
+    // Paths of exactly two edges
+    auto two = mmath::semiring_multiply<mmath::min_plus>(weights, weights);
+    CHECK(two == mmath::semiring_power<mmath::min_plus>(weights, 2));
+    bool all_match = true;
+    for (size_t i = 1; i <= n; i += 13) {
+        for (size_t j = 1; j <= n; j += 11) {
+            TestType best = none;
+            for (size_t k = 1; k <= n; ++k)
+                if (weights(i, k) != none && weights(k, j) != none)
+                    best = std::min(best, static_cast<TestType>(weights(i, k) + weights(k, j)));
+            all_match = all_match && two(i, j) == best;
+        }
+    }
+    CHECK(all_match);
+}
+
+TEST_CASE("Semiring Multiply") {
+    SECTION("Transitive closure") {
+        // 1 -> 2 -> 3 -> 1 is a cycle, 4 -> 5 a chain, 6 isolated
+        mmath::matrix_base<int> adjacency{6, 6};
+        adjacency(1, 2) = adjacency(2, 3) = adjacency(3, 1) = 1;
+        adjacency(4, 5) = 7;
+        adjacency(5, 3) = 1;
+        auto reach = mmath::transitive_closure(adjacency);
+        CHECK(reach == mmath::matrix_base<int>{{1, 1, 1, 0, 0, 0},
+                                                {1, 1, 1, 0, 0, 0},
+                                                {1, 1, 1, 0, 0, 0},
+                                                {1, 1, 1, 1, 1, 0},
+                                                {1, 1, 1, 0, 1, 0},
+                                                {0, 0, 0, 0, 0, 1}});
+        auto uint8_reach = mmath::transitive_closure(mmath::matrix_base<uint8_t>{{0, 1}, {0, 0}});
+        CHECK(uint8_reach == mmath::matrix_base<uint8_t>{{1, 1}, {0, 1}});
+    }
+
+    SECTION("Max plus scheduling") {
+        // Longest path through a task graph: 1 -> 2 (3), 1 -> 3 (2), 2 -> 4 (4), 3 -> 4 (6)
+        const double none = mmath::max_plus<double>::zero();
+        mmath::matrix_base<double> durations{4, 4, none};
+        durations(1, 2) = 3;
+        durations(1, 3) = 2;
+        durations(2, 4) = 4;
+        durations(3, 4) = 6;
+        auto longest = mmath::semiring_closure<mmath::max_plus>(durations);
+        CHECK(longest(1, 4) == 8);
+        CHECK(longest(1, 2) == 3);
+        CHECK(longest(4, 1) == none);
+        CHECK(mmath::semiring_power<mmath::max_plus>(durations, 2)(1, 4) == 8);
+        CHECK(mmath::semiring_power<mmath::max_plus>(durations, 0) == mmath::semiring_identity<mmath::max_plus, double>(4));
+    }
+
+    SECTION("Integral tropical products saturate") {
+        constexpr int top = std::numeric_limits<int>::max(), bottom = std::numeric_limits<int>::lowest();
+        CHECK(mmath::min_plus<int>::mul(top, -5) == top);
+        CHECK(mmath::min_plus<int>::mul(-5, top) == top);
+        CHECK(mmath::min_plus<int>::mul(top - 1, 10) == top);
+        CHECK(mmath::min_plus<int>::mul(bottom + 1, -10) == bottom);
+        CHECK(mmath::max_plus<int>::mul(bottom, 5) == bottom);
+        CHECK(mmath::max_plus<int>::mul(5, bottom) == bottom);
+        CHECK(mmath::max_plus<int>::mul(top - 1, 10) == top);
+
+        // Nearly unreachable paths stay long instead of wrapping to short ones
+        mmath::matrix_base<int> far{{0, top - 1}, {top - 1, 0}};
+        CHECK(mmath::semiring_power<mmath::min_plus>(far, 2) == far);
+        mmath::matrix_base<int> negative{{top, -3}, {top, top}};
+        CHECK(mmath::semiring_multiply<mmath::min_plus>(negative, negative) ==
+              mmath::matrix_base<int>{{top, top}, {top, top}});
+    }
+
+    SECTION("Plus times matches operator*") {
+        mmath::matrix_base<long> a{{1, 2, 0}, {0, 1, 3}, {4, 0, 1}};
+        CHECK(mmath::semiring_multiply<mmath::plus_times>(a, a) == a * a);
+        CHECK(mmath::semiring_power<mmath::plus_times>(a, 13) == (a ^ 13));
+        auto expected = a;
+        for (int i = 1; i < 13; ++i)
+            expected = expected * a;
+        CHECK((a ^ 13) == expected);
+    }
+
+    SECTION("Invalid operations") {
+        mmath::matrix_base<int> a{2, 3};
+        CHECK_THROWS_AS(mmath::semiring_multiply<mmath::min_plus>(a, a), std::domain_error);
+        CHECK_THROWS_AS(mmath::semiring_multiply<mmath::min_plus>(a, mmath::matrix_base<int>{}), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::semiring_power<mmath::min_plus>(a, 2), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::semiring_power<mmath::min_plus>(mmath::matrix_base<int>{2, 2}, -1),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(mmath::shortest_paths(a), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Bit Matrices") {
+    // Sizes straddling word and table boundaries
+    const size_t m = 131, k = 203, n = 77;
+    uint64_t state = 11;
+    auto next = [&] { return (state = state * 6364136223846793005u + 1442695040888963407u) >> 33; };
+    mmath::matrix_base<int> a_int{m, k}, b_int{k, n};
+    for (size_t i = 1; i <= m; ++i)
+        for (size_t j = 1; j <= k; ++j)
+            a_int(i, j) = next() % 13 == 0;
+    for (size_t i = 1; i <= k; ++i)
+        for (size_t j = 1; j <= n; ++j)
+            b_int(i, j) = next() % 11 == 0;
+    mmath::bit_matrix a{a_int}, b{b_int};
+
+    SECTION("Construction and access") {
+        CHECK(a.to_matrix() == a_int);
+        CHECK(a.row_words() == 4);
+        a.set(1, k, true);
+        CHECK(a(1, k));
+        a.flip(1, k);
+        CHECK_FALSE(a(1, k));
+        size_t ones = 0;
+        for (int value : std::vector<int>(a_int.raw_data(), a_int.raw_data() + m * k))
+            ones += static_cast<size_t>(value);
+        CHECK(a.count() == ones);
+        CHECK(mmath::bit_matrix::identity(70).count() == 70);
+        CHECK_THROWS_AS(a(m + 1, 1), std::out_of_range);
+        CHECK_THROWS_AS(a.set(1, 0), std::out_of_range);
+    }
+
+    SECTION("Boolean product") {
+        auto product = (a * b).to_matrix();
+        auto counts = a_int * b_int;
+        bool all_match = true;
+        for (size_t i = 1; i <= m; ++i)
+            for (size_t j = 1; j <= n; ++j)
+                all_match = all_match && product(i, j) == (counts(i, j) != 0);
+        CHECK(all_match);
+
+        CHECK((a | a) == a);
+        CHECK((a ^ a).count() == 0);
+        CHECK((a & mmath::bit_matrix{m, k}).count() == 0);
+        CHECK_THROWS_AS(a * a, std::domain_error);
+        CHECK_THROWS_AS(a * mmath::bit_matrix{}, std::invalid_argument);
+        CHECK_THROWS_AS(a | b, std::domain_error);
+    }
+
+    SECTION("Transpose") {
+        auto t = mmath::transpose(a);
+        CHECK(t.size_row() == k);
+        CHECK(t.size_col() == m);
+        CHECK(t.to_matrix() == a_int.transpose());
+        CHECK(t.transpose() == a);
+    }
+
+    SECTION("Transitive closure") {
+        const size_t nodes = 300;
+        mmath::matrix_base<int> graph{nodes, nodes};
+        for (size_t i = 1; i <= nodes; ++i)
+            if (next() % 3 != 0)
+                graph(i, next() % nodes + 1) = 1;
+        auto reach = mmath::transitive_closure(mmath::bit_matrix{graph});
+        CHECK(reach.to_matrix() == mmath::transitive_closure(graph));
+        CHECK_THROWS_AS(mmath::transitive_closure(a), std::invalid_argument);
+    }
+
+    SECTION("GF(2) elimination") {
+        auto reduced = mmath::gf2_rref(a);
+        size_t rank = mmath::gf2_rank(a);
+        CHECK(rank == mmath::gf2_rank(a.transpose()));
+
+        // Leading ones with nothing above or below them
+        size_t pivots = 0, last = 0;
+        bool echelon = true;
+        for (size_t i = 1; i <= m; ++i) {
+            size_t lead = 0;
+            for (size_t j = 1; j <= k && lead == 0; ++j)
+                if (reduced(i, j))
+                    lead = j;
+            if (lead == 0)
+                continue;
+            ++pivots;
+            echelon = echelon && lead > last && i == pivots;
+            last = lead;
+            for (size_t r = 1; r <= m; ++r)
+                echelon = echelon && (r == i || !reduced(r, lead));
+        }
+        CHECK(echelon);
+        CHECK(pivots == rank);
+
+        // Row operations preserve the rank; a duplicated row does not add to it
+        auto copy = a;
+        copy.add_row(2, 1);
+        copy.swap_rows(3, 4);
+        CHECK(mmath::gf2_rank(copy) == rank);
+        mmath::bit_matrix dependent{mmath::matrix_base<int>{{1, 1, 0}, {0, 1, 1}, {1, 0, 1}}};
+        CHECK(mmath::gf2_rank(dependent) == 2);
+        CHECK(mmath::gf2_rank(mmath::bit_matrix::identity(100)) == 100);
+        CHECK_THROWS_AS(copy.add_row(0, 1), std::out_of_range);
+        CHECK_THROWS_AS(copy.swap_rows(1, m + 1), std::out_of_range);
+    }
+}
+
+TEST_CASE("Matrix Spans") {
+    using namespace mmath;
+
+    // 2 x 3 matrix {{1, 2, 3}, {4, 5, 6}} stored three ways
+    double row_major[] = {1, 2, 3, 4, 5, 6};
+    double column_major[] = {1, 4, 2, 5, 3, 6};
+    double padded[] = {1, 2, 3, -1, 4, 5, 6, -1};
+    const matrix_base<double> expected{{1, 2, 3}, {4, 5, 6}};
+
+    SECTION("Layouts") {
+        matrix_span<double> right{row_major, 2, 3};
+        matrix_span<double, layout_left> left{column_major, 2, 3};
+        matrix_span<double, layout_stride> stride{padded, 2, 3, 4, 1};
+        CHECK(right.is_contiguous());
+        CHECK_FALSE(left.is_contiguous());
+        CHECK_FALSE(stride.is_contiguous());
+        CHECK(left(2, 1) == 4);
+        CHECK(stride(2, 3) == 6);
+        CHECK_THROWS_AS(right(3, 1), std::out_of_range);
+
+        CHECK(to_matrix(right) == expected);
+        CHECK(to_matrix(left) == expected);
+        CHECK(to_matrix(stride) == expected);
+
+        // Any layout converts to layout_stride, and any span to a const one
+        matrix_span<const double, layout_stride> general = left;
+        CHECK(to_matrix(general) == expected);
+
+        const size_t n = 70;
+        std::vector<int> large(n * n);
+        for (size_t i = 0; i < large.size(); ++i)
+            large[i] = static_cast<int>(i);
+        CHECK(to_matrix(matrix_span<int, layout_left>{large.data(), n, n}) ==
+              transpose(to_matrix(matrix_span<int>{large.data(), n, n})));
+    }
+
+    SECTION("Exporting") {
+        matrix_base<double> matrix = expected;
+        matrix_span<const double> view = as_span(std::as_const(matrix));
+        CHECK(view.data_handle() == std::as_const(matrix).raw_data());
+        CHECK(view(2, 2) == 5);
+
+        std::fill(std::begin(column_major), std::end(column_major), 0.0);
+        copy_to(matrix, matrix_span<double, layout_left>{column_major, 2, 3});
+        CHECK(column_major[1] == 4);
+        CHECK(column_major[4] == 3);
+        CHECK_THROWS_AS(copy_to(matrix, matrix_span<double>{row_major, 3, 2}), std::domain_error);
+    }
+
+    SECTION("Borrowing") {
+        matrix_base<double> borrowed = borrow_matrix(matrix_span<double>{row_major, 2, 3});
+        CHECK(std::as_const(borrowed).raw_data() == row_major);
+        CHECK(borrowed == expected);
+
+        // Writes reach the external memory, results of algorithms are new matrices
+        borrowed(1, 1) = 10;
+        CHECK(row_major[0] == 10);
+        matrix_base<double> product = borrowed * transpose(borrowed);
+        CHECK(product == matrix_base<double>{{113, 68}, {68, 77}});
+
+        // Copies own their elements
+        matrix_base<double> copy = borrowed;
+        copy(1, 1) = 1;
+        CHECK(row_major[0] == 10);
+
+        matrix_base<double> moved = std::move(borrowed);
+        CHECK(std::as_const(moved).raw_data() == row_major);
+    }
+}
+
+TEST_CASE("Tuning") {
+    using namespace mmath;
+
+    SECTION("Settings") {
+        std::istringstream file{"# written by mmath_tune\n"
+                                "gemm.block_k = 96\n"
+                                "\n"
+                                "gemm.double.block_n = 512  # per type\n"
+                                "trsm.float.block_size=16\n"
+                                "gemm.long_double.block_m = 24\n"};
+        tuning_settings settings = read_tuning(file);
+        CHECK(settings.size() == 4);
+        CHECK(m_kernel::gemm_config_from(settings, m_tuning::type_key<long double>()).block_m == 24);
+
+        m_kernel::gemm_config for_double = m_kernel::gemm_config_from(settings, "double");
+        CHECK(for_double.block_n == 512);
+        CHECK(for_double.block_k == 96);
+        CHECK(for_double.block_m == m_kernel::gemm_config{}.block_m);
+        m_kernel::gemm_config shared = m_kernel::gemm_config_from(settings, nullptr);
+        CHECK(shared.block_n == m_kernel::gemm_config{}.block_n);
+        CHECK(shared.block_k == 96);
+        CHECK(m_kernel::trsm_config_from(settings, "float").block_size == 16);
+        CHECK(m_kernel::trsm_config_from(settings, "double").block_size == m_kernel::trsm_config{}.block_size);
+        CHECK(m_kernel::transpose_config_from(settings, "int32").tile == m_kernel::transpose_config{}.tile);
+
+        std::ostringstream written;
+        write_tuning(written, settings);
+        std::istringstream reread{written.str()};
+        CHECK(read_tuning(reread) == settings);
+
+        for (const char* line : {"gemm.block_m 64", "gemm.block_m = -1", "gemm.block_m = 12x", "= 5", "gemm m = 1"}) {
+            std::istringstream broken{line};
+            CHECK_THROWS_AS(read_tuning(broken), std::invalid_argument);
+        }
+    }
+
+    SECTION("Results do not depend on the blocking") {
+        const size_t m = 37, k = 23, n = 41;
+        matrix_base<double> a{m, k, [](size_t i, size_t j) { return static_cast<double>((i * 7 + j) % 11) - 5; }};
+        matrix_base<double> b{k, n, [](size_t i, size_t j) { return static_cast<double>((i + j * 3) % 13) - 6; }};
+        matrix_base<double> system{m, m, [](size_t i, size_t j) {
+                                       return i == j ? 40.0 : 1.0 / static_cast<double>(i + j);
+                                   }};
+        std::vector<double> rhs(m, 1.0);
+        const matrix_base<double> product = a * b;
+        const matrix_base<double> transposed = transpose(a);
+        const std::vector<double> solution = lu_solve(system, rhs);
+
+        const m_kernel::gemm_config gemm_saved = m_kernel::gemm_tuning<double>();
+        const m_kernel::trsm_config trsm_saved = m_kernel::trsm_tuning<double>();
+        const m_kernel::transpose_config transpose_saved = m_kernel::transpose_tuning<double>();
+        m_kernel::gemm_tuning<double>() = {3, 5, 7, 1};
+        m_kernel::trsm_tuning<double>() = {5, 2};
+        m_kernel::transpose_tuning<double>().tile = 3;
+
+        CHECK(a * b == product);
+        CHECK(transpose(a) == transposed);
+        std::vector<double> blocked = lu_solve(system, rhs);
+        for (size_t i = 0; i < m; ++i)
+            CHECK(blocked[i] == Catch::Approx(solution[i]));
+
+        m_kernel::gemm_tuning<double>() = gemm_saved;
+        m_kernel::trsm_tuning<double>() = trsm_saved;
+        m_kernel::transpose_tuning<double>() = transpose_saved;
+    }
+}
+
+namespace {
+    // Coroutine that starts at once and is never awaited itself
+    struct detached {
+        struct promise_type {
+            detached get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    detached square_trace(mmath::matrix_base<double> a, std::atomic<double>& trace) {
+        mmath::matrix_base<double> square = co_await mmath::async_multiply(a, a);
+        trace = square.tr();
+        trace.notify_all();
+    }
+}  // namespace
+
+TEST_CASE("Asynchronous Operations") {
+    using namespace mmath;
+
+    const size_t n = 150;
+    matrix_base<double> a{n, n, [](size_t i, size_t j) {
+                              return i == j ? 2.0 : static_cast<double>((i * 7 + j * 3) % 5) / 50.0;
+                          }};
+    std::vector<double> b(n, 1.0);
+
+    SECTION("Results") {
+        auto product = async_multiply(a, transpose(a));
+        auto power = async_power(a, 5);
+        auto transposed = async_transpose(a);
+        auto solution = async_lu_solve(a, b);
+        CHECK(product.valid());
+
+        CHECK(product.get() == a * transpose(a));
+        CHECK_FALSE(product.valid());
+        CHECK(power.get() == (a ^ 5));
+        CHECK(transposed.get() == transpose(a));
+        CHECK(solution.get() == lu_solve(a, b));
+        CHECK(async_power(a, 0).get() == make_identity_matrix<double>(n));
+    }
+
+    SECTION("Progress") {
+        std::vector<double> reported;
+        async_options options;
+        options.progress = [&](double fraction) { reported.push_back(fraction); };
+        async_power(a, 12, options).get();
+        REQUIRE(reported.size() > 4);
+        CHECK(std::is_sorted(reported.begin(), reported.end()));
+        CHECK(reported.back() == Catch::Approx(1.0));
+
+        reported.clear();
+        async_lu_solve(a, b, options).get();
+        REQUIRE_FALSE(reported.empty());
+        CHECK(std::is_sorted(reported.begin(), reported.end()));
+        CHECK(reported.back() == Catch::Approx(1.0));
+    }
+
+    SECTION("Cancellation") {
+        std::stop_source stop;
+        stop.request_stop();
+        async_options cancelled;
+        cancelled.stop_token = stop.get_token();
+        CHECK_THROWS_AS(async_multiply(a, a, cancelled).get(), operation_cancelled);
+
+        // Stopped by its own progress callback after the first step
+        std::stop_source midway;
+        async_options options;
+        options.stop_token = midway.get_token();
+        options.progress = [&](double) { midway.request_stop(); };
+        CHECK_THROWS_AS(async_power(a, 64, options).get(), operation_cancelled);
+        CHECK_THROWS_AS(async_lu_solve(a, b, options).get(), operation_cancelled);
+
+        auto finished = async_transpose(a);
+        finished.wait();
+        CHECK_FALSE(finished.cancel());
+        CHECK(finished.get() == transpose(a));
+    }
+
+    SECTION("Callbacks and Coroutines") {
+        std::atomic<bool> called{false};
+        auto future = async_multiply(a, a);
+        future.on_ready([&] {
+            called = true;
+            called.notify_all();
+        });
+        called.wait(false);
+        CHECK(future.ready());
+        CHECK(future.wait_for(std::chrono::seconds{0}));
+        CHECK(future.get() == a * a);
+
+        std::atomic<double> trace{0};
+        square_trace(a, trace);
+        trace.wait(0);
+        CHECK(trace == Catch::Approx((a * a).tr()));
+    }
+
+    SECTION("Invalid Operations") {
+        matrix_base<double> wide{2, 3};
+        CHECK_THROWS_AS(async_multiply(wide, wide), std::domain_error);
+        CHECK_THROWS_AS(async_power(wide, 2), std::invalid_argument);
+        CHECK_THROWS_AS(async_lu_solve(a, std::vector<double>(n + 1)), std::domain_error);
+        CHECK_THROWS_AS(async_lu_solve(matrix_base<double>{2, 2}, std::vector<double>(2)).get(), std::domain_error);
+        CHECK_THROWS_AS(matrix_future<std::vector<double>>{}.get(), std::logic_error);
+    }
+}
+
+TEST_CASE("Krylov Solvers") {
+    // 2D Poisson problem on a grid x grid mesh, symmetric positive definite
+    const size_t grid = 20, n = grid * grid;
+    auto build = [&](double convection) {
+        std::vector<mmath::sparse_entry<double>> entries;
+        for (size_t i = 0; i < grid; ++i) {
+            for (size_t j = 0; j < grid; ++j) {
+                size_t row = i * grid + j + 1;
+                entries.push_back({row, row, 4.0});
+                if (i > 0)
+                    entries.push_back({row, row - grid, -1.0 - convection});
+                if (i + 1 < grid)
+                    entries.push_back({row, row + grid, -1.0 + convection});
+                if (j > 0)
+                    entries.push_back({row, row - 1, -1.0});
+                if (j + 1 < grid)
+                    entries.push_back({row, row + 1, -1.0});
+            }
+        }
+        return mmath::csr_matrix<double>{n, n, std::move(entries)};
+    };
+
+    mmath::csr_matrix<double> spd = build(0.0);
+    mmath::csr_matrix<double> nonsymmetric = build(0.4);
+
+    std::vector<double> expected(n);
+    for (size_t i = 0; i < n; ++i)
+        expected[i] = static_cast<double>(i % 7) - 3.0;
+
+    auto rhs_for = [&](const mmath::csr_matrix<double>& a) {
+        std::vector<double> b(n);
+        a.apply(expected, b);
+        return b;
+    };
+
+    auto check_solution = [&](const std::vector<double>& x) {
+        for (size_t i = 0; i < n; ++i)
+            REQUIRE(x[i] == Catch::Approx(expected[i]).margin(1e-6));
+    };
+
+    mmath::krylov_options<double> options;
+    options.tolerance = 1e-10;
+
+    SECTION("Conjugate Gradient") {
+        auto b = rhs_for(spd);
+
+        std::vector<double> x(n, 0.0);
+        auto plain = mmath::cg(spd, b, x, options);
+        CHECK(plain.converged);
+        check_solution(x);
+
+        std::fill(x.begin(), x.end(), 0.0);
+        auto jacobi = mmath::cg(spd, b, x, options, mmath::jacobi_preconditioner<double>{spd});
+        CHECK(jacobi.converged);
+        check_solution(x);
+
+        std::fill(x.begin(), x.end(), 0.0);
+        auto ilu = mmath::cg(spd, b, x, options, mmath::ilu0_preconditioner<double>{spd});
+        CHECK(ilu.converged);
+        CHECK(ilu.iterations < plain.iterations);
+        check_solution(x);
+    }
+
+    SECTION("BiCGSTAB") {
+        auto b = rhs_for(nonsymmetric);
+        std::vector<double> x(n, 0.0);
+
+        auto result = mmath::bicgstab(nonsymmetric, b, x, options, mmath::ilu0_preconditioner<double>{nonsymmetric});
+        CHECK(result.converged);
+        CHECK(result.relative_residual <= options.tolerance);
+        check_solution(x);
+    }
+
+    SECTION("Restarted GMRES") {
+        auto b = rhs_for(nonsymmetric);
+        std::vector<double> x(n, 0.0);
+
+        options.restart = 10;
+        auto result = mmath::gmres(nonsymmetric, b, x, options);
+        CHECK(result.converged);
+        CHECK(result.iterations > options.restart);
+        check_solution(x);
+
+        std::fill(x.begin(), x.end(), 0.0);
+        auto preconditioned = mmath::gmres(nonsymmetric, b, x, options, mmath::ilu0_preconditioner<double>{nonsymmetric});
+        CHECK(preconditioned.converged);
+        CHECK(preconditioned.iterations < result.iterations);
+        check_solution(x);
+    }
+
+    SECTION("Dense and Function Operators") {
+        mmath::matrix_base<double> dense{{4, 1, 0}, {1, 3, 1}, {0, 1, 2}};
+        std::vector<double> b{5, 5, 3}, x(3, 0.0);
+
+        auto result = mmath::cg(mmath::make_operator(dense), b, x, options);
+        CHECK(result.converged);
+        CHECK(x[0] == Catch::Approx(1.0));
+        CHECK(x[1] == Catch::Approx(1.0));
+        CHECK(x[2] == Catch::Approx(1.0));
+
+        // Matrix free diagonal operator
+        auto diagonal = mmath::make_operator<double>(3, [](std::span<const double> in, std::span<double> out) {
+            for (size_t i = 0; i < in.size(); ++i)
+                out[i] = static_cast<double>(i + 1) * in[i];
+        });
+        std::fill(x.begin(), x.end(), 0.0);
+        CHECK(mmath::gmres(diagonal, std::vector<double>{1, 4, 9}, x, options).converged);
+        CHECK(x[2] == Catch::Approx(3.0));
+    }
+
+    SECTION("Workspaces and Monitoring") {
+        auto b = rhs_for(spd);
+        std::vector<double> x(n, 0.0);
+        mmath::cg_workspace<double> workspace{n};
+
+        std::vector<double> history;
+        auto result = mmath::cg(spd, b, x, workspace, options, mmath::identity_preconditioner<double>{},
+                                [&](size_t, double residual) { history.push_back(residual); });
+        CHECK(result.converged);
+        CHECK(history.size() == result.iterations);
+        CHECK(history.back() == result.relative_residual);
+
+        // A monitor returning false stops the solve
+        std::fill(x.begin(), x.end(), 0.0);
+        auto stopped = mmath::cg(spd, b, x, workspace, options, mmath::identity_preconditioner<double>{},
+                                 [](size_t iteration, double) { return iteration < 3; });
+        CHECK_FALSE(stopped.converged);
+        CHECK(stopped.iterations == 3);
+
+        CHECK_THROWS_AS(mmath::cg(spd, std::vector<double>(3), x, options), std::domain_error);
+
+        // Workspaces sized for another operator are rejected before any vector is touched
+        mmath::cg_workspace<double> small{n - 1};
+        mmath::bicgstab_workspace<double> small_bicgstab{n - 1};
+        CHECK_THROWS_AS(mmath::cg(spd, b, x, small, options), std::invalid_argument);
+        CHECK_THROWS_AS(mmath::bicgstab(spd, b, x, small_bicgstab, options), std::invalid_argument);
+    }
+}
+
 TEST_CASE("Matrix Elementary Operations - Invalid Operations") {
     using namespace mmath;
 
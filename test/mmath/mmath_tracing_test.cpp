@@ -0,0 +1,118 @@
+//
+// Created by Elijah Sauder on 10/18/26.
+//
+// Built with MMATH_TRACING and MMATH_TRACE_BUFFER_EVENTS=64 defined, see
+// CMakeLists.txt
+#include "../../src/mmath/mmath.hpp"
+#include "../../src/mmath/mmath_lu.hpp"
+#include <catch2/catch_all.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::string trace() {
+        std::ostringstream os;
+        mmath::write_chrome_trace(os);
+        return os.str();
+    }
+
+    size_t count(const std::string& text, const std::string& pattern) {
+        size_t found = 0;
+        for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1))
+            ++found;
+        return found;
+    }
+}  // namespace
+
+TEST_CASE("Tracing - Recording") {
+    using namespace mmath;
+    clear_trace();
+
+    matrix_base<double> a{{1, 2, 3}, {4, 5, 6}};
+    matrix_base<double> b{{1, 0}, {0, 1}, {1, 1}};
+
+    // Off until switched on
+    CHECK_FALSE(tracing_enabled());
+    matrix_base<double> ignored = a * b;
+    CHECK(count(trace(), "\"ph\": \"X\"") == 0);
+
+    set_tracing(true);
+    matrix_base<double> product = a * b;
+    matrix_base<double> power = product ^ 2;
+    matrix_base<int> swapped = matrix_base<int>{{1, 2}, {3, 4}} | 1_R <=> 2_R;
+    std::vector<double> x = lu_solve(matrix_base<double>{{2, 1}, {1, 3}}, {3, 5});
+    set_tracing(false);
+    matrix_base<double> after = a.transpose();
+
+    const std::string json = trace();
+    CHECK(json.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [", 0) == 0);
+    CHECK(count(json, "\"ph\": \"X\"") == 6);
+    CHECK(count(json, "\"name\": \"multiply\"") == 2);
+    CHECK(json.find("\"args\": {\"type\": \"double\", \"rows\": 2, \"cols\": 2, \"inner\": 3}") != std::string::npos);
+    CHECK(json.find("\"name\": \"power\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"row_operation\"") != std::string::npos);
+    CHECK(json.find("\"type\": \"int32\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"lu_factor\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"lu_solve\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"transpose\"") == std::string::npos);
+
+    clear_trace();
+    CHECK(count(trace(), "\"ph\": \"X\"") == 0);
+}
+
+TEST_CASE("Tracing - Threads and Ring Buffers") {
+    using namespace mmath;
+    clear_trace();
+    set_tracing(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([t] {
+            matrix_base<float> matrix{4, 4, static_cast<float>(t)};
+            // More events than a buffer holds, only the newest 64 are kept
+            for (int i = 0; i < 100; ++i)
+                matrix = matrix.transpose();
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    set_tracing(false);
+
+    const std::string json = trace();
+    CHECK(count(json, "\"name\": \"transpose\"") == 3 * 64);
+    CHECK(count(json, "\"type\": \"float\"") == 3 * 64);
+    CHECK(count(json, "\"name\": \"thread_name\"") >= 3);
+    clear_trace();
+}
+
+TEST_CASE("Tracing - Buffers of Exited Threads") {
+    using namespace mmath;
+    clear_trace();
+    set_tracing(true);
+    auto record = [] {
+        std::thread{[] {
+            matrix_base<float> matrix{2, 2};
+            matrix = matrix.transpose();
+        }}.join();
+    };
+    const size_t before = count(trace(), "\"name\": \"thread_name\"");
+
+    // Each thread exits after its events were written out, so one buffer serves them all
+    for (int t = 0; t < 40; ++t) {
+        record();
+        CHECK(count(trace(), "\"name\": \"transpose\"") == 1);
+        clear_trace();
+    }
+    CHECK(count(trace(), "\"name\": \"thread_name\"") <= before + 1);
+
+    // Never written out, the oldest buffers are taken over past the limit
+    for (int t = 0; t < 40; ++t)
+        record();
+    set_tracing(false);
+    const std::string json = trace();
+    CHECK(count(json, "\"name\": \"thread_name\"") <= before + trace_retired_buffers + 2);
+    CHECK(count(json, "\"name\": \"transpose\"") == trace_retired_buffers + 1);
+    clear_trace();
+}